@@ -10,6 +10,8 @@
  *************************************************************************/
 #include "Compression.h"
 
+#include <cstddef>
+
 /**
  * These are definitions of various free functions for the C-style compression routines in ROOT.
  */
@@ -33,6 +35,21 @@ extern "C" void R__unzip(int *srcsize, unsigned char *src, int *tgtsize, unsigne
 
 extern "C" int R__unzip_header(int *srcsize, unsigned char *src, int *tgtsize);
 
+/**
+ * Same as R__zipMultipleAlgorithm, except that ZSTD compresses with the dictionary of dictSize bytes at dict, trained
+ * by R__trainDictZSTD (see ZipZSTD.h). The other algorithms ignore the dictionary. The dictionary is not stored in
+ * the compressed block: it has to be passed again to R__unzipWithDict.
+ */
+extern "C" void R__zipWithDict(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep,
+                               ROOT::RCompressionSetting::EAlgorithm::EValues, const void *dict, size_t dictSize);
+
+/**
+ * Same as R__unzip, except that ZSTD blocks compressed with a dictionary are decompressed with the dictionary of
+ * dictSize bytes at dict; R__unzip refuses them.
+ */
+extern "C" void R__unzipWithDict(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep,
+                                 const void *dict, size_t dictSize);
+
 enum { kMAXZIPBUF = 0xffffff };
 
 #endif
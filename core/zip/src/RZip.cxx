@@ -18,6 +18,79 @@
 
 #include <cstdio>
 #include <cassert>
+#include <cstring>
+
+namespace {
+/**
+ * Per-thread zlib streams, reused across buffers instead of allocating and initializing the (de)compression state
+ * for every buffer. Deflate streams are kept per compression level: deflateReset() preserves the level.
+ */
+class RZlibStreams {
+   z_stream fDeflateStreams[10];
+   bool fDeflateInit[10] = {};
+   z_stream fInflateStream;
+   bool fInflateInit = false;
+
+public:
+   RZlibStreams(const RZlibStreams &) = delete;
+   RZlibStreams &operator=(const RZlibStreams &) = delete;
+   RZlibStreams() = default;
+   ~RZlibStreams()
+   {
+      for (int i = 0; i < 10; ++i) {
+         if (fDeflateInit[i])
+            deflateEnd(&fDeflateStreams[i]);
+      }
+      if (fInflateInit)
+         inflateEnd(&fInflateStream);
+   }
+
+   /// Return a reset deflate stream for the given level, or nullptr on error
+   z_stream *GetDeflateStream(int cxlevel)
+   {
+      z_stream *stream = &fDeflateStreams[cxlevel];
+      if (fDeflateInit[cxlevel]) {
+         if (deflateReset(stream) == Z_OK)
+            return stream;
+         deflateEnd(stream);
+         fDeflateInit[cxlevel] = false;
+      }
+      memset(stream, 0, sizeof(z_stream));
+      int err = deflateInit(stream, cxlevel);
+      if (err != Z_OK) {
+         printf("error %d in deflateInit (zlib)\n", err);
+         return nullptr;
+      }
+      fDeflateInit[cxlevel] = true;
+      return stream;
+   }
+
+   /// Return a reset inflate stream, or nullptr on error
+   z_stream *GetInflateStream()
+   {
+      if (fInflateInit) {
+         if (inflateReset(&fInflateStream) == Z_OK)
+            return &fInflateStream;
+         inflateEnd(&fInflateStream);
+         fInflateInit = false;
+      }
+      memset(&fInflateStream, 0, sizeof(z_stream));
+      int err = inflateInit(&fInflateStream);
+      if (err != Z_OK) {
+         fprintf(stderr, "R__unzip: error %d in inflateInit (zlib)\n", err);
+         return nullptr;
+      }
+      fInflateInit = true;
+      return &fInflateStream;
+   }
+};
+
+RZlibStreams &GetThreadZlibStreams()
+{
+   thread_local RZlibStreams streams;
+   return streams;
+}
+} // anonymous namespace
 
 // The size of the ROOT block framing headers for compression:
 // - 3 bytes to identify the compression algorithm and version.
@@ -77,6 +150,14 @@ unsigned long R__crc32(unsigned long crc, const unsigned char* buf, unsigned int
 /*                      2 = lzma */
 /*                      3 = old */
 void R__zipMultipleAlgorithm(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, ROOT::RCompressionSetting::EAlgorithm::EValues compressionAlgorithm)
+{
+   R__zipWithDict(cxlevel, srcsize, src, tgtsize, tgt, irep, compressionAlgorithm, nullptr, 0);
+}
+
+/* Same as R__zipMultipleAlgorithm; ZSTD compresses with the dictionary of dictSize bytes at dict, if dictSize > 0 */
+void R__zipWithDict(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep,
+                    ROOT::RCompressionSetting::EAlgorithm::EValues compressionAlgorithm, const void *dict,
+                    size_t dictSize)
 {
 
   if (*srcsize < 1 + HDRSIZE + 1) {
@@ -99,7 +180,7 @@ void R__zipMultipleAlgorithm(int cxlevel, int *srcsize, char *src, int *tgtsize,
   } else if (compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kLZ4) {
      R__zipLZ4(cxlevel, srcsize, src, tgtsize, tgt, irep);
   } else if (compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kZSTD) {
-     R__zipZSTD(cxlevel, srcsize, src, tgtsize, tgt, irep);
+     R__zipZSTDDict(cxlevel, srcsize, src, tgtsize, tgt, irep, dict, dictSize);
   } else if (compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kOldCompressionAlgo || compressionAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kUseGlobal) {
      R__zipOld(cxlevel, srcsize, src, tgtsize, tgt, irep);
   } else {
@@ -179,7 +260,6 @@ static void R__zipZLIB(int cxlevel, int *srcsize, char *src, int *tgtsize, char
   int err;
   int method   = Z_DEFLATED;
 
-    z_stream stream;
     //Don't use the globals but want name similar to help see similarities in code
     unsigned l_in_size, l_out_size;
     *irep = 0;
@@ -193,34 +273,25 @@ static void R__zipZLIB(int cxlevel, int *srcsize, char *src, int *tgtsize, char
        return;
     }
 
+    if (cxlevel > 9) cxlevel = 9;
+    // The stream is reused for the next buffer compressed by this thread at this level
+    z_stream *streamPtr = GetThreadZlibStreams().GetDeflateStream(cxlevel);
+    if (!streamPtr)
+       return;
+    z_stream &stream = *streamPtr;
+
     stream.next_in   = (Bytef*)src;
     stream.avail_in  = (uInt)(*srcsize);
 
     stream.next_out  = (Bytef*)(&tgt[HDRSIZE]);
     stream.avail_out = (uInt)(*tgtsize);
 
-    stream.zalloc    = (alloc_func)0;
-    stream.zfree     = (free_func)0;
-    stream.opaque    = (voidpf)0;
-
-    if (cxlevel > 9) cxlevel = 9;
-    err = deflateInit(&stream, cxlevel);
-    if (err != Z_OK) {
-       printf("error %d in deflateInit (zlib)\n",err);
-       return;
-    }
-
     while ((err = deflate(&stream, Z_FINISH)) != Z_STREAM_END) {
        if (err != Z_OK) {
-          deflateEnd(&stream);
           return;
        }
     }
 
-    err = deflateEnd(&stream);
-    if (err != Z_OK)
-       printf("error %d in deflateEnd (zlib)\n",err);
-
     tgt[0] = 'Z';               /* Signature ZLib */
     tgt[1] = 'L';
     tgt[2] = (char) method;
@@ -320,6 +391,12 @@ int R__unzip_header(int *srcsize, uch *src, int *tgtsize)
 // N.B. (Brian) - I have kept the original note out of complete awe of the
 // age of the original code...
 void R__unzip(int *srcsize, uch *src, int *tgtsize, uch *tgt, int *irep)
+{
+   R__unzipWithDict(srcsize, src, tgtsize, tgt, irep, nullptr, 0);
+}
+
+/* Same as R__unzip; ZSTD blocks compressed with a dictionary are decompressed with the one at dict */
+void R__unzipWithDict(int *srcsize, uch *src, int *tgtsize, uch *tgt, int *irep, const void *dict, size_t dictSize)
 {
    long isize;
    uch *ibufptr, *obufptr;
@@ -367,7 +444,10 @@ void R__unzip(int *srcsize, uch *src, int *tgtsize, uch *tgt, int *irep)
       R__unzipLZ4(srcsize, src, tgtsize, tgt, irep);
       return;
    } else if (is_valid_header_zstd(src)) {
-      R__unzipZSTD(srcsize, src, tgtsize, tgt, irep);
+      if (dictSize != 0)
+         R__unzipZSTDDict(srcsize, src, tgtsize, tgt, irep, dict, dictSize);
+      else
+         R__unzipZSTD(srcsize, src, tgtsize, tgt, irep);
       return;
    }
 
@@ -391,33 +471,26 @@ void R__unzip(int *srcsize, uch *src, int *tgtsize, uch *tgt, int *irep)
 
 void R__unzipZLIB(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep)
 {
-     z_stream stream; /* decompression stream */
      int err = 0;
 
+     /* decompression stream, reused for the next buffer decompressed by this thread */
+     z_stream *streamPtr = GetThreadZlibStreams().GetInflateStream();
+     if (!streamPtr)
+        return;
+     z_stream &stream = *streamPtr;
+
      stream.next_in = (Bytef *)(&src[HDRSIZE]);
      stream.avail_in = (uInt)(*srcsize) - HDRSIZE;
      stream.next_out = (Bytef *)tgt;
      stream.avail_out = (uInt)(*tgtsize);
-     stream.zalloc = (alloc_func)0;
-     stream.zfree = (free_func)0;
-     stream.opaque = (voidpf)0;
-
-     err = inflateInit(&stream);
-     if (err != Z_OK) {
-        fprintf(stderr, "R__unzip: error %d in inflateInit (zlib)\n", err);
-        return;
-     }
 
      while ((err = inflate(&stream, Z_FINISH)) != Z_STREAM_END) {
         if (err != Z_OK) {
-           inflateEnd(&stream);
            fprintf(stderr, "R__unzip: error %d in inflate (zlib)\n", err);
            return;
         }
      }
 
-     inflateEnd(&stream);
-
      *irep = stream.total_out;
      return;
 }
@@ -0,0 +1,114 @@
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "Compression.h"
+#include "RZip.h"
+#include "ZipZSTD.h"
+
+namespace {
+
+/// Small buffers that look alike, as the baskets of a branch do
+std::vector<std::string> MakeSamples(int n)
+{
+   std::vector<std::string> samples;
+   for (int i = 0; i < n; ++i) {
+      std::string s;
+      for (int j = 0; j < 40; ++j)
+         s += "{\"event\": " + std::to_string(i * 40 + j) + ", \"pt\": " + std::to_string((i * 7 + j * 13) % 97) +
+              ", \"charge\": " + ((i + j) % 2 ? "+1" : "-1") + "}\n";
+      samples.emplace_back(std::move(s));
+   }
+   return samples;
+}
+
+std::vector<char> TrainDict(const std::vector<std::string> &samples, size_t capacity)
+{
+   std::string concatenated;
+   std::vector<size_t> sizes;
+   for (const auto &s : samples) {
+      concatenated += s;
+      sizes.push_back(s.size());
+   }
+   std::vector<char> dict(capacity);
+   dict.resize(R__trainDictZSTD(dict.data(), dict.size(), concatenated.data(), sizes.data(), sizes.size()));
+   return dict;
+}
+
+std::vector<char> Zip(const std::string &src, const std::vector<char> &dict)
+{
+   std::vector<char> tgt(src.size() + 256);
+   int srcsize = src.size();
+   int tgtsize = tgt.size();
+   int irep = 0;
+   R__zipWithDict(5, &srcsize, const_cast<char *>(src.data()), &tgtsize, tgt.data(), &irep,
+                  ROOT::RCompressionSetting::EAlgorithm::kZSTD, dict.data(), dict.size());
+   tgt.resize(irep);
+   return tgt;
+}
+
+/// Returns the number of bytes written to unzipped, 0 on error
+int Unzip(std::vector<char> &zipped, std::string &unzipped, const std::vector<char> &dict)
+{
+   int srcsize = zipped.size();
+   int tgtsize = unzipped.size();
+   int irep = 0;
+   R__unzipWithDict(&srcsize, reinterpret_cast<unsigned char *>(zipped.data()), &tgtsize,
+                    reinterpret_cast<unsigned char *>(&unzipped[0]), &irep, dict.data(), dict.size());
+   return irep;
+}
+
+} // anonymous namespace
+
+TEST(ZipDict, RoundTrip)
+{
+   const auto samples = MakeSamples(200);
+   const auto dict = TrainDict(samples, 16 * 1024);
+   ASSERT_GT(dict.size(), 0u);
+
+   std::size_t sizeWithDict = 0;
+   std::size_t sizeWithoutDict = 0;
+   for (const auto &s : samples) {
+      auto zipped = Zip(s, dict);
+      ASSERT_GT(zipped.size(), 0u);
+      sizeWithDict += zipped.size();
+      sizeWithoutDict += Zip(s, {}).size();
+
+      std::string unzipped(s.size(), '\0');
+      ASSERT_EQ(Unzip(zipped, unzipped, dict), static_cast<int>(s.size()));
+      EXPECT_EQ(unzipped, s);
+      EXPECT_NE(R__getDictIDZSTD(zipped.size(), reinterpret_cast<unsigned char *>(zipped.data())), 0u);
+
+      // Without the dictionary, the block is refused
+      EXPECT_EQ(Unzip(zipped, unzipped, {}), 0);
+   }
+   EXPECT_LT(sizeWithDict, sizeWithoutDict);
+}
+
+TEST(ZipDict, BlockWithoutDict)
+{
+   const auto samples = MakeSamples(200);
+   const auto dict = TrainDict(samples, 16 * 1024);
+   ASSERT_GT(dict.size(), 0u);
+
+   // Blocks compressed without dictionary are read back whether or not the caller has one
+   auto zipped = Zip(samples[0], {});
+   ASSERT_GT(zipped.size(), 0u);
+   EXPECT_EQ(R__getDictIDZSTD(zipped.size(), reinterpret_cast<unsigned char *>(zipped.data())), 0u);
+   std::string unzipped(samples[0].size(), '\0');
+   ASSERT_EQ(Unzip(zipped, unzipped, dict), static_cast<int>(samples[0].size()));
+   EXPECT_EQ(unzipped, samples[0]);
+   unzipped.assign(samples[0].size(), '\0');
+   ASSERT_EQ(Unzip(zipped, unzipped, {}), static_cast<int>(samples[0].size()));
+   EXPECT_EQ(unzipped, samples[0]);
+}
+
+TEST(ZipDict, RawDictRefused)
+{
+   // A dictionary without the ZSTD header carries no ID: the block could not be told apart from one without
+   // dictionary when reading it back
+   const auto samples = MakeSamples(10);
+   std::vector<char> rawDict(samples[0].begin(), samples[0].end());
+   EXPECT_EQ(Zip(samples[1], rawDict).size(), 0u);
+}
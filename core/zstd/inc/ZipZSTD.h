@@ -12,11 +12,34 @@
 
 // NOTE: the ROOT compression libraries aren't consistently written in C++; hence the
 // #ifdef's to avoid problems with C code.
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep);
 void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep);
+
+// Dictionary compression. Many small buffers with similar content (e.g. the baskets of a branch) compress much better
+// with a dictionary trained on a few of them. The dictionary is not part of the compressed buffer: the caller has to
+// store it next to the data (TBranch keeps the dictionary of its baskets) and pass it again to R__unzipZSTDDict, or to
+// R__unzipWithDict. R__unzipZSTD, and thus R__unzip, refuses buffers compressed with a dictionary.
+
+/// Train a dictionary of at most dictCapacity bytes from nSamples buffers stored back-to-back in samples.
+/// Returns the size of the dictionary written to dict, or 0 on error.
+size_t R__trainDictZSTD(void *dict, size_t dictCapacity, const void *samples, const size_t *sampleSizes,
+                        unsigned nSamples);
+/// Like R__zipZSTD, using the dictionary of dictSize bytes at dict, as returned by R__trainDictZSTD (the buffer records
+/// the ID of the dictionary). A dictSize of 0 compresses without dictionary.
+void R__zipZSTDDict(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, const void *dict,
+                    size_t dictSize);
+/// Like R__unzipZSTD, for buffers compressed by R__zipZSTDDict with the dictionary of dictSize bytes at dict.
+/// Buffers compressed without dictionary are decompressed without it.
+void R__unzipZSTDDict(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep,
+                      const void *dict, size_t dictSize);
+/// Returns the ID of the dictionary the buffer of srcsize bytes at src was compressed with, 0 if none or if the buffer
+/// is not compressed with ZSTD.
+unsigned R__getDictIDZSTD(int srcsize, const unsigned char *src);
 #ifdef __cplusplus
 }
 #endif
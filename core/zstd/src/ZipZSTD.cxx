@@ -14,7 +14,9 @@
 
 #include "zdict.h"
 #include <zstd.h>
+#include <cstring>
 #include <memory>
+#include <string>
 
 #include <iostream>
 
@@ -22,17 +24,123 @@ static const int kHeaderSize = 9;
 
 static const size_t errorCodeSmallBuffer = (size_t)-70;
 
+namespace {
+
+/// Contexts are expensive to create compared to compressing a small buffer: each thread reuses its own.
+ZSTD_CCtx *GetThreadCCtx()
+{
+    thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> ctx{ZSTD_createCCtx(), &ZSTD_freeCCtx};
+    return ctx.get();
+}
+
+ZSTD_DCtx *GetThreadDCtx()
+{
+    thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> ctx{ZSTD_createDCtx(), &ZSTD_freeDCtx};
+    return ctx.get();
+}
+
+/// Digesting a dictionary costs about as much as compressing a small buffer. Each thread keeps the digested form of
+/// the dictionary it used last, together with a copy of the dictionary to recognize it.
+template <typename DictT, size_t (*FreeDict)(DictT *)>
+struct RZstdDigestedDict {
+    std::string fBuffer;
+    int fLevel = 0;
+    std::unique_ptr<DictT, decltype(FreeDict)> fDict{nullptr, FreeDict};
+
+    bool Matches(const void *dict, size_t dictSize, int level) const
+    {
+        return fDict && level == fLevel && dictSize == fBuffer.size() && memcmp(dict, fBuffer.data(), dictSize) == 0;
+    }
+};
+
+const ZSTD_CDict *GetThreadCDict(const void *dict, size_t dictSize, int level)
+{
+    thread_local RZstdDigestedDict<ZSTD_CDict, &ZSTD_freeCDict> cache;
+    if (!cache.Matches(dict, dictSize, level)) {
+        cache.fDict.reset(ZSTD_createCDict(dict, dictSize, level));
+        cache.fBuffer.assign(static_cast<const char *>(dict), dictSize);
+        cache.fLevel = level;
+    }
+    return cache.fDict.get();
+}
+
+const ZSTD_DDict *GetThreadDDict(const void *dict, size_t dictSize)
+{
+    thread_local RZstdDigestedDict<ZSTD_DDict, &ZSTD_freeDDict> cache;
+    if (!cache.Matches(dict, dictSize, 0)) {
+        cache.fDict.reset(ZSTD_createDDict(dict, dictSize));
+        cache.fBuffer.assign(static_cast<const char *>(dict), dictSize);
+    }
+    return cache.fDict.get();
+}
+
+/// Check the ROOT block header of a ZSTD buffer; returns false and reports the problem if it is not usable.
+bool CheckHeader(const unsigned char *src, const char *caller)
+{
+    if (R__unlikely(src[0] != 'Z' || src[1] != 'S')) {
+      std::cerr << caller << ": algorithm run against buffer with incorrect header (got " <<
+      src[0] << src[1] << "; expected ZS)." << std::endl;
+      return false;
+    }
+
+    int ZSTD_version =  ZSTD_versionNumber() / (100 * 100);
+    if (R__unlikely(src[2] != ZSTD_version)) {
+      std::cerr << caller << ": This version of ZSTD is incompatible with the on-disk version "
+      "got "<< src[2] << "; expected "<< ZSTD_version << ")" << std::endl;
+      return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+size_t R__trainDictZSTD(void *dict, size_t dictCapacity, const void *samples, const size_t *sampleSizes,
+                        unsigned nSamples)
+{
+    size_t retval = ZDICT_trainFromBuffer(dict, dictCapacity, samples, sampleSizes, nSamples);
+    if (ZDICT_isError(retval)) {
+        std::cerr << "Error in training ZSTD dictionary. Type = " << ZDICT_getErrorName(retval) << std::endl;
+        return 0;
+    }
+    return retval;
+}
+
 void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep)
 {
-    using Ctx_ptr = std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)>;
-    Ctx_ptr fCtx{ZSTD_createCCtx(), &ZSTD_freeCCtx};
+    R__zipZSTDDict(cxlevel, srcsize, src, tgtsize, tgt, irep, nullptr, 0);
+}
+
+void R__zipZSTDDict(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, int *irep, const void *dict,
+                    size_t dictSize)
+{
+    ZSTD_CCtx *ctx = GetThreadCCtx();
 
     *irep = 0;
 
-    size_t retval = ZSTD_compressCCtx(fCtx.get(),
-                                        &tgt[kHeaderSize], static_cast<size_t>(*tgtsize - kHeaderSize),
-                                        src, static_cast<size_t>(*srcsize),
-                                        2*cxlevel);
+    const ZSTD_CDict *cdict = nullptr;
+    if (dictSize != 0) {
+        // Without an ID in the buffer, R__unzipZSTDDict could not tell that the dictionary is needed
+        if (R__unlikely(ZDICT_getDictID(dict, dictSize) == 0)) {
+            std::cerr << "R__zipZSTDDict: the compression dictionary has no ID, it must be trained with "
+            "R__trainDictZSTD; the buffer is not compressed" << std::endl;
+            return;
+        }
+        cdict = GetThreadCDict(dict, dictSize, 2*cxlevel);
+        if (R__unlikely(!cdict)) {
+            std::cerr << "R__zipZSTDDict: cannot load the compression dictionary (" << dictSize <<
+            " bytes); the buffer is not compressed" << std::endl;
+            return;
+        }
+    }
+
+    size_t retval = cdict ? ZSTD_compress_usingCDict(ctx,
+                                                     &tgt[kHeaderSize], static_cast<size_t>(*tgtsize - kHeaderSize),
+                                                     src, static_cast<size_t>(*srcsize),
+                                                     cdict)
+                          : ZSTD_compressCCtx(ctx,
+                                              &tgt[kHeaderSize], static_cast<size_t>(*tgtsize - kHeaderSize),
+                                              src, static_cast<size_t>(*srcsize),
+                                              2*cxlevel);
 
     if (R__unlikely(ZSTD_isError(retval))) {
         if (R__unlikely(retval != errorCodeSmallBuffer)) {
@@ -60,26 +168,57 @@ void R__zipZSTD(int cxlevel, int *srcsize, char *src, int *tgtsize, char *tgt, i
 
 void R__unzipZSTD(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep)
 {
-    using Ctx_ptr = std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)>;
-    Ctx_ptr fCtx{ZSTD_createDCtx(), &ZSTD_freeDCtx};
     *irep = 0;
 
-    if (R__unlikely(src[0] != 'Z' || src[1] != 'S')) {
-      std::cerr << "R__unzipZSTD: algorithm run against buffer with incorrect header (got " <<
-      src[0] << src[1] << "; expected ZS)." << std::endl;
-      return;
+    if (!CheckHeader(src, "R__unzipZSTD"))
+        return;
+
+    // Buffers compressed with a dictionary cannot be read without it. The dictionary is not part of the buffer,
+    // so refuse them here rather than failing in ZSTD with a less helpful message.
+    const unsigned dictID = R__getDictIDZSTD(*srcsize, src);
+    if (R__unlikely(dictID != 0)) {
+        std::cerr << "R__unzipZSTD: buffer was compressed with ZSTD dictionary " << dictID <<
+        "; use R__unzipZSTDDict with that dictionary" << std::endl;
+        return;
     }
 
-    int ZSTD_version =  ZSTD_versionNumber() / (100 * 100);
-    if (R__unlikely(src[2] != ZSTD_version)) {
-      std::cerr << "R__unzipZSTD: This version of ZSTD is incompatible with the on-disk version "
-      "got "<< src[2] << "; expected "<< ZSTD_version << ")" << std::endl;
-      return;
+    R__unzipZSTDDict(srcsize, src, tgtsize, tgt, irep, nullptr, 0);
+}
+
+unsigned R__getDictIDZSTD(int srcsize, const unsigned char *src)
+{
+    if (srcsize <= kHeaderSize || src[0] != 'Z' || src[1] != 'S')
+        return 0;
+    return ZSTD_getDictID_fromFrame(&src[kHeaderSize], static_cast<size_t>(srcsize - kHeaderSize));
+}
+
+void R__unzipZSTDDict(int *srcsize, unsigned char *src, int *tgtsize, unsigned char *tgt, int *irep,
+                      const void *dict, size_t dictSize)
+{
+    ZSTD_DCtx *ctx = GetThreadDCtx();
+    *irep = 0;
+
+    if (!CheckHeader(src, "R__unzipZSTDDict"))
+        return;
+
+    // The dictionary also sets the initial state of the decoder: only use it for buffers compressed with it
+    const ZSTD_DDict *ddict = nullptr;
+    if (dictSize != 0 && R__getDictIDZSTD(*srcsize, src) != 0) {
+        ddict = GetThreadDDict(dict, dictSize);
+        if (R__unlikely(!ddict)) {
+            std::cerr << "R__unzipZSTDDict: cannot load the decompression dictionary (" << dictSize << " bytes)" <<
+            std::endl;
+            return;
+        }
     }
 
-    size_t retval = ZSTD_decompressDCtx(fCtx.get(),
-                                        (char *)tgt, static_cast<size_t>(*tgtsize),
-                                        (char *)&src[kHeaderSize], static_cast<size_t>(*srcsize - kHeaderSize));
+    size_t retval = ddict ? ZSTD_decompress_usingDDict(ctx,
+                                                       (char *)tgt, static_cast<size_t>(*tgtsize),
+                                                       (char *)&src[kHeaderSize], static_cast<size_t>(*srcsize - kHeaderSize),
+                                                       ddict)
+                          : ZSTD_decompressDCtx(ctx,
+                                                (char *)tgt, static_cast<size_t>(*tgtsize),
+                                                (char *)&src[kHeaderSize], static_cast<size_t>(*srcsize - kHeaderSize));
 
     /* The error code 18446744073709551546 arises when the tgt buffer is too small
      * However this error is already handled outside of the compression algorithm
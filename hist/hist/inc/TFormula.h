@@ -265,8 +265,9 @@ public:
    Double_t       GetVariable(const char *name) const;
    Int_t          GetVarNumber(const char *name) const;
    TString        GetVarName(Int_t ivar) const;
-   Bool_t         IsValid() const { return fReadyToExecute && fClingInitialized; }
+   Bool_t         IsValid() const;
    Bool_t IsVectorized() const { return fVectorized; }
+   Bool_t         CanBeVectorized() const;
    Bool_t         IsLinear() const { return TestBit(kLinear); }
    void           Print(Option_t *option = "") const override;
    void           SetName(const char* name) override;
@@ -283,6 +284,12 @@ public:
    void           SetVariables(const std::pair<TString,Double_t> *vars, const Int_t size);
    void SetVectorized(Bool_t vectorized);
 
+   static Int_t   CompilePending();
+   static Bool_t  IsCompilationDeferred();
+   static void    SetCompilationDeferred(Bool_t defer = kTRUE);
+   static TString GetCompilationCacheDir();
+   static void    SetCompilationCacheDir(const char *dir);
+
    ClassDefOverride(TFormula,13)
 };
 
@@ -0,0 +1,78 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TH1ConcurrentFill
+#define ROOT_TH1ConcurrentFill
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TH1ConcurrentFillManager, TH1ConcurrentFiller                        //
+//                                                                      //
+// Fill a TH1, TH2 or TH3 from several threads at the same time.        //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TH1.h"
+
+#include <mutex>
+
+class TAxis;
+class TH1ConcurrentFiller;
+
+class TH1ConcurrentFillManager {
+   friend class TH1ConcurrentFiller;
+
+private:
+   TH1 *fHist = nullptr;            ///< Histogram being filled, nullptr if it cannot be filled concurrently
+   Double_t *fArrayD = nullptr;     ///< Bin contents of histograms with Double_t bins
+   Float_t *fArrayF = nullptr;      ///< Bin contents of histograms with Float_t bins
+   Double_t *fSumw2 = nullptr;      ///< Sum of squares of weights, nullptr if not stored
+   const TAxis *fAxes[3] = {};      ///< Axes of the histogram
+   Int_t fNbins[3] = {};            ///< Number of bins of the axes
+   Int_t fDimension = 0;            ///< Dimension of the histogram
+   Bool_t fStatOverflows = kFALSE;  ///< Use the under/overflows in the statistics (see TH1::SetStatOverflows)
+   Bool_t fLocked = kFALSE;         ///< Fill with TH1::Fill under fMutex instead of atomic updates
+   std::mutex fMutex;               ///< Protects the statistics of the histogram (and the filling if fLocked)
+
+   void AddStats(Double_t entries, const Double_t *stats);
+
+public:
+   TH1ConcurrentFillManager(TH1 &hist);
+   TH1ConcurrentFillManager(const TH1ConcurrentFillManager &) = delete;
+   TH1ConcurrentFillManager &operator=(const TH1ConcurrentFillManager &) = delete;
+
+   TH1ConcurrentFiller MakeFiller();
+
+   /// Return the histogram being filled
+   TH1 *GetHistogram() const { return fHist; }
+   /// Return true if the bins are updated with atomic operations, without locking
+   Bool_t IsLockFree() const { return fHist && !fLocked; }
+};
+
+class TH1ConcurrentFiller {
+private:
+   TH1ConcurrentFillManager *fManager = nullptr;  ///< Manager of the histogram
+   Double_t fEntries = 0;                         ///< Number of entries filled since the last Flush()
+   Double_t fStats[TH1::kNstat] = {};             ///< Statistics filled since the last Flush(), as in TH1::GetStats
+
+public:
+   TH1ConcurrentFiller(TH1ConcurrentFillManager &manager) : fManager(&manager) {}
+   TH1ConcurrentFiller(const TH1ConcurrentFiller &) = delete;
+   TH1ConcurrentFiller &operator=(const TH1ConcurrentFiller &) = delete;
+   TH1ConcurrentFiller(TH1ConcurrentFiller &&other);
+   TH1ConcurrentFiller &operator=(TH1ConcurrentFiller &&other);
+   ~TH1ConcurrentFiller() { Flush(); }
+
+   Int_t Fill(Double_t x, Double_t w = 1.);
+   Int_t Fill(const Double_t *x, Double_t w = 1.);
+   void  Flush();
+};
+
+#endif
@@ -29,6 +29,8 @@ class TProfile;
 
 class TH2 : public TH1 {
 
+   friend class TH1ConcurrentFillManager;
+
 protected:
    Double_t     fScalefactor;     ///< Scale factor
    Double_t     fTsumwy;          ///< Total Sum of weight*Y
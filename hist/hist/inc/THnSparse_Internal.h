@@ -23,6 +23,8 @@
 
 #include "TObject.h"
 
+#include <vector>
+
 class TBrowser;
 class TH1;
 class THnSparse;
@@ -66,5 +68,53 @@ class THnSparseArrayChunk: public TObject {
 
    ClassDefOverride(THnSparseArrayChunk, 1); // chunks of linearized bins
 };
+
+
+/// Open-addressing hash index from the hash of a compact bin coordinate to the
+/// linear bin index, used by THnSparse for its bin lookup.
+///
+/// Hash and index are stored next to each other in one flat array of slots,
+/// probed linearly from the slot given by a Fibonacci hash of the coordinate
+/// hash; the array is kept at most half full. Bins whose compact coordinates
+/// have the same hash simply occupy several slots; Find() checks each of them
+/// against the coordinates with the `matches` callback.
+
+class THnSparseBinIndex {
+ private:
+   struct Slot {
+      ULong64_t fHash;  ///< Hash of the compact bin coordinate
+      Long64_t  fIndex; ///< Linear bin index + 1; 0 marks an empty slot
+   };
+
+   std::vector<Slot> fSlots; ///< Slots, their number is a power of two (or zero)
+   Long64_t fSize = 0;       ///< Number of used slots
+   Int_t    fShift = 64;     ///< 64 - log2 of the number of slots
+
+   ULong64_t GetStart(ULong64_t hash) const { return (hash * 0x9E3779B97F4A7C15ull) >> fShift; }
+   void Rehash(Long64_t nslots);
+
+ public:
+   /// Return the linear index of the bin with hash `hash` for which
+   /// `matches(linidx)` is true, or -1 if there is none.
+   template <class MATCH>
+   Long64_t Find(ULong64_t hash, MATCH &&matches) const {
+      if (fSlots.empty())
+         return -1;
+      const ULong64_t mask = fSlots.size() - 1;
+      for (ULong64_t pos = GetStart(hash); fSlots[pos].fIndex; pos = (pos + 1) & mask) {
+         if (fSlots[pos].fHash == hash && matches(fSlots[pos].fIndex - 1))
+            return fSlots[pos].fIndex - 1;
+      }
+      return -1;
+   }
+
+   void Insert(ULong64_t hash, Long64_t linidx);
+   void Reserve(Long64_t nbins);
+   void Clear();
+
+   Long64_t GetSize() const { return fSize; }
+   Long64_t GetCapacity() const { return fSlots.size(); }
+   Long64_t GetMemorySize() const { return fSlots.size() * sizeof(Slot); }
+};
 #endif // ROOT_THnSparse_Internal
 
@@ -76,6 +76,13 @@ public:
       kForcedBinning
    };
 
+   /// Evaluation method of the density estimate.
+   /// They can be set using SetEvaluation()
+   enum EEvaluation {
+      kDirect, ///< Sum the kernels of all data points (or bins) at each evaluation
+      kGrid    ///< Compute the estimate once on a fine grid (linear binning and FFT convolution) and interpolate it
+   };
+
    ///  default constructor used only by I/O
    TKDE();
 
@@ -88,6 +95,7 @@ public:
    /// For this reason, by default for Nevents >=10000, the data are automatically binned  in
    /// nbins=Min(10000,Nevents/10)
    /// In case of ForceBinning option the default number of bins is 1000
+   /// For large data sets the option Evaluation:Grid computes the estimate once on a grid, see SetEvaluation()
    TKDE(UInt_t events, const Double_t* data, Double_t xMin = 0.0, Double_t xMax = 0.0, const Option_t* option =
                  "KernelType:Gaussian;Iteration:Adaptive;Mirror:noMirror;Binning:RelaxedBinning", Double_t rho = 1.0) {
       Instantiate( nullptr,  events, data, nullptr, xMin, xMax, option, rho);
@@ -121,6 +129,8 @@ public:
    void SetBinning(EBinning);
    void SetNBins(UInt_t nbins);
    void SetUseBinsNEvents(UInt_t nEvents);
+   void SetEvaluation(EEvaluation eval);
+   void SetNGridPoints(UInt_t npoints);
    void SetTuneFactor(Double_t rho);
    void SetRange(Double_t xMin, Double_t xMax); ///< By default computed from the data
 
@@ -164,9 +174,14 @@ public:
       TKDE *fKDE;
       UInt_t fNWeights;               ///< Number of kernel weights (bandwidth as vectorized for binning)
       std::vector<Double_t> fWeights; ///< Kernel weights (bandwidth)
+      std::vector<Double_t> fGrid;    ///< Estimate (not normalized) on the grid used by the kGrid evaluation
+      Double_t fGridMin;              ///< Position of the first grid point
+      Double_t fGridStep;             ///< Distance between the grid points
+      Double_t GridValue(Double_t x) const;
    public:
       TKernel(Double_t weight, TKDE *kde);
       void ComputeAdaptiveWeights();
+      void ComputeGrid();
       Double_t operator()(Double_t x) const;
       Double_t GetWeight(Double_t x) const;
       Double_t GetFixedWeight() const;
@@ -200,6 +215,7 @@ private:
    EIteration fIteration;
    EMirror fMirror;
    EBinning fBinning;
+   EEvaluation fEvaluation;            ///< Evaluation method of the estimate
 
 
    Bool_t fUseMirroring, fMirrorLeft, fMirrorRight, fAsymLeft, fAsymRight;
@@ -211,6 +227,7 @@ private:
    UInt_t fNEvents;                    ///< Data's number of events
    Double_t fSumOfCounts;              ///< Data sum of weights
    UInt_t fUseBinsNEvents;             ///< If the algorithm is allowed to use automatic (relaxed) binning this is the minimum number of events to do so
+   UInt_t fNGridPoints;                ///< Minimum number of grid points in the range for the kGrid evaluation
 
    Double_t fMean;                     ///< Data mean
    Double_t fSigma;                    ///< Data std deviation
@@ -261,6 +278,7 @@ private:
    Double_t ComputeKernelSigma2() const;
    Double_t ComputeKernelMu() const;
    Double_t ComputeKernelIntegral() const;
+   Double_t GetKernelSupport() const;
    Double_t ComputeMidspread() ;
    void ComputeDataStats() ;
 
@@ -298,7 +316,7 @@ private:
    TF1* GetPDFUpperConfidenceInterval(Double_t confidenceLevel = 0.95, UInt_t npx = 100, Double_t xMin = 1.0, Double_t xMax = 0.0);
    TF1* GetPDFLowerConfidenceInterval(Double_t confidenceLevel = 0.95, UInt_t npx = 100, Double_t xMin = 1.0, Double_t xMax = 0.0);
 
-   ClassDefOverride(TKDE, 3) // One dimensional semi-parametric Kernel Density Estimation
+   ClassDefOverride(TKDE, 4) // One dimensional semi-parametric Kernel Density Estimation
 
 };
 
@@ -28,6 +28,8 @@
 #include "TList.h"
 #include "TMath.h"
 #include "TROOT.h"
+#include "TEnv.h"
+#include "TString.h"
 
 #include "TVirtualPad.h" // for gPad
 
@@ -62,6 +64,10 @@ namespace HFit {
 
    void CheckGraphFitOptions(Foption_t &fitOption);
 
+   bool CanVectorizeFit(const Foption_t &fitOption, const ROOT::Math::MinimizerOptions &minOption);
+
+   void SetFitFunction(ROOT::Fit::Fitter &fitter, TF1 &f1, unsigned int dim, unsigned int npoints, bool canVectorize);
+
 
    void GetDrawingRange(TH1 * h1, ROOT::Fit::DataRange & range);
    void GetDrawingRange(TGraph * gr, ROOT::Fit::DataRange & range);
@@ -235,16 +241,19 @@ TFitResultPtr HFit::Fit(FitObject * h1, TF1 *f1 , Foption_t & fitOption , const
    }
 
 
+   // the vectorized evaluation of the chi2 and of the binned likelihood does not support
+   // bin integrals, bin volumes, expected errors or errors on the coordinates
+   const ROOT::Fit::DataOptions &dataOpt = fitdata->Opt();
+   bool canVectorize = !dataOpt.fIntegral && !dataOpt.fBinVolume && !dataOpt.fExpErrors &&
+                       !fitdata->HaveCoordErrors() && !fitdata->HaveAsymErrors() &&
+                       HFit::CanVectorizeFit(fitOption, minOption);
+
    // set the fit function
    // if option grad is specified use gradient
    if ( (linear || fitOption.Gradient) )
       fitter->SetFunction(ROOT::Math::WrappedMultiTF1(*f1));
-#ifdef R__HAS_VECCORE
-   else if(f1->IsVectorized())
-      fitter->SetFunction(static_cast<const ROOT::Math::IParamMultiFunctionTempl<ROOT::Double_v> &>(ROOT::Math::WrappedMultiTF1Templ<ROOT::Double_v>(*f1)));
-#endif
    else
-      fitter->SetFunction(static_cast<const ROOT::Math::IParamMultiFunction &>(ROOT::Math::WrappedMultiTF1(*f1) ) );
+      HFit::SetFitFunction(*fitter, *f1, 0, fitdata->Size(), canVectorize);
 
    // error normalization in case of zero error in the data
    if (fitdata->GetErrorType() == ROOT::Fit::BinData::kNoError) fitConfig.SetNormErrors(true);
@@ -463,6 +472,52 @@ TFitResultPtr HFit::Fit(FitObject * h1, TF1 *f1 , Foption_t & fitOption , const
 }
 
 
+bool HFit::CanVectorizeFit(const Foption_t &fitOption, const ROOT::Math::MinimizerOptions &minOption) {
+   // check if the fit can be done with the vectorized evaluation of the objective function:
+   // it exists only for the sequential and multi-thread execution policies, and not for the
+   // minimizers using the residuals of single data points (Fumili and GSLMultiFit)
+   if (fitOption.ExecPolicy != ROOT::EExecutionPolicy::kSequential &&
+       fitOption.ExecPolicy != ROOT::EExecutionPolicy::kMultiThread)
+      return false;
+   // option M uses Minuit
+   if (fitOption.More) return true;
+   TString type = minOption.MinimizerType();
+   TString algo = minOption.MinimizerAlgorithm();
+   return !type.Contains("Fumili", TString::kIgnoreCase) && !type.EqualTo("GSLMultiFit", TString::kIgnoreCase) &&
+          !algo.Contains("Fumili", TString::kIgnoreCase);
+}
+
+void HFit::SetFitFunction(ROOT::Fit::Fitter &fitter, TF1 &f1, unsigned int dim, unsigned int npoints, bool canVectorize) {
+   // set f1 as model function of the fitter, using the vectorized evaluation if possible:
+   // for functions that are vectorized, and for formulas that can be vectorized if there are
+   // at least Fit.VectorizeMinPoints (from gEnv) data points to make up for compiling them
+   // and the fit supports the vectorized evaluation (canVectorize, see CanVectorizeFit).
+   // In the latter case the fit uses a vectorized copy of f1, owned by the fitter's function wrapper.
+#ifdef R__HAS_VECCORE
+   using VecFunction_t = ROOT::Math::IParamMultiFunctionTempl<ROOT::Double_v>;
+   if (f1.IsVectorized()) {
+      fitter.SetFunction(static_cast<const VecFunction_t &>(ROOT::Math::WrappedMultiTF1Templ<ROOT::Double_v>(f1, dim)));
+      return;
+   }
+   const Int_t minPoints = gEnv->GetValue("Fit.VectorizeMinPoints", 10000);
+   if (canVectorize && minPoints > 0 && npoints >= (unsigned int)minPoints && f1.GetFormula() &&
+       f1.GetFormula()->CanBeVectorized()) {
+      std::unique_ptr<TF1> fvec(ROOT::Math::Internal::CopyTF1Ptr(&f1));
+      fvec->SetVectorized(true);
+      if (fvec->IsVectorized()) {
+         ROOT::Math::WrappedMultiTF1Templ<ROOT::Double_v> wf(*fvec, dim);
+         wf.SetAndCopyFunction();
+         fitter.SetFunction(static_cast<const VecFunction_t &>(wf));
+         return;
+      }
+   }
+#else
+   (void)npoints;
+   (void)canVectorize;
+#endif
+   fitter.SetFunction(static_cast<const ROOT::Math::IParamMultiFunction &>(ROOT::Math::WrappedMultiTF1(f1, dim)));
+}
+
 void HFit::GetDrawingRange(TH1 * h1, ROOT::Fit::DataRange & range) {
    // get range from histogram and update the DataRange class
    // if a ranges already exist in that dimension use that one
@@ -714,10 +769,10 @@ void ROOT::Fit::FitOptionsMake(EFitObjectType type, const char *option, Foption_
             opt.ReplaceAll("WIDTH","");
       }
 
-      // if (opt.Contains("MULTIPROC")) {
-      //    fitOption.ExecPolicy = ROOT::Fit::kMultiprocess;
-      //    opt.ReplaceAll("MULTIPROC","");
-      // }
+      if (opt.Contains("MULTIPROCESS")) {
+         fitOption.ExecPolicy = ROOT::EExecutionPolicy::kMultiProcess;
+         opt.ReplaceAll("MULTIPROCESS","");
+      }
 
       if (opt.Contains("SERIAL")) {
          fitOption.ExecPolicy = ROOT::EExecutionPolicy::kSequential;
@@ -848,7 +903,7 @@ TFitResultPtr ROOT::Fit::UnBinFit(ROOT::Fit::UnBinData * data, TF1 * fitfunc, Fo
       fitter->SetFunction(ROOT::Math::WrappedMultiTF1(*fitfunc) );
    }
    else
-      fitter->SetFunction(static_cast<const ROOT::Math::IParamMultiFunction &>(ROOT::Math::WrappedMultiTF1(*fitfunc, dim) ) );
+      HFit::SetFitFunction(*fitter, *fitfunc, dim, fitdata->Size(), HFit::CanVectorizeFit(fitOption, minOption));
 
    // parameter setting is done automaticaly in the Fitter class
    // need only to set limits
@@ -181,6 +181,8 @@ TF1Convolution::TF1Convolution(TString formula,  Double_t xmin, Double_t xmax, B
       // case function is not found try to use as a TFormula
       if (funcarray[i] == nullptr) {
          TF1 * f = new TF1(TString::Format("f_conv_%d",i+1),stringarray[i]);
+         // a formula whose compilation is deferred is valid only once compiled
+         TFormula::CompilePending();
          if (!f->GetFormula()->IsValid() )
             Error("TF1Convolution","Invalid formula : %s",stringarray[i].Data() );
          if (i == 0)
@@ -214,13 +216,17 @@ TF1Convolution::TF1Convolution(TString formula1, TString formula2,  Double_t xmi
    TF1* f1 = (TF1*)(gROOT -> GetListOfFunctions() -> FindObject(formula1));
    TF1* f2 = (TF1*)(gROOT -> GetListOfFunctions() -> FindObject(formula2));
    // if function do not exists try using TFormula
-   if (!f1) {
+   if (!f1)
       fFunction1 = std::make_unique<TF1>("f_conv_1", formula1);
+   if (!f2)
+      fFunction2 = std::make_unique<TF1>("f_conv_1", formula2);
+   // formulas whose compilation is deferred are valid only once compiled
+   TFormula::CompilePending();
+   if (!f1) {
       if (!fFunction1->GetFormula()->IsValid() )
          Error("TF1Convolution","Invalid formula for : %s",formula1.Data() );
    }
    if (!f2) {
-      fFunction2 = std::make_unique<TF1>("f_conv_1", formula2);
       if (!fFunction2->GetFormula()->IsValid() )
          Error("TF1Convolution","Invalid formula for : %s",formula2.Data() );
    }
@@ -20,11 +20,18 @@
 #include "TInterpreterValue.h"
 #include "TFormula.h"
 #include "TRegexp.h"
+#include "TEnv.h"
+#include "TLockFile.h"
+#include "TMD5.h"
+#include "TSystem.h"
 
 #include "ROOT/StringUtils.hxx"
 
+#include <algorithm>
 #include <array>
+#include <fstream>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <unordered_map>
 #include <functional>
@@ -246,6 +253,20 @@ ClassImp(TFormula);
     function. That means the expression `x@2` will be expanded to
     ```[n]*x + [n+1]*2``` where n is the first previously unused parameter number.
 
+    ### Compilation of many formulas
+
+    Each formula expression is compiled by Cling once per process, when the first
+    TFormula with this expression is created. Programs creating many different formulas
+    can defer the compilation with `TFormula::SetCompilationDeferred()`: the formulas are
+    then compiled all together, in a single Cling transaction, at the first evaluation of
+    one of them or when calling `TFormula::CompilePending()`.
+
+    With `TFormula::SetCompilationCacheDir(dir)`, the deferred formulas are compiled together
+    with ACLiC in a library stored in `dir`, which is loaded instead of compiling the formulas
+    again by the later jobs creating the same formulas with the same ROOT version.
+    Both settings can be given in the rootrc, as `TFormula.DeferCompilation` and
+    `TFormula.CompilationCacheDir`.
+
     \class TFormulaFunction
     Helper class for TFormula
 
@@ -263,6 +284,23 @@ static const TString gNamePrefix = "TFormula__";
 //static std::unordered_map<std::string,  TInterpreter::CallFuncIFacePtr_t::Generic_t> gClingFunctions = std::unordered_map<TString,  TInterpreter::CallFuncIFacePtr_t::Generic_t>();
 static std::unordered_map<std::string,  void *> gClingFunctions = std::unordered_map<std::string,  void * >();
 
+// formula code not yet passed to Cling (see TFormula::CompilePending), with the same key as gClingFunctions.
+// Ordered, so that the same formulas give the same code to compile and the same key in the compilation cache.
+struct TFormulaPendingCode {
+   TString fClingName;
+   TString fCode;
+   bool fHasParameters;
+   bool fHasVariables;
+   bool fVectorized;
+};
+static std::map<std::string, TFormulaPendingCode> gPendingClingFunctions;
+
+// deferred compilation and compilation cache directory: -1 and null until read from gEnv
+static int gDeferCompilation = -1;
+static std::unique_ptr<TString> gCompilationCacheDir;
+// keys of the libraries of the compilation cache loaded by this process
+static std::set<std::string> gCompilationCacheLibraries;
+
 static void R__v5TFormulaUpdater(Int_t nobjects, TObject **from, TObject **to)
 {
    auto **fromv5 = (ROOT::v5::TFormula **)from;
@@ -657,8 +695,8 @@ Int_t TFormula::Compile(const char *expression)
 
    if (formula.IsNull() ) return -1;
 
-   // do not re-process if it was done before
-   if (IsValid() && formula == fFormula ) return 0;
+   // do not re-process if it was done before, or if the formula is waiting for CompilePending
+   if (fReadyToExecute && (fClingInitialized || fLazyInitialization) && formula == fFormula ) return 0;
 
    // clear if a formula was already existing
    if (!fFormula.IsNull() ) Clear();
@@ -967,30 +1005,64 @@ void TFormula::FillDefaults()
 ///    We will replace for example sin with vecCore::Mat::Sin
 ///
 
+#ifdef R__HAS_VECCORE
+static const pair<TString,TString> gVecFunShortcuts[] =
+   { {"sin","vecCore::math::Sin" },
+     {"cos","vecCore::math::Cos" }, {"exp","vecCore::math::Exp"}, {"log","vecCore::math::Log"}, {"log10","vecCore::math::Log10"},
+     {"tan","vecCore::math::Tan"},
+     //{"sinh","vecCore::math::Sinh"}, {"cosh","vecCore::math::Cosh"},{"tanh","vecCore::math::Tanh"},
+     {"asin","vecCore::math::ASin"},
+     {"acos","TMath::Pi()/2-vecCore::math::ASin"},
+     {"atan","vecCore::math::ATan"},
+     {"atan2","vecCore::math::ATan2"}, {"sqrt","vecCore::math::Sqrt"},
+     {"ceil","vecCore::math::Ceil"}, {"floor","vecCore::math::Floor"}, {"pow","vecCore::math::Pow"},
+     {"cbrt","vecCore::math::Cbrt"},{"abs","vecCore::math::Abs"},
+     {"min","vecCore::math::Min"},{"max","vecCore::math::Max"},{"sign","vecCore::math::Sign" }
+     //{"sq","TMath::Sq"}, {"binomial","TMath::Binomial"}  // this last two functions will not work in vectorized mode
+   };
+#endif
+
 void TFormula::FillVecFunctionsShurtCuts() {
 #ifdef R__HAS_VECCORE
-   const pair<TString,TString> vecFunShortcuts[] =
-      { {"sin","vecCore::math::Sin" },
-        {"cos","vecCore::math::Cos" }, {"exp","vecCore::math::Exp"}, {"log","vecCore::math::Log"}, {"log10","vecCore::math::Log10"},
-        {"tan","vecCore::math::Tan"},
-        //{"sinh","vecCore::math::Sinh"}, {"cosh","vecCore::math::Cosh"},{"tanh","vecCore::math::Tanh"},
-        {"asin","vecCore::math::ASin"},
-        {"acos","TMath::Pi()/2-vecCore::math::ASin"},
-        {"atan","vecCore::math::ATan"},
-        {"atan2","vecCore::math::ATan2"}, {"sqrt","vecCore::math::Sqrt"},
-        {"ceil","vecCore::math::Ceil"}, {"floor","vecCore::math::Floor"}, {"pow","vecCore::math::Pow"},
-        {"cbrt","vecCore::math::Cbrt"},{"abs","vecCore::math::Abs"},
-        {"min","vecCore::math::Min"},{"max","vecCore::math::Max"},{"sign","vecCore::math::Sign" }
-        //{"sq","TMath::Sq"}, {"binomial","TMath::Binomial"}  // this last two functions will not work in vectorized mode
-      };
    // replace in the data member maps fFunctionsShortcuts
-   for (auto fun : vecFunShortcuts) {
+   for (auto fun : gVecFunShortcuts) {
       fFunctionsShortcuts[fun.first] = fun.second;
    }
 #endif
    // do nothing in case Veccore is not enabled
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the formula could be evaluated in vectorized mode (see SetVectorized()),
+/// i.e. if it has at least one variable and calls only functions that have
+/// a vectorized implementation (sin, exp, sqrt, pow, ...). Formulas defined
+/// with lambdas or referring to other functions by name are never considered
+/// vectorizable. Always false if ROOT is built without VecCore.
+
+Bool_t TFormula::CanBeVectorized() const
+{
+#ifdef R__HAS_VECCORE
+   if (fVectorized)
+      return true;
+   if (fNdim == 0 || TestBit(kLambda) || !fReadyToExecute)
+      return false;
+   for (const auto &fun : fFuncs) {
+      if (fun.IsFuncCall()) {
+         auto isVec = [&fun](const pair<TString,TString> &vecFun) { return vecFun.first == fun.fName; };
+         if (std::none_of(std::begin(gVecFunShortcuts), std::end(gVecFunShortcuts), isVec))
+            return false;
+      } else if (!fVars.count(fun.fName) && !fConsts.count(fun.fName)) {
+         // a parameter, or another function inserted by name
+         R__LOCKGUARD(gROOTMutex);
+         if (gROOT->GetListOfFunctions()->FindObject(fun.fName))
+            return false;
+      }
+   }
+   return true;
+#else
+   return false;
+#endif
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 ///    Handling polN
@@ -1816,7 +1888,8 @@ Bool_t TFormula::PrepareFormula(TString &formula)
    // for pre-defined functions (need after processing)
    if (fNumber != 0) SetPredefinedParamNames();
 
-   return fReadyToExecute && fClingInitialized;
+   // with lazy initialization the formula is compiled when it is first evaluated
+   return fReadyToExecute && (fClingInitialized || fLazyInitialization);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2356,13 +2429,23 @@ void TFormula::ProcessFormula(TString &formula)
          // }
 
          if (inputIntoCling) {
-            if (!fLazyInitialization) {
+            if (!fLazyInitialization && IsCompilationDeferred()) {
+               // compiled with the other pending formulas at the first evaluation or by CompilePending()
+               fLazyInitialization = true;
+            }
+            if (fLazyInitialization) {
+               gPendingClingFunctions.emplace(inputFormulaVecFlag,
+                                              TFormulaPendingCode{fClingName, fClingInput, hasParameters, hasVariables,
+                                                                  static_cast<bool>(fVectorized)});
+            } else {
                InputFormulaIntoCling();
                if (fClingInitialized) {
                   // if Cling has been successfully initialized
                   // put function ptr in the static map
                   R__LOCKGUARD(gROOTMutex);
                   gClingFunctions.insert(std::make_pair(inputFormulaVecFlag, (void *)fFuncPtr));
+                  // the function must not be declared again with the pending formulas
+                  gPendingClingFunctions.erase(inputFormulaVecFlag);
                }
             }
             if (!fClingInitialized) {
@@ -3205,6 +3288,13 @@ bool TFormula::GenerateGradientPar() {
    if (fGradFuncPtr)
       return true;
 
+   // the formula must be compiled to be differentiated
+   if (!fClingInitialized && fLazyInitialization) {
+      R__LOCKGUARD(gROOTMutex);
+      if (!fClingInitialized)
+         ReInitializeEvalMethod();
+   }
+
    if (HasGradientGenerationFailed())
       return false;
 
@@ -3270,6 +3360,13 @@ bool TFormula::GenerateHessianPar()
    if (fHessFuncPtr)
       return true;
 
+   // the formula must be compiled to be differentiated
+   if (!fClingInitialized && fLazyInitialization) {
+      R__LOCKGUARD(gROOTMutex);
+      if (!fClingInitialized)
+         ReInitializeEvalMethod();
+   }
+
    if (HasHessianGenerationFailed())
       return false;
 
@@ -3507,6 +3604,18 @@ void TFormula::ReInitializeEvalMethod() {
          return;
       }
    }
+   // compile now the formula, together with all the other pending formulas
+   if (gPendingClingFunctions.count(fSavedInputFormula)) {
+      CompilePending();
+      R__LOCKGUARD(gROOTMutex);
+      auto funcit = gClingFunctions.find(fSavedInputFormula);
+      if (funcit != gClingFunctions.end()) {
+         fFuncPtr = (TFormula::CallFuncSignature)funcit->second;
+         fClingInitialized = true;
+         fLazyInitialization = false;
+         return;
+      }
+   }
    // compile now formula using cling
    InputFormulaIntoCling();
    if (fClingInitialized && !fLazyInitialization) Info("ReInitializeEvalMethod", "Formula is now properly initialized !!");
@@ -3525,6 +3634,354 @@ void TFormula::ReInitializeEvalMethod() {
    return;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the key of the given text in the compilation cache: the MD5 of the ROOT
+/// version and of the text.
+
+static std::string CompilationCacheKey(const TString &text)
+{
+   TString key = TString::Format("%s %s\n", gROOT->GetVersion(), gROOT->GetGitCommit()) + text;
+   TMD5 md5;
+   md5.Update(reinterpret_cast<const UChar_t *>(key.Data()), key.Length());
+   md5.Final();
+   return md5.AsString();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the index of the compilation cache: the keys of the formulas in each library.
+/// Each line holds the key of a library followed by the keys of its formulas.
+
+static std::map<std::string, std::set<std::string>> ReadCompilationCacheIndex(const TString &index)
+{
+   std::map<std::string, std::set<std::string>> libraries;
+   std::ifstream in(index.Data());
+   std::string line;
+   while (std::getline(in, line)) {
+      std::istringstream words(line);
+      std::string library, formula;
+      if (!(words >> library))
+         continue;
+      auto &formulas = libraries[library];
+      while (words >> formula)
+         formulas.insert(formula);
+   }
+   return libraries;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add a library and the keys of its formulas to the index of the compilation cache.
+/// The index is rewritten under a lock and renamed when complete, so that the jobs
+/// reading it never see a partial file.
+
+static void AddToCompilationCacheIndex(const TString &index, const std::string &library,
+                                       const std::vector<std::string> &formulas)
+{
+   TLockFile lock(index + ".lock", 600);
+   auto libraries = ReadCompilationCacheIndex(index);
+   libraries[library].insert(formulas.begin(), formulas.end());
+   const TString tmp = TString::Format("%s.%d.tmp", index.Data(), gSystem->GetPid());
+   {
+      std::ofstream out(tmp.Data());
+      for (auto &entry : libraries) {
+         out << entry.first;
+         for (auto &formula : entry.second)
+            out << ' ' << formula;
+         out << '\n';
+      }
+      if (!out) {
+         Warning("TFormula::CompilePending", "Cannot write the index of the compilation cache in %s", tmp.Data());
+         out.close();
+         gSystem->Unlink(tmp);
+         return;
+      }
+   }
+   if (gSystem->Rename(tmp, index) != 0) {
+      Warning("TFormula::CompilePending", "Cannot rename %s to %s", tmp.Data(), index.Data());
+      gSystem->Unlink(tmp);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compile with ACLiC the given code in the library of the compilation cache named after
+/// key, or load it if it already exists. Return false if the library could not be compiled
+/// or loaded. If the compilation fails, e.g. because a formula calls a function only declared
+/// in the interpreter, a `.failed` marker stops later jobs from retrying it.
+
+static bool BuildCompilationCacheLibrary(const TString &dir, const std::string &key, const TString &code,
+                                         bool vectorized)
+{
+   const TString base = dir + "/TFormulaCache_" + key;
+   const TString source = base + ".C";
+   const TString library = base + "_C." + gSystem->GetSoExt();
+   const TString failed = base + ".failed";
+
+   // do not retry a compilation that failed in a previous job
+   if (!gSystem->AccessPathName(failed))
+      return false;
+   if (gSystem->AccessPathName(source)) {
+      gSystem->mkdir(dir, kTRUE);
+      // write a temporary file renamed when complete, so that concurrent jobs never see a partial source
+      const TString tmp = TString::Format("%s.%d.tmp", source.Data(), gSystem->GetPid());
+      {
+         std::ofstream out(tmp.Data());
+         out << "#include \"TMath.h\"\n#include \"Math/ChebyshevPol.h\"\n#include \"Math/PdfFuncMathCore.h\"\n"
+             << "#include \"Math/ProbFuncMathCore.h\"\n";
+         if (vectorized)
+            out << "#include \"Math/Types.h\"\n";
+         out << code << std::endl;
+         if (!out) {
+            Warning("TFormula::CompilePending", "Cannot write the formula code in %s", tmp.Data());
+            out.close();
+            gSystem->Unlink(tmp);
+            return false;
+         }
+      }
+      if (gSystem->Rename(tmp, source) != 0) {
+         Warning("TFormula::CompilePending", "Cannot rename %s to %s", tmp.Data(), source.Data());
+         gSystem->Unlink(tmp);
+         return false;
+      }
+   }
+
+   // only one job at a time builds the library; the others wait and load it.
+   // A lock older than 10 minutes is left by a job that died while building and is removed.
+   TLockFile lock(base + ".lock", 600);
+   if (!gSystem->AccessPathName(failed))
+      return false;
+   // ACLiC reuses the library of a previous job if it is more recent than the code
+   if (gSystem->CompileMacro(source, "kOs-", "", dir))
+      return true;
+   // the compiler ran but did not produce the library: the code does not compile outside of the interpreter
+   if (gSystem->AccessPathName(library) && !TString(gSystem->GetMakeSharedLib()).IsNull()) {
+      Warning("TFormula::CompilePending", "Cannot compile %s: the formulas are compiled by Cling", source.Data());
+      std::ofstream(failed.Data()) << code << std::endl;
+   } else {
+      Warning("TFormula::CompilePending", "Cannot load %s: the formulas are compiled by Cling", library.Data());
+   }
+   return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Declare the pending formulas from the libraries of the compilation cache directory,
+/// and add the ones which have been declared to cached.
+///
+/// An index in the directory gives the library of each formula, keyed by its normalized
+/// expression: the formulas compiled by a previous job are declared by loading their
+/// library, usually a single one. The other formulas are compiled together with ACLiC in a
+/// new library, keyed by their sorted normalized expressions, and added to the index.
+/// The formulas which cannot be declared this way are left to Cling.
+
+static void DeclareFromCompilationCache(const TString &dir, const std::map<std::string, TFormulaPendingCode> &pending,
+                                        std::set<std::string> &cached)
+{
+   const TString index = dir + "/TFormulaCache.index";
+   const auto libraries = ReadCompilationCacheIndex(index);
+
+   // the library of each formula, preferring the libraries already loaded
+   std::map<std::string, std::string> formulaLibrary;
+   for (auto &library : libraries) {
+      for (auto &formula : library.second) {
+         auto inserted = formulaLibrary.emplace(formula, library.first);
+         if (!inserted.second && gCompilationCacheLibraries.count(library.first))
+            inserted.first->second = library.first;
+      }
+   }
+
+   // the keys of the formulas declared in this process, computed only if a library needs to be loaded
+   std::set<std::string> declared;
+   bool declaredKnown = false;
+   auto isDeclared = [&](const std::string &formula) {
+      if (!declaredKnown) {
+         for (auto &function : gClingFunctions)
+            declared.insert(CompilationCacheKey(function.first));
+         for (auto &library : gCompilationCacheLibraries) {
+            auto it = libraries.find(library);
+            if (it != libraries.end())
+               declared.insert(it->second.begin(), it->second.end());
+         }
+         declaredKnown = true;
+      }
+      return declared.count(formula) > 0;
+   };
+
+   std::vector<std::string> missing;
+   std::set<std::string> unusable;
+   for (auto &formula : pending) {
+      const std::string key = CompilationCacheKey(formula.first);
+      auto it = formulaLibrary.find(key);
+      if (it == formulaLibrary.end() || unusable.count(it->second)) {
+         missing.push_back(formula.first);
+         continue;
+      }
+      const std::string &library = it->second;
+      if (!gCompilationCacheLibraries.count(library)) {
+         // the library may define other formulas: it cannot be loaded if one of them is already declared
+         const auto &formulas = libraries.at(library);
+         const TString path = dir + "/TFormulaCache_" + library + "_C." + gSystem->GetSoExt();
+         if (std::any_of(formulas.begin(), formulas.end(), isDeclared) || gSystem->Load(path) < 0) {
+            unusable.insert(library);
+            missing.push_back(formula.first);
+            continue;
+         }
+         gCompilationCacheLibraries.insert(library);
+         declared.insert(formulas.begin(), formulas.end());
+      }
+      cached.insert(formula.first);
+   }
+   if (missing.empty())
+      return;
+
+   // the pending formulas are sorted by normalized expression, which gives the key of the new library
+   TString expressions;
+   TString code;
+   bool vectorized = false;
+   std::vector<std::string> keys;
+   for (auto &formula : missing) {
+      const TFormulaPendingCode &f = pending.at(formula);
+      expressions += formula + "\n";
+      code += f.fCode + "\n";
+      vectorized |= f.fVectorized;
+      keys.push_back(CompilationCacheKey(formula));
+   }
+   const std::string library = CompilationCacheKey(expressions);
+   if (!BuildCompilationCacheLibrary(dir, library, code, vectorized))
+      return;
+   gCompilationCacheLibraries.insert(library);
+   AddToCompilationCacheIndex(index, library, keys);
+   cached.insert(missing.begin(), missing.end());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compile all the formulas whose compilation is pending, in a single Cling transaction
+/// instead of one per formula. This is done automatically at the first evaluation of one
+/// of them: call it directly to choose when the time is spent.
+///
+/// Formulas are pending if the compilation is deferred (see SetCompilationDeferred), or
+/// if they have been read from a file. If a compilation cache directory is set (see
+/// SetCompilationCacheDir), the pending formulas are instead compiled together with ACLiC
+/// in a library stored in that directory, that later jobs creating the same formulas load
+/// instead of compiling them again.
+///
+/// Return the number of formulas which have been compiled.
+
+Int_t TFormula::CompilePending()
+{
+   R__LOCKGUARD(gROOTMutex);
+   if (gPendingClingFunctions.empty())
+      return 0;
+   ROOT::GetROOT();
+   R__ASSERT(gCling);
+
+   std::map<std::string, TFormulaPendingCode> pending;
+   pending.swap(gPendingClingFunctions);
+
+   // the formulas found in the compilation cache are declared by loading their library, the others by Cling
+   const TString cacheDir = GetCompilationCacheDir();
+   std::set<std::string> cached;
+   if (!cacheDir.IsNull())
+      DeclareFromCompilationCache(cacheDir, pending, cached);
+   TString code;
+   for (auto &formula : pending) {
+      if (!cached.count(formula.first))
+         code += formula.second.fCode + "\n";
+   }
+
+   bool declared = code.IsNull();
+   if (!declared) {
+      // Trigger autoloading / autoparsing (ROOT-9840), see InputFormulaIntoCling
+      gCling->ProcessLine("namespace ROOT_TFormula_triggerAutoParse {\n" + code + "\n}");
+      declared = gCling->Declare("#pragma cling optimize(2)\n" + code);
+   }
+
+   Int_t ncompiled = 0;
+   for (auto &formula : pending) {
+      const TFormulaPendingCode &f = formula.second;
+      // if one formula is invalid the transaction fails: declare them one by one to compile the others
+      if (!declared && !cached.count(formula.first) && !gCling->Declare("#pragma cling optimize(2)\n" + f.fCode))
+         continue;
+      auto method = prepareMethod(f.fHasParameters, f.fHasVariables, f.fClingName, f.fVectorized);
+      if (auto funcPtr = prepareFuncPtr(method.get())) {
+         gClingFunctions.insert(std::make_pair(formula.first, (void *)funcPtr));
+         ++ncompiled;
+      }
+   }
+   return ncompiled;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the formula is ready to be evaluated. A formula whose compilation is
+/// pending (see SetCompilationDeferred) is valid only once it has been compiled by
+/// CompilePending, which is done at its first evaluation.
+
+Bool_t TFormula::IsValid() const
+{
+   if (!fReadyToExecute)
+      return false;
+   if (fClingInitialized || !fLazyInitialization)
+      return fClingInitialized;
+   R__LOCKGUARD(gROOTMutex);
+   return gClingFunctions.count(fSavedInputFormula) > 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the compilation of new formulas is deferred (see SetCompilationDeferred).
+
+Bool_t TFormula::IsCompilationDeferred()
+{
+   R__LOCKGUARD(gROOTMutex);
+   if (gDeferCompilation < 0)
+      gDeferCompilation = gEnv->GetValue("TFormula.DeferCompilation", 0) ? 1 : 0;
+   return gDeferCompilation;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Defer the compilation of the formulas created from now on to their first evaluation,
+/// or to an explicit call to CompilePending, where all the pending formulas are compiled
+/// at once. This reduces the start-up time of programs creating many formulas.
+/// The default is set by `TFormula.DeferCompilation` in the rootrc (false by default).
+///
+/// IsValid() returns false for the formulas whose compilation is pending, until they are
+/// compiled by CompilePending: callers checking a new formula must call it first. The
+/// errors of invalid expressions are reported at that time.
+
+void TFormula::SetCompilationDeferred(Bool_t defer)
+{
+   R__LOCKGUARD(gROOTMutex);
+   gDeferCompilation = defer ? 1 : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the directory of the compilation cache of the formulas, empty if not used
+/// (see SetCompilationCacheDir).
+
+TString TFormula::GetCompilationCacheDir()
+{
+   R__LOCKGUARD(gROOTMutex);
+   if (!gCompilationCacheDir)
+      gCompilationCacheDir = std::make_unique<TString>(gEnv->GetValue("TFormula.CompilationCacheDir", ""));
+   TString dir = *gCompilationCacheDir;
+   gSystem->ExpandPathName(dir);
+   return dir;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set the directory where the formulas compiled by CompilePending are stored, as libraries
+/// built with ACLiC, to be loaded by later jobs instead of compiling them again. There is
+/// one library per batch of formulas compiled together, depending on the ROOT version and on
+/// their normalized expressions, and an index giving the library of each formula, so that
+/// only the formulas not compiled by a previous job are compiled again.
+/// Concurrent jobs can share the directory: each library is built by only one of them.
+/// An empty directory disables the cache, which is the default unless
+/// `TFormula.CompilationCacheDir` is set in the rootrc.
+/// The cache is only used for formulas compiled together by CompilePending, i.e. when the
+/// compilation is deferred (see SetCompilationDeferred) or formulas are read from a file.
+
+void TFormula::SetCompilationCacheDir(const char *dir)
+{
+   R__LOCKGUARD(gROOTMutex);
+   gCompilationCacheDir = std::make_unique<TString>(dir ? dir : "");
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the expression formula.
 ///
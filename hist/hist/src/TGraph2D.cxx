@@ -30,6 +30,7 @@
 #include <cassert>
 #include <iostream>
 #include <fstream>
+#include <vector>
 
 #include "HFitInterface.h"
 #include "Fit/DataRange.h"
@@ -1095,21 +1096,25 @@ TH2D *TGraph2D::GetHistogram(Option_t *option)
    Double_t dx = (hxmax - hxmin) / fNpx;
    Double_t dy = (hymax - hymin) / fNpy;
 
-   Double_t x, y, z;
-
+   // interpolate all the bin centres at once
+   const Int_t nbins = fNpx * fNpy;
+   std::vector<Double_t> x(nbins), y(nbins), z(nbins);
    for (Int_t ix = 1; ix <= fNpx; ix++) {
-      x  = hxmin + (ix - 0.5) * dx;
       for (Int_t iy = 1; iy <= fNpy; iy++) {
-         y  = hymin + (iy - 0.5) * dy;
-         // do interpolation
-         if (oldInterp)
-            z  = ((TGraphDelaunay*)fDelaunay)->ComputeZ(x, y);
-         else
-            z  = ((TGraphDelaunay2D*)fDelaunay)->ComputeZ(x, y);
-
-         fHistogram->Fill(x, y, z);
+         const Int_t i = (ix - 1) * fNpy + iy - 1;
+         x[i] = hxmin + (ix - 0.5) * dx;
+         y[i] = hymin + (iy - 0.5) * dy;
       }
    }
+   if (oldInterp) {
+      for (Int_t i = 0; i < nbins; i++)
+         z[i] = ((TGraphDelaunay*)fDelaunay)->ComputeZ(x[i], y[i]);
+   } else {
+      ((TGraphDelaunay2D*)fDelaunay)->ComputeZ(nbins, x.data(), y.data(), z.data());
+   }
+
+   for (Int_t i = 0; i < nbins; i++)
+      fHistogram->Fill(x[i], y[i], z[i]);
 
    hzmin = GetZminE();
    hzmax = GetZmaxE();
@@ -1239,6 +1244,28 @@ Double_t TGraph2D::Interpolate(Double_t x, Double_t y)
    return TMath::QuietNaN();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Finds the z values at the n positions (x[i],y[i]) thanks to the Delaunay
+/// interpolation and stores them in z. With the default (not "old")
+/// interpolation, the points are interpolated in parallel when the implicit
+/// multi-threading is enabled. This is much faster than calling
+/// Interpolate(x, y) for each point.
+
+void TGraph2D::Interpolate(Int_t n, const Double_t *x, const Double_t *y, Double_t *z)
+{
+   if (n <= 0) return;
+
+   // the first point finds the interpolator
+   z[0] = Interpolate(x[0], y[0]);
+
+   if (fDelaunay && fDelaunay->IsA() == TGraphDelaunay2D::Class()) {
+      ((TGraphDelaunay2D*)fDelaunay)->ComputeZ(n - 1, x + 1, y + 1, z + 1);
+   } else {
+      for (Int_t i = 1; i < n; i++)
+         z[i] = Interpolate(x[i], y[i]);
+   }
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Paints this 2D graph with its current attributes
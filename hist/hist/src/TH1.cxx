@@ -3472,27 +3472,37 @@ void TH1::FillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride
 
 void TH1::DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride)
 {
-   Int_t bin,i;
-
    fEntries += ntimes;
    Double_t ww = 1;
    Int_t nbins   = fXaxis.GetNbins();
-   ntimes *= stride;
-   for (i=0;i<ntimes;i+=stride) {
-      bin =fXaxis.FindBin(x[i]);
-      if (bin <0) continue;
-      if (w) ww = w[i];
-      if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
-      if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
-      AddBinContent(bin, ww);
-      if (bin == 0 || bin > nbins) {
-         if (!GetStatOverflowsBehaviour()) continue;
+
+   // If the axis cannot be extended, the bin numbers of a block of entries are
+   // looked up at once with TAxis::FindFixBins, which the compiler can vectorize.
+   constexpr Int_t kBlock = 256;
+   Int_t bins[kBlock];
+   const Bool_t bulk = !fXaxis.CanExtend() || fXaxis.IsAlphanumeric();
+
+   for (Int_t first = 0; first < ntimes; first += kBlock) {
+      const Int_t n = TMath::Min(kBlock, ntimes - first);
+      const Double_t *xx = &x[first*stride];
+      if (bulk) fXaxis.FindFixBins(n, xx, bins, stride);
+      for (Int_t j = 0; j < n; ++j) {
+         const Int_t i = j*stride;
+         const Int_t bin = bulk ? bins[j] : fXaxis.FindBin(xx[i]);
+         if (bin <0) continue;
+         if (w) ww = w[first*stride + i];
+         if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
+         if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+         AddBinContent(bin, ww);
+         if (bin == 0 || bin > nbins) {
+            if (!GetStatOverflowsBehaviour()) continue;
+         }
+         Double_t z= ww;
+         fTsumw   += z;
+         fTsumw2  += z*z;
+         fTsumwx  += z*xx[i];
+         fTsumwx2 += z*xx[i]*xx[i];
       }
-      Double_t z= ww;
-      fTsumw   += z;
-      fTsumw2  += z*z;
-      fTsumwx  += z*x[i];
-      fTsumwx2 += z*x[i]*x[i];
    }
 }
 
@@ -3965,6 +3975,7 @@ TFitResultPtr TH1::Fit(const char *fname ,Option_t *option ,Option_t *goption, D
 ///   "WIDTH" | Scales the histogran bin content by the bin width (useful for variable bins histograms)
 ///   "SERIAL" | Runs in serial mode. By defult if ROOT is built with MT support and MT is enables, the fit is perfomed in multi-thread     - "E"  Perform better Errors estimation using Minos technique
 ///   "MULTITHREAD" | Forces usage of multi-thread execution whenever possible
+///   "MULTIPROCESS" | Evaluates the chi-square or the likelihood in forked worker processes, e.g. for fit functions which are not thread safe
 ///
 /// The default fitting of an histogram (when no option is given) is perfomed as following:
 ///   - a chi-square fit (see below Chi-square Fits) computed using the bin histogram errors and excluding bins with zero errors (empty bins);
@@ -0,0 +1,299 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "TH1ConcurrentFill.h"
+
+#include "TH2.h"
+#include "TH3.h"
+#include "TArrayD.h"
+#include "TArrayF.h"
+#include "TClass.h"
+#include "TError.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/** \class TH1ConcurrentFillManager
+    \ingroup Histograms
+Fill a TH1, TH2 or TH3 from several threads at the same time, without making a copy of the histogram
+per thread as TThreadedObject does. This saves the memory of the copies and their final merging, which
+matters for histograms with many bins.
+
+Each thread fills the histogram through its own TH1ConcurrentFiller, obtained with MakeFiller().
+The bin contents and the sums of squares of weights are updated with atomic operations, without
+locking. The statistics (number of entries, sums of weights and of weighted coordinates) are
+accumulated by each filler, and added to the histogram when the filler is flushed or destroyed.
+
+~~~ {.cpp}
+TH2D h("h", "h", 1000, 0, 1, 1000, 0, 1);
+TH1ConcurrentFillManager manager(h);
+auto work = [&]() {
+   auto filler = manager.MakeFiller();
+   for (...) {
+      Double_t x[2] = {...};
+      filler.Fill(x, w);
+   }
+}; // the statistics of the histogram are updated when the filler goes out of scope
+~~~
+
+The histogram must not be modified in another way (TH1::Fill, TH1::Reset, TH1::Rebin, ...) while the
+fillers are in use, and its statistics are complete only once all the fillers have been flushed.
+
+Atomic updates are used for TH1D, TH1F, TH2D, TH2F, TH3D and TH3F with axes that cannot be extended.
+The other histograms (integer bins, extendable axes, other classes such as TH1K or classes derived from
+TH1D) are filled by calling TH1::Fill under a lock. Profiles and TH2Poly are not supported.
+
+With atomic updates, if the histogram does not store the sums of squares of weights, TH1::Sumw2 is called
+when creating the manager, since it cannot be done during the concurrent filling. Set the TH1::kIsNotW bit beforehand if
+the histogram is filled with unit weights only, to avoid the memory of the sums of squares.
+*/
+
+namespace {
+
+/// Add value to the variable pointed by address, with an atomic operation.
+template <typename T>
+inline void AtomicAdd(T *address, T value)
+{
+#if defined(__cpp_lib_atomic_ref)
+   std::atomic_ref<T>(*address).fetch_add(value, std::memory_order_relaxed);
+#elif defined(__GNUC__)
+   T expected;
+   __atomic_load(address, &expected, __ATOMIC_RELAXED);
+   T desired = expected + value;
+   while (!__atomic_compare_exchange(address, &expected, &desired, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+      desired = expected + value;
+#elif defined(_MSC_VER)
+   // compare and swap on the integer representation of the floating point value
+   using Int = std::conditional_t<sizeof(T) == 8, __int64, long>;
+   static_assert(sizeof(Int) == sizeof(T), "Unsupported type for AtomicAdd");
+   volatile Int *intAddress = reinterpret_cast<volatile Int *>(address);
+   Int expected = *intAddress;
+   while (true) {
+      T oldValue, newValue;
+      std::memcpy(&oldValue, &expected, sizeof(T));
+      newValue = oldValue + value;
+      Int desired;
+      std::memcpy(&desired, &newValue, sizeof(T));
+      Int previous;
+      if constexpr (sizeof(T) == 8)
+         previous = _InterlockedCompareExchange64(intAddress, desired, expected);
+      else
+         previous = _InterlockedCompareExchange(intAddress, desired, expected);
+      if (previous == expected)
+         break;
+      expected = previous;
+   }
+#else
+#error "AtomicAdd is not implemented for this compiler"
+#endif
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Prepare the histogram hist for the concurrent filling.
+
+TH1ConcurrentFillManager::TH1ConcurrentFillManager(TH1 &hist)
+{
+   if (hist.InheritsFrom("TProfile") || hist.InheritsFrom("TProfile2D") || hist.InheritsFrom("TProfile3D") ||
+       hist.InheritsFrom("TH2Poly")) {
+      Error("TH1ConcurrentFillManager", "Concurrent filling of %s is not supported", hist.IsA()->GetName());
+      return;
+   }
+
+   fDimension = hist.GetDimension();
+   fAxes[0] = hist.GetXaxis();
+   fAxes[1] = hist.GetYaxis();
+   fAxes[2] = hist.GetZaxis();
+   for (Int_t i = 0; i < 3; ++i)
+      fNbins[i] = fAxes[i]->GetNbins();
+
+   // the buffer is filled without any synchronization
+   if (hist.GetBuffer())
+      hist.BufferEmpty(1);
+
+   // Only these classes store one bin content per cell in their TArrayD or TArrayF: TH1K, for instance,
+   // stores the filled values there, and derived classes may override the filling.
+   TClass *cl = hist.IsA();
+   if (cl == TH1D::Class() || cl == TH2D::Class() || cl == TH3D::Class())
+      fArrayD = dynamic_cast<TArrayD *>(&hist)->GetArray();
+   else if (cl == TH1F::Class() || cl == TH2F::Class() || cl == TH3F::Class())
+      fArrayF = dynamic_cast<TArrayF *>(&hist)->GetArray();
+
+   // bins of other types, or axes that can be extended by the filling, require a lock
+   fLocked = (!fArrayD && !fArrayF);
+   for (Int_t i = 0; i < fDimension; ++i)
+      fLocked |= fAxes[i]->CanExtend();
+
+   // the sums of squares of weights cannot be created during the filling
+   if (!fLocked) {
+      if (hist.GetSumw2N() == 0 && !hist.TestBit(TH1::kIsNotW))
+         hist.Sumw2();
+      if (hist.GetSumw2N() > 0)
+         fSumw2 = hist.GetSumw2()->GetArray();
+   }
+
+   fStatOverflows = hist.GetStatOverflowsBehaviour();
+   fHist = &hist;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a new filler of the histogram, to be used by a single thread.
+
+TH1ConcurrentFiller TH1ConcurrentFillManager::MakeFiller()
+{
+   return TH1ConcurrentFiller(*this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the statistics accumulated by a filler to the histogram.
+
+void TH1ConcurrentFillManager::AddStats(Double_t entries, const Double_t *stats)
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   fHist->fEntries += entries;
+   fHist->fTsumw += stats[0];
+   fHist->fTsumw2 += stats[1];
+   fHist->fTsumwx += stats[2];
+   fHist->fTsumwx2 += stats[3];
+   if (fDimension == 2) {
+      TH2 *h2 = static_cast<TH2 *>(fHist);
+      h2->fTsumwy += stats[4];
+      h2->fTsumwy2 += stats[5];
+      h2->fTsumwxy += stats[6];
+   } else if (fDimension == 3) {
+      TH3 *h3 = static_cast<TH3 *>(fHist);
+      h3->fTsumwy += stats[4];
+      h3->fTsumwy2 += stats[5];
+      h3->fTsumwxy += stats[6];
+      h3->fTsumwz += stats[7];
+      h3->fTsumwz2 += stats[8];
+      h3->fTsumwxz += stats[9];
+      h3->fTsumwyz += stats[10];
+   }
+}
+
+/** \class TH1ConcurrentFiller
+    \ingroup Histograms
+Fill the histogram of a TH1ConcurrentFillManager from one thread, concurrently with the other fillers
+of the same manager. See TH1ConcurrentFillManager.
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+/// Move constructor: the statistics of other are moved to the new filler.
+
+TH1ConcurrentFiller::TH1ConcurrentFiller(TH1ConcurrentFiller &&other)
+   : fManager(other.fManager), fEntries(other.fEntries)
+{
+   std::copy(other.fStats, other.fStats + TH1::kNstat, fStats);
+   other.fManager = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Move assignment: the statistics of this filler are flushed before taking those of other.
+
+TH1ConcurrentFiller &TH1ConcurrentFiller::operator=(TH1ConcurrentFiller &&other)
+{
+   if (this != &other) {
+      Flush();
+      fManager = other.fManager;
+      fEntries = other.fEntries;
+      std::copy(other.fStats, other.fStats + TH1::kNstat, fStats);
+      other.fManager = nullptr;
+   }
+   return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill a 1D histogram with x and weight w, as TH1::Fill(x, w).
+
+Int_t TH1ConcurrentFiller::Fill(Double_t x, Double_t w)
+{
+   if (fManager && fManager->fDimension != 1) {
+      Error("TH1ConcurrentFiller::Fill", "Histogram has dimension %d: use Fill(const Double_t *x, Double_t w)",
+            fManager->fDimension);
+      return -1;
+   }
+   return Fill(&x, w);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the histogram with the point x, of size the dimension of the histogram, and weight w,
+/// as TH1::Fill, TH2::Fill or TH3::Fill. Return the global bin number which has its content
+/// incremented by w, or -1 for the points outside the range whose statistics are ignored.
+
+Int_t TH1ConcurrentFiller::Fill(const Double_t *x, Double_t w)
+{
+   if (!fManager || !fManager->fHist)
+      return -1;
+   TH1ConcurrentFillManager &manager = *fManager;
+   const Int_t ndim = manager.fDimension;
+
+   if (manager.fLocked) {
+      std::lock_guard<std::mutex> lock(manager.fMutex);
+      // unit weights go through Fill(x), which is the only filling of some classes (e.g. TH1K)
+      if (ndim == 1)
+         return w == 1. ? manager.fHist->Fill(x[0]) : manager.fHist->Fill(x[0], w);
+      if (ndim == 2)
+         return static_cast<TH2 *>(manager.fHist)->Fill(x[0], x[1], w);
+      return static_cast<TH3 *>(manager.fHist)->Fill(x[0], x[1], x[2], w);
+   }
+
+   fEntries++;
+   Int_t bin = 0;
+   Bool_t outOfRange = kFALSE;
+   for (Int_t i = ndim - 1; i >= 0; --i) {
+      const Int_t ibin = manager.fAxes[i]->FindFixBin(x[i]);
+      outOfRange |= (ibin == 0 || ibin > manager.fNbins[i]);
+      bin = bin * (manager.fNbins[i] + 2) + ibin;
+   }
+   if (manager.fSumw2)
+      AtomicAdd(manager.fSumw2 + bin, w * w);
+   if (manager.fArrayD)
+      AtomicAdd(manager.fArrayD + bin, w);
+   else
+      AtomicAdd(manager.fArrayF + bin, Float_t(w));
+   if (outOfRange && !manager.fStatOverflows)
+      return -1;
+
+   fStats[0] += w;
+   fStats[1] += w * w;
+   fStats[2] += w * x[0];
+   fStats[3] += w * x[0] * x[0];
+   if (ndim > 1) {
+      fStats[4] += w * x[1];
+      fStats[5] += w * x[1] * x[1];
+      fStats[6] += w * x[0] * x[1];
+   }
+   if (ndim > 2) {
+      fStats[7] += w * x[2];
+      fStats[8] += w * x[2] * x[2];
+      fStats[9] += w * x[0] * x[2];
+      fStats[10] += w * x[1] * x[2];
+   }
+   return bin;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the statistics accumulated by this filler to the histogram.
+
+void TH1ConcurrentFiller::Flush()
+{
+   if (!fManager || !fManager->fHist || fEntries == 0)
+      return;
+   fManager->AddStats(fEntries, fStats);
+   fEntries = 0;
+   std::fill(fStats, fStats + TH1::kNstat, 0.);
+}
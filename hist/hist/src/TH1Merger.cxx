@@ -8,9 +8,17 @@
 #include "TError.h"
 #include "THashList.h"
 #include "TClass.h"
+#include "TROOT.h"
+#include "TArrayD.h"
+#include "TArrayF.h"
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+#include <algorithm>
 #include <iostream>
 #include <limits>
 #include <utility>
+#include <vector>
 
 #define PRINTRANGE(a, b, bn)                                                                                          \
    Printf(" base: %f %f %d, %s: %f %f %d", a->GetXmin(), a->GetXmax(), a->GetNbins(), bn, b->GetXmin(), b->GetXmax(), \
@@ -752,6 +760,10 @@ Bool_t TH1Merger::BufferMerge()
    return kFALSE;
 }
 
+/// Merge histograms with the same axes, bin by bin.
+/// The bins are split in ranges merged in parallel when the implicit multi-threading is enabled
+/// and the histograms are large enough: each bin is still the sum of the inputs in the order of
+/// the list, so the result does not depend on the number of threads.
 Bool_t TH1Merger::SameAxesMerge() {
 
 
@@ -762,6 +774,8 @@ Bool_t TH1Merger::SameAxesMerge() {
    fH0->GetStats(totstats);
    Double_t nentries = fH0->GetEntries();
 
+   std::vector<const TH1 *> inputs;
+   Bool_t sameClass = kTRUE;
    TIter next(&fInputList);
    while (TH1* hist=(TH1*)next()) {
       // process only if the histogram has limits; otherwise it was processed before
@@ -779,12 +793,36 @@ Bool_t TH1Merger::SameAxesMerge() {
          totstats[i] += stats[i];
       nentries += hist->GetEntries();
 
-         //Int_t nx = hist->GetXaxis()->GetNbins();
-         // loop on bins of the histogram and do the merge
-      for (Int_t ibin = 0; ibin < hist->fNcells; ibin++) {
-         MergeBin(hist, ibin, ibin);
-      }
+      inputs.push_back(hist);
+      sameClass &= (hist->IsA() == fH0->IsA());
+   }
+
+   const Int_t ncells = fH0->fNcells;
+   auto mergeRange = [&](Int_t first, Int_t last) {
+      for (const TH1 *hist : inputs)
+         MergeBins(hist, first, last);
+   };
+
+#ifdef R__USE_IMT
+   // the bins can be merged in parallel only if they are updated with array operations (see MergeBins)
+   const Bool_t arrayMerge = fIsProfileMerge || (sameClass && HasArrayBins(fH0));
+   constexpr Long64_t kMinCellsPerTask = 1 << 16; // bins times inputs
+   Long64_t ntasks = 1;
+   if (arrayMerge && ROOT::IsImplicitMTEnabled()) {
+      const Long64_t work = Long64_t(ncells) * inputs.size();
+      ntasks = std::min<Long64_t>(ROOT::GetThreadPoolSize(), work / kMinCellsPerTask);
+   }
+   if (ntasks > 1) {
+      const Int_t chunk = Int_t((ncells + ntasks - 1) / ntasks);
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](Int_t first) { mergeRange(first, std::min(first + chunk, ncells)); },
+                   ROOT::TSeq<Int_t>(0, ncells, chunk));
+   } else
+#endif
+   {
+      mergeRange(0, ncells);
    }
+
    //copy merged stats
    fH0->PutStats(totstats);
    fH0->SetEntries(nentries);
@@ -1120,6 +1158,16 @@ Bool_t TH1Merger::LabelMerge(bool newLimits) {
    return kTRUE;
 }
 
+/// Return true if the class of the histogram stores one bin content per cell in its TArrayD or TArrayF,
+/// which can then be merged with array additions. TH1K, for instance, stores the filled values there.
+
+Bool_t TH1Merger::HasArrayBins(const TH1 *hist)
+{
+   TClass *cl = hist->IsA();
+   return cl == TH1D::Class() || cl == TH1F::Class() || cl == TH2D::Class() || cl == TH2F::Class() ||
+          cl == TH3D::Class() || cl == TH3F::Class();
+}
+
 /// helper function for merging
 
 Bool_t TH1Merger::IsBinEmpty(const TH1 * hist, Int_t ibin) {
@@ -1149,6 +1197,50 @@ void TH1Merger::MergeBin(const TH1 *hist, Int_t ibin, Int_t cbin)
    return;
 }
 
+namespace {
+
+/// Add the array src of the input histogram to the array dst of the merged one.
+template <typename T>
+void AddArray(T *dst, const T *src, Int_t n)
+{
+   for (Int_t i = 0; i < n; ++i)
+      dst[i] += src[i];
+}
+
+} // anonymous namespace
+
+// merge the bins [first, last) of histogram hist into the same bins of this histogram.
+// Histograms of the same class with Double_t or Float_t bins (see HasArrayBins) are merged with array additions,
+// which the compiler can vectorize; the others bin by bin with MergeBin.
+void TH1Merger::MergeBins(const TH1 *hist, Int_t first, Int_t last)
+{
+   const Int_t n = last - first;
+   if (!fIsProfileMerge && hist->IsA() == fH0->IsA() && HasArrayBins(fH0)) {
+      Double_t *sumw2 = fH0->fSumw2.fN ? fH0->fSumw2.fArray + first : nullptr;
+      const Double_t *hsumw2 = hist->fSumw2.fN ? hist->fSumw2.fArray + first : nullptr;
+      if (auto arrayD = dynamic_cast<TArrayD *>(fH0)) {
+         const Double_t *hcontent = dynamic_cast<const TArrayD *>(hist)->fArray + first;
+         AddArray(arrayD->fArray + first, hcontent, n);
+         // without sum of squares of weights the errors are the contents
+         if (sumw2)
+            AddArray(sumw2, hsumw2 ? hsumw2 : hcontent, n);
+         return;
+      }
+      if (auto arrayF = dynamic_cast<TArrayF *>(fH0)) {
+         const Float_t *hcontent = dynamic_cast<const TArrayF *>(hist)->fArray + first;
+         AddArray(arrayF->fArray + first, hcontent, n);
+         if (sumw2 && hsumw2)
+            AddArray(sumw2, hsumw2, n);
+         else if (sumw2)
+            for (Int_t i = 0; i < n; ++i)
+               sumw2[i] += hcontent[i];
+         return;
+      }
+   }
+   for (Int_t ibin = first; ibin < last; ++ibin)
+      MergeBin(hist, ibin, ibin);
+}
+
 // merge profile input bin (ibin) of histograms hist ibin into current bin cbin of this histogram
 template<class TProfileType>
 void TH1Merger::MergeProfileBin(const TProfileType *h, Int_t hbin, Int_t pbin)
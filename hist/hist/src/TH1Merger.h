@@ -59,6 +59,9 @@ public:
     // function to check if histogram bin is empty
    static Bool_t IsBinEmpty(const TH1 *hist, Int_t bin);
 
+   // check if the histogram stores one bin content per cell in its TArrayD or TArrayF
+   static Bool_t HasArrayBins(const TH1 *hist);
+
 
 
    TH1Merger(TH1 & h, TCollection & l, Option_t * opt = "") :
@@ -126,6 +129,9 @@ private:
    // function doing the bin merge for histograms and profiles
    void MergeBin(const TH1 *hist, Int_t inbin, Int_t outbin);
 
+   // merge the bins [first, last) of hist into the same bins of this histogram
+   void MergeBins(const TH1 *hist, Int_t first, Int_t last);
+
    void MergeBin(const TProfile *hist, Int_t inbin, Int_t outbin) { MergeProfileBin<TProfile>(hist, inbin, outbin); }
    void MergeBin(const TProfile2D *hist, Int_t inbin, Int_t outbin) { MergeProfileBin<TProfile2D>(hist, inbin, outbin); }
    void MergeBin(const TProfile3D *hist, Int_t inbin, Int_t outbin) { MergeProfileBin<TProfile3D>(hist, inbin, outbin); }
@@ -422,6 +422,95 @@ Int_t TH3::Fill(Double_t x, Double_t y, Double_t z, Double_t w)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill a 3-D histogram with an array of values and weights.
+///
+///  - ntimes:  number of entries in arrays x, y, z and w (array size must be ntimes*stride)
+///  - x:       array of x values to be histogrammed
+///  - y:       array of y values to be histogrammed
+///  - z:       array of z values to be histogrammed
+///  - w:       array of weights
+///  - stride:  step size through arrays x, y, z and w
+///
+///   - If the weight is not equal to 1, the storage of the sum of squares of
+///     weights is automatically triggered and the sum of the squares of weights is incremented
+///     by w[i]^2 in the bin corresponding to x[i],y[i],z[i].
+///   - If w is NULL each entry is assumed a weight=1
+///
+/// If no axis can be extended, the bin numbers of a block of entries are looked up
+/// at once with TAxis::FindFixBins, which the compiler can vectorize.
+
+void TH3::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z, const Double_t *w, Int_t stride)
+{
+   Int_t binx, biny, binz, bin, i;
+   ntimes *= stride;
+   Int_t ifirst = 0;
+
+   //If a buffer is activated, fill buffer
+   // (note that this function must not be called from TH3::BufferEmpty)
+   if (fBuffer) {
+      for (i=0;i<ntimes;i+=stride) {
+         if (!fBuffer) break; // buffer can be deleted in BufferFill when is empty
+         BufferFill(x[i], y[i], z[i], w ? w[i] : 1.);
+      }
+      // fill the remaining entries if the buffer has been deleted
+      if (i < ntimes && fBuffer==nullptr)
+         ifirst = i;
+      else
+         return;
+   }
+
+   constexpr Int_t kBlock = 256;
+   Int_t binsx[kBlock], binsy[kBlock], binsz[kBlock];
+   const Bool_t bulk = (!fXaxis.CanExtend() || fXaxis.IsAlphanumeric()) &&
+                       (!fYaxis.CanExtend() || fYaxis.IsAlphanumeric()) &&
+                       (!fZaxis.CanExtend() || fZaxis.IsAlphanumeric());
+
+   Double_t ww = 1;
+   for (Int_t first = ifirst; first < ntimes; first += kBlock*stride) {
+      const Int_t n = TMath::Min(kBlock, (ntimes - first + stride - 1)/stride);
+      if (bulk) {
+         fXaxis.FindFixBins(n, &x[first], binsx, stride);
+         fYaxis.FindFixBins(n, &y[first], binsy, stride);
+         fZaxis.FindFixBins(n, &z[first], binsz, stride);
+      }
+      for (Int_t j = 0; j < n; ++j) {
+         i = first + j*stride;
+         fEntries++;
+         binx = bulk ? binsx[j] : fXaxis.FindBin(x[i]);
+         biny = bulk ? binsy[j] : fYaxis.FindBin(y[i]);
+         binz = bulk ? binsz[j] : fZaxis.FindBin(z[i]);
+         if (binx <0 || biny <0 || binz<0) continue;
+         bin  =  binx + (fXaxis.GetNbins()+2)*(biny + (fYaxis.GetNbins()+2)*binz);
+         if (w) ww = w[i];
+         if (!fSumw2.fN && ww != 1.0 && !TestBit(TH1::kIsNotW))  Sumw2();
+         if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+         AddBinContent(bin,ww);
+         if (binx == 0 || binx > fXaxis.GetNbins()) {
+            if (!GetStatOverflowsBehaviour()) continue;
+         }
+         if (biny == 0 || biny > fYaxis.GetNbins()) {
+            if (!GetStatOverflowsBehaviour()) continue;
+         }
+         if (binz == 0 || binz > fZaxis.GetNbins()) {
+            if (!GetStatOverflowsBehaviour()) continue;
+         }
+         fTsumw   += ww;
+         fTsumw2  += ww*ww;
+         fTsumwx  += ww*x[i];
+         fTsumwx2 += ww*x[i]*x[i];
+         fTsumwy  += ww*y[i];
+         fTsumwy2 += ww*y[i]*y[i];
+         fTsumwxy += ww*x[i]*y[i];
+         fTsumwz  += ww*z[i];
+         fTsumwz2 += ww*z[i]*z[i];
+         fTsumwxz += ww*x[i]*z[i];
+         fTsumwyz += ww*y[i]*z[i];
+      }
+   }
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Increment cell defined by namex,namey,namez by a weight w
 ///
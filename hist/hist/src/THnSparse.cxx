@@ -15,6 +15,7 @@
 #include "TClass.h"
 #include "TDataMember.h"
 #include "TDataType.h"
+#include "TMath.h"
 
 namespace {
 //______________________________________________________________________________
@@ -318,9 +319,9 @@ ULong64_t THnSparseCoordCompression::GetHashFromBuffer(const Char_t* buf) const
 {
    // Bins are addressed in two different modes, depending
    // on whether the compact bin index fits into a Long64_t or not.
-   // If it does, we can use it as a "perfect hash" for the TExMap.
+   // If it does, we can use it as a "perfect hash" for the bin index.
    // If not we build a hash from the compact bin index, and use that
-   // as the TExMap's hash.
+   // as the bin index's hash.
 
    if (fCoordBufferSize <= 8) {
       // fits into a Long64_t
@@ -409,6 +410,71 @@ THnSparseCompactBinCoord::~THnSparseCompactBinCoord()
    delete [] fCurrentBin;
 }
 
+/** \class THnSparseBinIndex
+THnSparseBinIndex is used internally by THnSparse to find the linear index
+of a filled bin from the hash of its compact coordinates.
+*/
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the bin with linear index linidx and hash "hash" to the index; the bin
+/// must not be in the index yet.
+
+void THnSparseBinIndex::Insert(ULong64_t hash, Long64_t linidx)
+{
+   if (2 * (fSize + 1) > GetCapacity())
+      Rehash(TMath::Max(GetCapacity() * 2, (Long64_t)16));
+   const ULong64_t mask = fSlots.size() - 1;
+   ULong64_t pos = GetStart(hash);
+   while (fSlots[pos].fIndex)
+      pos = (pos + 1) & mask;
+   fSlots[pos].fHash = hash;
+   fSlots[pos].fIndex = linidx + 1;
+   ++fSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Make room for nbins bins without further rehashing.
+
+void THnSparseBinIndex::Reserve(Long64_t nbins)
+{
+   Long64_t nslots = 16;
+   while (nslots < 2 * nbins)
+      nslots *= 2;
+   if (nslots > GetCapacity())
+      Rehash(nslots);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove all bins from the index and release its memory.
+
+void THnSparseBinIndex::Clear()
+{
+   std::vector<Slot>().swap(fSlots);
+   fSize = 0;
+   fShift = 64;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Move all entries into a new array of nslots slots (a power of two).
+
+void THnSparseBinIndex::Rehash(Long64_t nslots)
+{
+   std::vector<Slot> old(nslots, Slot{0, 0});
+   old.swap(fSlots);
+   fShift = 64;
+   for (Long64_t n = nslots; n > 1; n /= 2)
+      --fShift;
+   const ULong64_t mask = fSlots.size() - 1;
+   for (const Slot &slot : old) {
+      if (!slot.fIndex)
+         continue;
+      ULong64_t pos = GetStart(slot.fHash);
+      while (fSlots[pos].fIndex)
+         pos = (pos + 1) & mask;
+      fSlots[pos] = slot;
+   }
+}
+
 /** \class THnSparseArrayChunk
 THnSparseArrayChunk is used internally by THnSparse.
 THnSparse stores its (dynamic size) array of bin coordinates and their
@@ -570,14 +636,15 @@ Translation from an n-dimensional bin coordinate to the linear index within
 the chunks is done by GetBin(). It creates a hash from the compacted bin
 coordinates (the hash of a bin coordinate is the compacted coordinate itself
 if it takes less than 8 bytes, the size of a Long64_t.
-This hash is used to lookup the linear index in the TExMap member fBins;
+This hash is used to lookup the linear index in the open-addressing hash
+index fBins (see THnSparseBinIndex), which stores hash and linear index of
+each filled bin next to each other in one flat array;
 the coordinates of the entry fBins points to is compared to the coordinates
 passed to GetBin(). If they do not match, these two coordinates have the same
 hash - which is extremely unlikely but (for the case where the compact bin
-coordinates are larger than 4 bytes) possible. In this case, fBinsContinued
-contains a chain of linear indexes with the same hash. Iterating through this
-chain and comparing each bin coordinates with the one passed to GetBin() will
-retrieve the matching bin.
+coordinates are larger than 8 bytes) possible. In this case fBins holds
+several entries with the same hash, and probing continues until the one
+matching the coordinates passed to GetBin() is found.
 */
 
 
@@ -658,28 +725,14 @@ void THnSparse::FillExMap()
    THnSparseArrayChunk* chunk = nullptr;
    THnSparseCoordCompression compactCoord(*GetCompactCoord());
    Long64_t idx = 0;
-   if (2 * GetNbins() > fBins.Capacity())
-      fBins.Expand(3 * GetNbins());
+   fBins.Reserve(GetNbins());
    while ((chunk = (THnSparseArrayChunk*) iChunk())) {
       const Int_t chunkSize = chunk->GetEntries();
       Char_t* buf = chunk->fCoordinates;
       const Int_t singleCoordSize = chunk->fSingleCoordinateSize;
       const Char_t* endbuf = buf + singleCoordSize * chunkSize;
-      for (; buf < endbuf; buf += singleCoordSize, ++idx) {
-         Long64_t hash = compactCoord.GetHashFromBuffer(buf);
-         Long64_t linidx = fBins.GetValue(hash);
-         if (linidx) {
-            Long64_t nextidx = linidx;
-            while (nextidx) {
-               // must be a collision, so go to fBinsContinued.
-               linidx = nextidx;
-               nextidx = fBinsContinued.GetValue(linidx);
-            }
-            fBinsContinued.Add(linidx, idx + 1);
-         } else {
-            fBins.Add(hash, idx + 1);
-         }
-      }
+      for (; buf < endbuf; buf += singleCoordSize, ++idx)
+         fBins.Insert(compactCoord.GetHashFromBuffer(buf), idx);
    }
 }
 
@@ -690,9 +743,7 @@ void THnSparse::Reserve(Long64_t nbins) {
    if (!fBins.GetSize() && fBinContent.GetSize()) {
       FillExMap();
    }
-   if (2 * nbins > fBins.Capacity()) {
-      fBins.Expand(3 * nbins);
-   }
+   fBins.Reserve(nbins);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -792,19 +843,10 @@ Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
    ULong64_t hash = cc->GetHash();
    if (fBinContent.GetSize() && !fBins.GetSize())
       FillExMap();
-   Long64_t linidx = (Long64_t) fBins.GetValue(hash);
-   while (linidx) {
-      // fBins stores index + 1!
-      THnSparseArrayChunk* chunk = GetChunk((linidx - 1)/ fChunkSize);
-      if (chunk->Matches((linidx - 1) % fChunkSize, cc->GetBuffer()))
-         return linidx - 1; // we store idx+1, 0 is "TExMap: not found"
-
-      Long64_t nextlinidx = fBinsContinued.GetValue(linidx);
-      if (!nextlinidx) break;
-
-      linidx = nextlinidx;
-   }
-   if (!allocate) return -1;
+   const Long64_t linidx = fBins.Find(hash, [this, cc](Long64_t idx) {
+      return GetChunk(idx / fChunkSize)->Matches(idx % fChunkSize, cc->GetBuffer());
+   });
+   if (linidx >= 0 || !allocate) return linidx;
 
    ++fFilledBins;
 
@@ -819,16 +861,7 @@ Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
 
    // store translation between hash and bin
    newidx += (fBinContent.GetEntriesFast() - 1) * fChunkSize;
-   if (!linidx) {
-      // fBins didn't find it
-      if (2 * GetNbins() > fBins.Capacity())
-         fBins.Expand(3 * GetNbins());
-      fBins.Add(hash, newidx + 1);
-   } else {
-      // fBins contains one, but it's the wrong one;
-      // add entry to fBinsContinued.
-      fBinsContinued.Add(linidx, newidx + 1);
-   }
+   fBins.Insert(hash, newidx);
    return newidx;
 }
 
@@ -880,7 +913,7 @@ Double_t THnSparse::GetSparseFractionMem() const {
 
    Double_t size = 0.;
    size += fBinContent.GetEntries() * (GetChunkSize() * sizePerChunkElement + sizeof(THnSparseArrayChunk));
-   size += + 3 * sizeof(Long64_t) * fBins.GetSize() /* TExMap */;
+   size += fBins.GetMemorySize();
 
    Double_t nbinsTotal = 1.;
    for (Int_t d = 0; d < fNdimensions; ++d)
@@ -962,8 +995,7 @@ void THnSparse::Sumw2()
 void THnSparse::Reset(Option_t *option /*= ""*/)
 {
    fFilledBins = 0;
-   fBins.Delete();
-   fBinsContinued.Clear();
+   fBins.Clear();
    fBinContent.Delete();
    ResetBase(option);
 }
@@ -22,6 +22,17 @@
 
  The algorithm is briefly described in (4). A binned version is also implemented to address the
  performance issue due to its data size dependance.
+
+ By default the estimate is computed by summing the kernels of all the data points (or bins) for each
+ evaluation point. With large data sets the evaluation option `Evaluation:Grid` (or
+ SetEvaluation(TKDE::kGrid)) is much faster: the estimate is computed once on a fine regular grid, by
+ linear binning of the data and a FFT convolution with the kernel, and it is then linearly interpolated.
+ For the adaptive iteration, the pilot estimate used for the adaptive bandwidths is also computed on the
+ grid, and each data point is shared between the two closest bandwidths of a geometric sequence of ratio
+ 1.02, each bandwidth class being convolved with its own kernel. The grid spacing is small compared to the
+ smallest bandwidth (at most 1/8 of it), such that the relative difference with the direct evaluation is
+ typically below 1E-3.
+ Outside the range, and for user defined kernels, the direct evaluation is always used.
  */
 
 
@@ -31,6 +42,8 @@
 #include <numeric>
 #include <limits>
 #include <cassert>
+#include <cmath>
+#include <complex>
 
 #include "Math/Error.h"
 #include "TMath.h"
@@ -42,8 +55,13 @@
 #include "TF1.h"
 #include "TH1.h"
 #include "TVirtualPad.h"
+#include "TROOT.h"
 #include "TKDE.h"
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
 ClassImp(TKDE);
 
 
@@ -66,9 +84,10 @@ TKDE::TKDE() :
    fLowerPDF(nullptr),
    fApproximateBias(nullptr),
    fGraph(nullptr),
+   fEvaluation(kDirect),
    fUseMirroring(false), fMirrorLeft(false), fMirrorRight(false), fAsymLeft(false), fAsymRight(false),
    fUseBins(false), fNewData(false), fUseMinMaxFromData(false),
-   fNBins(0), fNEvents(0), fSumOfCounts(0), fUseBinsNEvents(0),
+   fNBins(0), fNEvents(0), fSumOfCounts(0), fUseBinsNEvents(0), fNGridPoints(1024),
    fMean(0.),fSigma(0.), fSigmaRob(0.), fXMin(0.), fXMax(0.),
    fRho(0.), fAdaptiveBandwidthFactor(0.), fWeightSize(0)
 {
@@ -102,6 +121,7 @@ void TKDE::Instantiate(KernelFunction_Ptr kernfunc, UInt_t events, const Double_
    fNBins = events < 10000 ? 1000 : std::min(10000, int(events / 100)*10);
    fNEvents = events;
    fUseBinsNEvents = 10000;
+   fNGridPoints = 1024;
    fMean = 0.0;
    fSigma = 0.0;
    fXMin = xMin;
@@ -113,7 +133,7 @@ void TKDE::Instantiate(KernelFunction_Ptr kernfunc, UInt_t events, const Double_
    fWeightSize = 0;
    fCanonicalBandwidths = std::vector<Double_t>(kTotalKernels, 0.0);
    fKernelSigmas2 = std::vector<Double_t>(kTotalKernels, -1.0);
-   fSettedOptions = std::vector<Bool_t>(4, kFALSE);
+   fSettedOptions = std::vector<Bool_t>(5, kFALSE);
    SetOptions(option, rho);
    CheckOptions(kTRUE);
    SetMirror();
@@ -128,7 +148,7 @@ void TKDE::SetOptions(const Option_t* option, Double_t rho) {
    TString opt = option;
    opt.ToLower();
    std::string options = opt.Data();
-   size_t numOpt = 4;
+   size_t numOpt = 5;
    std::vector<std::string> voption(numOpt, "");
    for (std::vector<std::string>::iterator it = voption.begin(); it != voption.end() && !options.empty(); ++it) {
       size_t pos = options.find_last_of(';');
@@ -264,6 +284,17 @@ void TKDE::GetOptions(std::string optionType, std::string option) {
          this->Info("GetOptions", "Possible binning type options are: Unbinned, ForcedBinning, RelaxedBinning");
          fBinning = kRelaxedBinning;
       }
+   } else if (optionType.compare("evaluation") == 0) {
+      fSettedOptions[4] = kTRUE;
+      if (option.compare("direct") == 0) {
+         fEvaluation = kDirect;
+      } else if (option.compare("grid") == 0) {
+         fEvaluation = kGrid;
+      } else {
+         this->Warning("GetOptions", "Unknown evaluation option %s: setting to Direct", option.c_str());
+         this->Info("GetOptions", "Possible evaluation type options are: Direct, Grid");
+         fEvaluation = kDirect;
+      }
    }
 }
 
@@ -281,6 +312,9 @@ void TKDE::AssureOptions() {
    if (!fSettedOptions[3]) {
       fBinning = kRelaxedBinning;
    }
+   if (!fSettedOptions[4]) {
+      fEvaluation = kDirect;
+   }
 }
 
 void TKDE::CheckOptions(Bool_t isUserDefinedKernel) {
@@ -300,6 +334,10 @@ void TKDE::CheckOptions(Bool_t isUserDefinedKernel) {
       Warning("CheckOptions", "Illegal user binning type input - use default value !");
       fBinning = kRelaxedBinning;
    }
+   if (fEvaluation != kDirect && fEvaluation != kGrid) {
+      Warning("CheckOptions", "Illegal user evaluation type input - use default value !");
+      fEvaluation = kDirect;
+   }
    if (fRho <= 0.0) {
       Warning("CheckOptions", "Tuning factor rho cannot be non-positive - use default value !");
       fRho = 1.0;
@@ -367,6 +405,25 @@ void TKDE::SetUseBinsNEvents(UInt_t nEvents) {
    SetUseBins();
 }
 
+void TKDE::SetEvaluation(EEvaluation eval) {
+   // Sets User option for the evaluation of the estimate: summing the kernels of all the data points
+   // at each evaluation (kDirect) or interpolating the estimate computed once on a grid (kGrid)
+   fEvaluation = eval;
+   CheckOptions();
+   fKernel.reset();
+}
+
+void TKDE::SetNGridPoints(UInt_t npoints) {
+   // Sets the minimum number of grid points in the range used by the kGrid evaluation.
+   // More points are used if needed to have at least 8 points per kernel bandwidth.
+   if (npoints < 2) {
+      Error("SetNGridPoints", "Number of grid points must be at least 2.");
+      return;
+   }
+   fNGridPoints = npoints;
+   fKernel.reset();
+}
+
 void TKDE::SetTuneFactor(Double_t rho) {
    // Factor which can be used to tune the smoothing.
    // It is used as multiplicative factor for the fixed and adaptive bandwidth.
@@ -605,8 +662,15 @@ void TKDE::SetKernel() {
 
    fKernel = std::make_unique<TKernel>(weight, this);
 
+   // with the grid evaluation the fixed kernel estimate on the grid is also the pilot estimate
+   // used for computing the adaptive weights
+   if (fEvaluation == kGrid) {
+      fKernel->ComputeGrid();
+   }
    if (fIteration == kAdaptive) {
       fKernel->ComputeAdaptiveWeights();
+      if (fEvaluation == kGrid)
+         fKernel->ComputeGrid();
    }
    if (gDebug) {
       if (fIteration != kAdaptive)
@@ -770,7 +834,9 @@ TKDE::TKernel::TKernel(Double_t weight, TKDE* kde) :
 // Internal class constructor
 fKDE(kde),
 fNWeights(kde->fData.size()),
-fWeights(1, weight)
+fWeights(1, weight),
+fGridMin(0),
+fGridStep(0)
 {}
 
 void TKDE::TKernel::ComputeAdaptiveWeights() {
@@ -1017,6 +1083,10 @@ Double_t TKDE::TKernel::operator()(Double_t x) const {
    // events outside range should be used to normalize the TKDE ??
    Double_t nSum = fKDE->fSumOfCounts; //(useBins) ? fKDE->fSumOfCounts : fKDE->fNEvents;
    //if (!useCount) nSum = fKDE->fNEvents;
+   // use the estimate pre-computed on the grid inside the range
+   if (!fGrid.empty() && x >= fKDE->fXMin && x <= fKDE->fXMax) {
+      return GridValue(x) / nSum;
+   }
    // in case of non-adaptive fWeights is a vector of size 1
    Bool_t hasAdaptiveWeights = (fWeights.size() == n);
    Double_t invWeight = (!hasAdaptiveWeights) ? 1. / fWeights[0] : 0;
@@ -1045,6 +1115,236 @@ Double_t TKDE::TKernel::operator()(Double_t x) const {
    return result / nSum;
 }
 
+namespace {
+
+/// In-place radix-2 FFT of a sequence whose size is a power of 2 (not normalized)
+void FFT(std::vector<std::complex<Double_t>> &a, Bool_t inverse)
+{
+   const size_t n = a.size();
+   for (size_t i = 1, j = 0; i < n; ++i) {
+      size_t bit = n >> 1;
+      for (; j & bit; bit >>= 1)
+         j ^= bit;
+      j ^= bit;
+      if (i < j)
+         std::swap(a[i], a[j]);
+   }
+   for (size_t len = 2; len <= n; len <<= 1) {
+      const Double_t angle = (inverse ? 2. : -2.) * M_PI / len;
+      const std::complex<Double_t> wlen(std::cos(angle), std::sin(angle));
+      for (size_t i = 0; i < n; i += len) {
+         std::complex<Double_t> w(1.);
+         for (size_t k = 0; k < len / 2; ++k) {
+            const std::complex<Double_t> u = a[i + k];
+            const std::complex<Double_t> v = a[i + k + len / 2] * w;
+            a[i + k] = u + v;
+            a[i + k + len / 2] = u - v;
+            w *= wlen;
+         }
+      }
+   }
+}
+
+/// Adds to result the convolution of data with the kernel values kernel[l + L], l = -L,...,L.
+/// Short kernels are applied directly, longer ones through a FFT.
+void Convolve(const std::vector<Double_t> &data, const std::vector<Double_t> &kernel, std::vector<Double_t> &result)
+{
+   const Int_t n = data.size();
+   const Int_t L = (kernel.size() - 1) / 2;
+   if (kernel.size() <= 64) {
+      for (Int_t j = 0; j < n; ++j) {
+         if (data[j] == 0)
+            continue;
+         const Int_t lmin = std::max(-L, -j);
+         const Int_t lmax = std::min(L, n - 1 - j);
+         for (Int_t l = lmin; l <= lmax; ++l)
+            result[j + l] += data[j] * kernel[l + L];
+      }
+      return;
+   }
+   // zero padding avoids the wrapping around of the circular convolution
+   size_t size = 1;
+   while (size < size_t(n + L + 1))
+      size <<= 1;
+   std::vector<std::complex<Double_t>> a(size), b(size);
+   for (Int_t j = 0; j < n; ++j)
+      a[j] = data[j];
+   for (Int_t l = -L; l <= L; ++l)
+      b[(l + Int_t(size)) % size] = kernel[l + L];
+   FFT(a, kFALSE);
+   FFT(b, kFALSE);
+   for (size_t i = 0; i < size; ++i)
+      a[i] *= b[i];
+   FFT(a, kTRUE);
+   for (Int_t j = 0; j < n; ++j)
+      result[j] += a[j].real() / size;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the (not normalized) estimate on a regular grid, which is then interpolated by operator()
+/// in the range of the TKDE. The data points, their reflections for the asymmetric mirroring, are
+/// assigned to the two closest grid points (linear binning) and convolved with the kernel with a FFT.
+/// For adaptive bandwidths, each point is split between the two closest bandwidths of a geometric
+/// sequence of ratio 1.02, and each bandwidth class is convolved with its own kernel. The classes are
+/// processed in parallel when the implicit multi-threading is enabled.
+
+void TKDE::TKernel::ComputeGrid() {
+   // minimum number of grid points per kernel bandwidth and maximum number of grid points
+   const Double_t kGridPointsPerBandwidth = 8;
+   const UInt_t kMaxGridPoints = 1 << 22;
+   // ratio between consecutive bandwidths used for the adaptive kernels
+   const Double_t kBandwidthRatio = 1.02;
+
+   fGrid.clear();
+   const Double_t support = fKDE->GetKernelSupport();
+   if (support <= 0) {
+      fKDE->Warning("ComputeGrid", "The grid evaluation is not available for user defined kernels: use the direct evaluation");
+      return;
+   }
+
+   struct KernelSource {
+      Double_t fX;
+      Double_t fCount;
+      Double_t fBandwidth;
+   };
+   std::vector<KernelSource> sources;
+   const UInt_t n = fKDE->fData.size();
+   const Bool_t useCount = (fKDE->fBinCount.size() == n);
+   const Bool_t hasAdaptiveWeights = (fWeights.size() == n);
+   sources.reserve(n * (1 + fKDE->fAsymLeft + fKDE->fAsymRight));
+   Double_t hmin = std::numeric_limits<Double_t>::max();
+   Double_t hmax = 0;
+   for (UInt_t i = 0; i < n; ++i) {
+      const Double_t h = hasAdaptiveWeights ? fWeights[i] : fWeights[0];
+      // skip data points that have 0 bandwidth, as in the direct evaluation
+      if (h <= 0)
+         continue;
+      const Double_t count = useCount ? fKDE->fBinCount[i] : 1.0;
+      sources.push_back({fKDE->fData[i], count, h});
+      if (fKDE->fAsymLeft)
+         sources.push_back({2. * fKDE->fXMin - fKDE->fData[i], count, h});
+      if (fKDE->fAsymRight)
+         sources.push_back({2. * fKDE->fXMax - fKDE->fData[i], count, h});
+      hmin = std::min(hmin, h);
+      hmax = std::max(hmax, h);
+   }
+   if (sources.empty())
+      return;
+
+   // the grid covers the range plus the kernel support, such that all the data points contributing
+   // to the estimate in the range are on the grid
+   const Double_t range = fKDE->fXMax - fKDE->fXMin;
+   Double_t step = std::min(range / fKDE->fNGridPoints, hmin / kGridPointsPerBandwidth);
+   if ((range + 2. * support * hmax) / step + 3 > kMaxGridPoints) {
+      step = (range + 2. * support * hmax) / (kMaxGridPoints - 3);
+      fKDE->Warning("ComputeGrid", "Maximum number of grid points reached: the grid spacing is %g for a minimum bandwidth of %g",
+                    step, hmin);
+   }
+   const Double_t margin = support * hmax + step;
+   const UInt_t ngrid = UInt_t(std::ceil((range + 2. * margin) / step)) + 1;
+   const Double_t gridMin = fKDE->fXMin - margin;
+
+   // the bandwidths are discretized on a geometric sequence, each source being split between the two
+   // closest bandwidths, with fractions linear in the logarithm of the bandwidth
+   const Double_t logRatio = std::log(kBandwidthRatio);
+   const UInt_t nclasses = UInt_t(std::log(hmax / hmin) / logRatio) + 2;
+   std::vector<std::vector<KernelSource>> classes(nclasses);
+   for (auto &src : sources) {
+      const Double_t t = std::log(src.fBandwidth / hmin) / logRatio;
+      const UInt_t k = std::min(nclasses - 2, UInt_t(t));
+      const Double_t frac = t - k;
+      if (frac < 1.)
+         classes[k].push_back({src.fX, src.fCount * (1. - frac), src.fBandwidth});
+      if (frac > 0.)
+         classes[k + 1].push_back({src.fX, src.fCount * frac, src.fBandwidth});
+   }
+
+   auto convolveClass = [&](UInt_t k, std::vector<Double_t> &grid) {
+      const std::vector<KernelSource> &members = classes[k];
+      if (members.empty())
+         return;
+      // linear binning of the class members
+      std::vector<Double_t> binned(ngrid, 0.);
+      for (auto &src : members) {
+         const Double_t t = (src.fX - gridMin) / step;
+         if (t < 0 || t >= ngrid - 1)
+            continue;
+         const UInt_t j = UInt_t(t);
+         const Double_t frac = t - j;
+         binned[j] += src.fCount * (1. - frac);
+         binned[j + 1] += src.fCount * frac;
+      }
+      // kernel sampled on the grid for the bandwidth of the class
+      const Double_t h = hmin * std::exp(k * logRatio);
+      const Int_t L = std::min<Int_t>(ngrid, Int_t(std::ceil(support * h / step)));
+      std::vector<Double_t> kernel(2 * L + 1);
+      for (Int_t l = -L; l <= L; ++l)
+         kernel[l + L] = (*fKDE->fKernelFunction)(l * step / h) / h;
+      Convolve(binned, kernel, grid);
+   };
+
+   fGrid.assign(ngrid, 0.);
+#ifdef R__USE_IMT
+   const UInt_t ntasks = (ROOT::IsImplicitMTEnabled() && hmax > hmin)
+                            ? std::min<UInt_t>(ROOT::GetThreadPoolSize(), nclasses)
+                            : 1;
+   if (ntasks > 1) {
+      // each task convolves every ntasks-th class on its own grid; the grids are summed in a fixed
+      // order for reproducible results
+      std::vector<std::vector<Double_t>> grids(ntasks, std::vector<Double_t>(ngrid, 0.));
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(
+         [&](UInt_t it) {
+            for (UInt_t k = it; k < nclasses; k += ntasks)
+               convolveClass(k, grids[it]);
+         },
+         ROOT::TSeq<UInt_t>(0, ntasks));
+      for (auto &grid : grids)
+         std::transform(fGrid.begin(), fGrid.end(), grid.begin(), fGrid.begin(), std::plus<Double_t>());
+   } else
+#endif
+   {
+      for (UInt_t k = 0; k < nclasses; ++k)
+         convolveClass(k, fGrid);
+   }
+   // remove the tiny negative values due to the round-off of the FFT
+   for (auto &value : fGrid)
+      value = std::max(value, 0.);
+   fGridMin = gridMin;
+   fGridStep = step;
+}
+
+////////////////////////////////////////////////////
+/// linear interpolation of the estimate on the grid
+
+Double_t TKDE::TKernel::GridValue(Double_t x) const {
+   const Double_t t = (x - fGridMin) / fGridStep;
+   UInt_t j = UInt_t(t);
+   if (j >= fGrid.size() - 1)
+      j = fGrid.size() - 2;
+   const Double_t frac = t - j;
+   return fGrid[j] * (1. - frac) + fGrid[j + 1] * frac;
+}
+
+////////////////////////////////////////////////////
+/// half-width of the kernel support in units of the bandwidth (0 if unknown)
+
+Double_t TKDE::GetKernelSupport() const {
+   switch (fKernelType) {
+      case kGaussian:
+         // GaussianKernel is zero beyond 9 sigma
+         return 9.;
+      case kEpanechnikov:
+      case kBiweight:
+      case kCosineArch:
+         return 1.;
+      default:
+         return 0.;
+   }
+}
+
 ////////////////////////////////////////////////////
 /// compute the bin index given a data point x
 UInt_t TKDE::Index(Double_t x) const {
@@ -1,9 +1,14 @@
 #include "gtest/gtest.h"
 
 #include "THn.h"
+#include "THnSparse.h"
 #include "TH1.h"
 #include "TH2.h"
 
+#include <map>
+#include <memory>
+#include <vector>
+
 // Filling THn
 TEST(THn, Fill) {
    Int_t bins[2] = {2, 3};
@@ -111,3 +116,42 @@ TEST(THn, Projection) {
    }
 
 }
+
+// Bin lookup of THnSparse, with compact coordinates that fit into a Long64_t and ones that do not
+TEST(THnSparse, BinIndex) {
+   for (Int_t nbinsPerDim : {10, 1000}) {
+      const Int_t ndim = 8;
+      std::vector<Int_t> bins(ndim, nbinsPerDim);
+      std::vector<Double_t> xmin(ndim, 0.), xmax(ndim, nbinsPerDim);
+      THnSparseD hs("hs", "hs", ndim, bins.data(), xmin.data(), xmax.data(), /*chunksize*/ 128);
+
+      std::map<std::vector<Int_t>, Double_t> expected;
+      std::vector<Int_t> coord(ndim);
+      std::vector<Double_t> x(ndim);
+      for (Int_t i = 0; i < 5000; ++i) {
+         for (Int_t d = 0; d < ndim; ++d) {
+            coord[d] = 1 + (i * (d + 3) + (i / 7) * (d + 1)) % nbinsPerDim;
+            x[d] = coord[d] - 0.5; // center of bin coord[d]
+         }
+         hs.Fill(x.data(), 1. + i % 3);
+         expected[coord] += 1. + i % 3;
+      }
+      EXPECT_EQ(hs.GetNbins(), (Long64_t)expected.size());
+
+      auto check = [&](THnSparse &h) {
+         for (auto &&binAndContent : expected)
+            EXPECT_DOUBLE_EQ(binAndContent.second, h.GetBinContent(binAndContent.first.data()));
+         std::vector<Int_t> underflow(ndim, 0);
+         EXPECT_EQ(-1, h.GetBin(underflow.data(), kFALSE));
+      };
+      check(hs);
+
+      // the index is transient: it is rebuilt from the streamed bins
+      std::unique_ptr<THnSparse> clone{static_cast<THnSparse *>(hs.Clone())};
+      check(*clone);
+
+      hs.Reset();
+      EXPECT_EQ(0, hs.GetNbins());
+      EXPECT_EQ(-1, hs.GetBin(expected.begin()->first.data(), kFALSE));
+   }
+}
@@ -1,9 +1,219 @@
 #include "gtest/gtest.h"
 
+#include "TEnv.h"
+#include "TF1.h"
+#include "TF1Convolution.h"
+#include "TFitResult.h"
 #include "TFormula.h"
+#include "TH1.h"
+#include "TInterpreter.h"
+#include "TRandom3.h"
+#include "TSystem.h"
+
+#include "ROOT/TestSupport.hxx"
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
 
 // Test that autoloading works (ROOT-9840)
 TEST(TFormula, Interp)
 {
   TFormula f("func", "TGeoBBox::DeclFileLine()");
 }
+
+// Formulas calling only functions with a vectorized implementation can be vectorized
+TEST(TFormula, CanBeVectorized)
+{
+   TFormula vec("vec", "[0]*exp(-0.5*((x-[1])/[2])^2) + sqrt(abs(x))");
+   TFormula gaus("gausvec", "gaus");
+   TFormula landau("landauvec", "landau");
+   TFormula tmath("tmathvec", "TMath::Exp(x*[0])");
+   TFormula nodim("nodim", "[0]+[1]");
+#ifdef R__HAS_VECCORE
+   EXPECT_TRUE(vec.CanBeVectorized());
+   EXPECT_TRUE(gaus.CanBeVectorized());
+#else
+   EXPECT_FALSE(vec.CanBeVectorized());
+   EXPECT_FALSE(gaus.CanBeVectorized());
+#endif
+   EXPECT_FALSE(landau.CanBeVectorized());
+   EXPECT_FALSE(tmath.CanBeVectorized());
+   EXPECT_FALSE(nodim.CanBeVectorized());
+}
+
+// Deferred formulas are compiled together, at the first evaluation or by CompilePending
+TEST(TFormula, DeferredCompilation)
+{
+   TFormula::SetCompilationDeferred();
+   TFormula f1("deferred1", "x*1.25+[0]", false);
+   TFormula f2("deferred2", "sin(x)*[0]+[1]*x*x*0.75", false);
+   TFormula f3("deferred3", "x*x*x*0.5", false);
+   TFormula::SetCompilationDeferred(false);
+   // pending formulas are valid once compiled, and not processed again by Compile
+   EXPECT_FALSE(f1.IsValid());
+   EXPECT_EQ(f1.Compile(), 0);
+   f1.SetParameter(0, 2.);
+   f2.SetParameters(3., 4.);
+   EXPECT_DOUBLE_EQ(f1.Eval(2.), 4.5);
+   EXPECT_TRUE(f1.IsValid());
+   // the other formulas have been compiled with the first one
+   EXPECT_TRUE(f2.IsValid());
+   EXPECT_EQ(TFormula::CompilePending(), 0);
+   EXPECT_DOUBLE_EQ(f2.Eval(0.5), 3. * std::sin(0.5) + 4. * 0.25 * 0.75);
+   EXPECT_DOUBLE_EQ(f3.Eval(2.), 4.);
+
+   // copies of a pending formula are compiled with it
+   TFormula::SetCompilationDeferred();
+   TFormula f4("deferred4", "x*3.5-[0]", false);
+   TFormula::SetCompilationDeferred(false);
+   f4.SetParameter(0, 1.);
+   TFormula f4copy(f4);
+   EXPECT_EQ(TFormula::CompilePending(), 1);
+   EXPECT_DOUBLE_EQ(f4.Eval(2.), 6.);
+   EXPECT_DOUBLE_EQ(f4copy.Eval(4.), 13.);
+}
+
+// Fits of formulas that can be vectorized, on enough data points to be vectorized automatically, give the same
+// result as the scalar fits. The options not supported by the vectorized evaluation (bin integral, bin volume,
+// expected errors) use the scalar evaluation.
+TEST(TFormula, FitVectorizedFormula)
+{
+   TH1D h("hfitvec", "hfitvec", 10000, -5, 5);
+   TRandom3 rndm(4357);
+   for (int i = 0; i < 200000; ++i)
+      h.Fill(rndm.Gaus(0.5, 1.2));
+   TF1 f("ffitvec", "[0]*exp(-0.5*((x-[1])/[2])^2)", -5, 5);
+
+   auto fit = [&](const std::string &option, Int_t minPoints) {
+      const Int_t oldMinPoints = gEnv->GetValue("Fit.VectorizeMinPoints", 10000);
+      gEnv->SetValue("Fit.VectorizeMinPoints", minPoints);
+      f.SetParameters(10., 0., 1.);
+      TFitResultPtr res = h.Fit(&f, (option + " Q N S").c_str());
+      gEnv->SetValue("Fit.VectorizeMinPoints", oldMinPoints);
+      EXPECT_EQ(0, res->Status()) << "option " << option;
+      return res;
+   };
+
+   for (const std::string option : {"", "I", "WIDTH", "P", "L"}) {
+      // no error is expected from the vectorized evaluation
+      ROOT::TestSupport::CheckDiagsRAII diags;
+      TFitResultPtr vectorized = fit(option, h.GetNbinsX());
+      TFitResultPtr scalar = fit(option, 0);
+      for (unsigned int i = 0; i < scalar->NPar(); ++i)
+         EXPECT_NEAR(scalar->Parameter(i), vectorized->Parameter(i), 1.E-2 * scalar->ParError(i))
+            << "option " << option << " par " << i;
+   }
+   EXPECT_FALSE(f.IsVectorized());
+}
+
+// Formulas whose compilation is pending are compiled when used to build other functions
+TEST(TFormula, DeferredConvolution)
+{
+   TFormula::SetCompilationDeferred();
+   TF1Convolution conv("exp(-0.5*x*x)", "exp(-2.*x*x)", -10., 10., false);
+   TFormula::SetCompilationDeferred(false);
+   TF1 f("deferredconv", conv, -10., 10., conv.GetNpar());
+   // convolution of two gaussians of sigma 1 and 0.5
+   EXPECT_NEAR(f.Eval(0.), std::sqrt(M_PI / 1.25), 1.E-6);
+}
+
+namespace {
+
+/// number of files in dir whose name ends with suffix
+int CountFiles(const TString &dir, const TString &suffix)
+{
+   int n = 0;
+   void *dirp = gSystem->OpenDirectory(dir);
+   if (!dirp)
+      return 0;
+   while (const char *entry = gSystem->GetDirEntry(dirp)) {
+      if (TString(entry).EndsWith(suffix))
+         ++n;
+   }
+   gSystem->FreeDirectory(dirp);
+   return n;
+}
+
+/// number of formulas of each library in the index of the compilation cache in dir
+std::vector<int> ReadIndex(const TString &dir)
+{
+   std::vector<int> nformulas;
+   std::ifstream in((dir + "/TFormulaCache.index").Data());
+   std::string line;
+   while (std::getline(in, line)) {
+      std::istringstream words(line);
+      std::string word;
+      int n = -1; // the first word is the library
+      while (words >> word)
+         ++n;
+      nformulas.push_back(n);
+   }
+   return nformulas;
+}
+
+void RemoveDirectory(const TString &dir)
+{
+   void *dirp = gSystem->OpenDirectory(dir);
+   if (!dirp)
+      return;
+   std::vector<TString> entries;
+   while (const char *entry = gSystem->GetDirEntry(dirp)) {
+      if (strcmp(entry, ".") && strcmp(entry, ".."))
+         entries.emplace_back(dir + "/" + entry);
+   }
+   gSystem->FreeDirectory(dirp);
+   for (const auto &entry : entries)
+      gSystem->Unlink(entry);
+   gSystem->Unlink(dir);
+}
+
+} // anonymous namespace
+
+// With a compilation cache directory, the deferred formulas are compiled together with ACLiC in a library
+TEST(TFormula, CompilationCache)
+{
+   const TString dir = TString::Format("%s/tformula_cache_%d", gSystem->TempDirectory(), gSystem->GetPid());
+   const TString soSuffix = TString("_C.") + gSystem->GetSoExt();
+   TFormula::SetCompilationCacheDir(dir);
+
+   TFormula::SetCompilationDeferred();
+   TFormula f1("cached1", "x*2.25+[0]", false);
+   TFormula f2("cached2", "cos(x)*[0]", false);
+   TFormula::SetCompilationDeferred(false);
+   EXPECT_EQ(TFormula::CompilePending(), 2);
+   f1.SetParameter(0, 1.);
+   f2.SetParameter(0, 2.);
+   EXPECT_DOUBLE_EQ(f1.Eval(2.), 5.5);
+   EXPECT_DOUBLE_EQ(f2.Eval(0.5), 2. * std::cos(0.5));
+   EXPECT_EQ(CountFiles(dir, ".C"), 1);
+   EXPECT_EQ(CountFiles(dir, soSuffix), 1);
+   EXPECT_EQ(CountFiles(dir, ".tmp"), 0);
+   EXPECT_EQ(CountFiles(dir, ".lock"), 0);
+   // the index gives the library of both formulas
+   EXPECT_EQ(ReadIndex(dir), std::vector<int>{2});
+
+   // a formula calling a function only declared in the interpreter does not compile with ACLiC:
+   // it is compiled by Cling, and marked as failed for the later jobs
+   gInterpreter->Declare("double tformula_cache_interpreted(double x) { return 3. * x; }");
+   TFormula::SetCompilationDeferred();
+   TFormula f3("cached3", "tformula_cache_interpreted(x)+1.5", false);
+   TFormula::SetCompilationDeferred(false);
+   {
+      ROOT::TestSupport::CheckDiagsRAII diags;
+      diags.requiredDiag(kWarning, "TFormula::CompilePending", "Cannot compile", false);
+      diags.optionalDiag(kError, "ACLiC", "", false);
+      diags.optionalDiag(kError, "TInterpreter::TCling::AutoLoad", "", false);
+      EXPECT_EQ(TFormula::CompilePending(), 1);
+   }
+   EXPECT_DOUBLE_EQ(f3.Eval(1.), 4.5);
+   EXPECT_EQ(CountFiles(dir, ".failed"), 1);
+   EXPECT_EQ(CountFiles(dir, soSuffix), 1);
+   EXPECT_EQ(ReadIndex(dir), std::vector<int>{2});
+
+   TFormula::SetCompilationCacheDir("");
+   RemoveDirectory(dir);
+}
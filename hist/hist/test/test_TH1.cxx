@@ -2,8 +2,17 @@
 
 #include "TH1.h"
 #include "TH1F.h"
+#include "TH2D.h"
+#include "TH3D.h"
 #include "THLimitsFinder.h"
+#include "TList.h"
+#include "TProfile3D.h"
+#include "TRandom3.h"
+#include "TROOT.h"
 
+#include <cmath>
+#include <limits>
+#include <memory>
 #include <vector>
 
 // StatOverflows TH1
@@ -63,3 +72,179 @@ TEST(TH1, SmoothArrayCrossCheck)
       EXPECT_FLOAT_EQ(arr2[i], 1.0);
    }
 }
+
+// FillN looks up the bins of whole arrays at once: it must give the same result as filling entry by entry
+TEST(TH1, FillNMatchesFill)
+{
+   const std::vector<double> edges{-3., -1., -0.5, 0., 0.1, 0.7, 2., 3.};
+   const int n = 1000;
+   std::vector<double> x(n), y(n), z(n), w(n);
+   for (int i = 0; i < n; ++i) {
+      x[i] = 4. * std::sin(0.37 * i);
+      y[i] = 3.5 * std::cos(0.11 * i);
+      z[i] = -3.2 + 0.0065 * i;
+      w[i] = 0.5 + (i % 7) * 0.25;
+   }
+   // exact bin edges, overflow and NaN
+   x[0] = -1.;
+   x[1] = 3.;
+   x[2] = std::numeric_limits<double>::quiet_NaN();
+   y[3] = 0.1;
+
+   auto compare = [](const TH1 &h1, const TH1 &h2) {
+      ASSERT_EQ(h1.GetNcells(), h2.GetNcells());
+      for (int bin = 0; bin < h1.GetNcells(); ++bin) {
+         EXPECT_DOUBLE_EQ(h1.GetBinContent(bin), h2.GetBinContent(bin)) << "bin " << bin;
+         EXPECT_DOUBLE_EQ(h1.GetBinError(bin), h2.GetBinError(bin)) << "bin " << bin;
+      }
+      EXPECT_DOUBLE_EQ(h1.GetEntries(), h2.GetEntries());
+      Double_t s1[TH1::kNstat] = {}, s2[TH1::kNstat] = {};
+      h1.GetStats(s1);
+      h2.GetStats(s2);
+      for (int i = 0; i < TH1::kNstat; ++i)
+         EXPECT_DOUBLE_EQ(s1[i], s2[i]) << "stat " << i;
+   };
+
+   for (bool variable : {false, true}) {
+      TH1D h1("h1", "h1", 7, -3., 3.), f1("f1", "f1", 7, -3., 3.);
+      TH2D h2("h2", "h2", 7, -3., 3., 7, -3., 3.), f2("f2", "f2", 7, -3., 3., 7, -3., 3.);
+      TH3D h3("h3", "h3", 7, -3., 3., 7, -3., 3., 7, -3., 3.), f3("f3", "f3", 7, -3., 3., 7, -3., 3., 7, -3., 3.);
+      if (variable) {
+         for (TH1 *h : std::vector<TH1 *>{&h1, &f1})
+            h->SetBins(7, edges.data());
+         for (TH1 *h : std::vector<TH1 *>{&h2, &f2})
+            h->SetBins(7, edges.data(), 7, edges.data());
+         for (TH1 *h : std::vector<TH1 *>{&h3, &f3})
+            h->SetBins(7, edges.data(), 7, edges.data(), 7, edges.data());
+      }
+      for (TH1 *h : std::vector<TH1 *>{&h1, &f1, &h2, &f2, &h3, &f3})
+         h->SetDirectory(nullptr);
+
+      // fill in the same order as below, so that the statistics are summed up identically
+      std::vector<int> order;
+      for (int i = 0; i < n - 100; ++i)
+         order.push_back(i);
+      for (int i = n - 100; i < n; i += 2)
+         order.push_back(i);
+      for (int i = n - 99; i < n; i += 2)
+         order.push_back(i);
+      for (int i : order) {
+         h1.Fill(x[i], w[i]);
+         h2.Fill(x[i], y[i], w[i]);
+         h3.Fill(x[i], y[i], z[i], w[i]);
+      }
+      // full and partial blocks of bin lookups, then a strided call
+      f1.FillN(n - 100, x.data(), w.data());
+      f2.FillN(n - 100, x.data(), y.data(), w.data());
+      f3.FillN(n - 100, x.data(), y.data(), z.data(), w.data());
+      f1.FillN(50, x.data() + n - 100, w.data() + n - 100, 2);
+      f2.FillN(50, x.data() + n - 100, y.data() + n - 100, w.data() + n - 100, 2);
+      f3.FillN(50, x.data() + n - 100, y.data() + n - 100, z.data() + n - 100, w.data() + n - 100, 2);
+      for (int i = n - 99; i < n; i += 2) {
+         f1.Fill(x[i], w[i]);
+         f2.Fill(x[i], y[i], w[i]);
+         f3.Fill(x[i], y[i], z[i], w[i]);
+      }
+
+      compare(h1, f1);
+      compare(h2, f2);
+      compare(h3, f3);
+   }
+}
+
+// Merge of histograms with the same axes, serial and in parallel
+TEST(TH1, MergeSameAxes)
+{
+   auto makeInputs = [](TList &list, bool weighted) {
+      TRandom3 rndm(4321);
+      for (int i = 0; i < 8; ++i) {
+         auto h3 = new TH3D(Form("h3_%d", i), "h3", 50, -3., 3., 50, -3., 3., 50, -3., 3.);
+         h3->SetDirectory(nullptr);
+         if (weighted && i % 2)
+            h3->Sumw2();
+         for (int j = 0; j < 20000; ++j)
+            h3->Fill(rndm.Gaus(), rndm.Gaus(), rndm.Gaus(), (weighted && i % 2) ? rndm.Uniform(0.5, 2.) : 1.);
+         list.Add(h3);
+      }
+   };
+   auto merge = [&](bool weighted, bool mt) {
+      if (mt)
+         ROOT::EnableImplicitMT(4);
+      TList list;
+      list.SetOwner();
+      makeInputs(list, weighted);
+      auto h = static_cast<TH3D *>(list.First()->Clone("merged"));
+      h->SetDirectory(nullptr);
+      h->Reset();
+      EXPECT_EQ(h->Merge(&list), 8 * 20000);
+      if (mt)
+         ROOT::DisableImplicitMT();
+      return std::unique_ptr<TH3D>(h);
+   };
+
+   for (bool weighted : {false, true}) {
+      // reference from TH1::Add
+      TList list;
+      list.SetOwner();
+      makeInputs(list, weighted);
+      auto href = static_cast<TH3D *>(list.First()->Clone("ref"));
+      href->SetDirectory(nullptr);
+      if (weighted)
+         href->Sumw2();
+      for (int i = 1; i < list.GetSize(); ++i)
+         href->Add(static_cast<TH1 *>(list.At(i)));
+
+      auto hserial = merge(weighted, false);
+      auto hparallel = merge(weighted, true);
+      EXPECT_EQ(hserial->GetSumw2N() > 0, weighted);
+      for (int bin = 0; bin < href->GetNcells(); ++bin) {
+         EXPECT_DOUBLE_EQ(hserial->GetBinContent(bin), href->GetBinContent(bin)) << "bin " << bin;
+         EXPECT_DOUBLE_EQ(hserial->GetBinError(bin), href->GetBinError(bin)) << "bin " << bin;
+         // the same sums, in the same order
+         EXPECT_EQ(hparallel->GetBinContent(bin), hserial->GetBinContent(bin)) << "bin " << bin;
+         EXPECT_EQ(hparallel->GetBinError(bin), hserial->GetBinError(bin)) << "bin " << bin;
+      }
+      EXPECT_DOUBLE_EQ(hserial->GetMean(2), href->GetMean(2));
+      EXPECT_EQ(hparallel->GetEntries(), hserial->GetEntries());
+      delete href;
+   }
+
+   // float bins without sum of squares of weights, and profiles
+   TH1F f0("f0", "f0", 100, 0., 1.), f1("f1", "f1", 100, 0., 1.), fw("fw", "fw", 100, 0., 1.);
+   TProfile3D p0("p0", "p0", 10, 0., 1., 10, 0., 1., 10, 0., 1.), p1("p1", "p1", 10, 0., 1., 10, 0., 1., 10, 0., 1.);
+   for (TH1 *h : std::vector<TH1 *>{&f0, &f1, &fw, &p0, &p1})
+      h->SetDirectory(nullptr);
+   for (int i = 0; i < 1000; ++i) {
+      const double x = (i % 97) / 97., y = (i % 89) / 89., z = (i % 83) / 83.;
+      f1.Fill(x);
+      fw.Fill(x, 0.5);
+      p0.Fill(x, y, z, x + y);
+      p1.Fill(z, y, x, 2. * z);
+   }
+   TList flist;
+   flist.Add(&f1);
+   TH1F fcopy(f1);
+   EXPECT_EQ(f0.Merge(&flist), 1000);
+   EXPECT_EQ(f0.GetSumw2N(), 0);
+   for (int bin = 0; bin < f0.GetNcells(); ++bin)
+      EXPECT_EQ(f0.GetBinContent(bin), fcopy.GetBinContent(bin)) << "bin " << bin;
+   flist.Add(&fw);
+   EXPECT_EQ(f0.Merge(&flist), 3000);
+   ASSERT_GT(f0.GetSumw2N(), 0);
+   for (int bin = 0; bin < f0.GetNcells(); ++bin) {
+      EXPECT_FLOAT_EQ(f0.GetBinContent(bin), 2 * fcopy.GetBinContent(bin) + fw.GetBinContent(bin)) << "bin " << bin;
+      EXPECT_DOUBLE_EQ(f0.GetBinError(bin) * f0.GetBinError(bin),
+                       2 * fcopy.GetBinContent(bin) + fw.GetBinError(bin) * fw.GetBinError(bin))
+         << "bin " << bin;
+   }
+
+   TProfile3D pref(p0);
+   pref.Add(&p1);
+   TList plist;
+   plist.Add(&p1);
+   p0.Merge(&plist);
+   for (int bin = 0; bin < p0.GetNcells(); ++bin) {
+      EXPECT_DOUBLE_EQ(p0.GetBinContent(bin), pref.GetBinContent(bin)) << "bin " << bin;
+      EXPECT_DOUBLE_EQ(p0.GetBinEntries(bin), pref.GetBinEntries(bin)) << "bin " << bin;
+   }
+}
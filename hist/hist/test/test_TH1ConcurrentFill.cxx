@@ -0,0 +1,140 @@
+#include "TH1ConcurrentFill.h"
+#include "TH1.h"
+#include "TH2.h"
+#include "TH3.h"
+#include "TH1K.h"
+#include "TRandom3.h"
+
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+// fill the histogram from several threads with the same points as href
+template <int NDIM>
+void FillConcurrently(TH1 &h, TH1 &href, int nthreads = 4, int npoints = 100000)
+{
+   // generate the points, including under/overflows
+   std::vector<std::vector<double>> points(nthreads);
+   std::vector<std::vector<double>> weights(nthreads);
+   TRandom3 rndm(1234);
+   for (int it = 0; it < nthreads; ++it) {
+      for (int i = 0; i < npoints; ++i) {
+         for (int idim = 0; idim < NDIM; ++idim)
+            points[it].push_back(rndm.Gaus(0.5, 0.3));
+         weights[it].push_back(rndm.Uniform(0.5, 1.5));
+         const double *x = &points[it][NDIM * i];
+         const double w = weights[it][i];
+         if (NDIM == 1)
+            href.Fill(x[0], w);
+         else if (NDIM == 2)
+            static_cast<TH2 &>(href).Fill(x[0], x[1], w);
+         else
+            static_cast<TH3 &>(href).Fill(x[0], x[1], x[2], w);
+      }
+   }
+
+   TH1ConcurrentFillManager manager(h);
+   std::vector<std::thread> threads;
+   for (int it = 0; it < nthreads; ++it) {
+      threads.emplace_back([&, it]() {
+         auto filler = manager.MakeFiller();
+         for (int i = 0; i < npoints; ++i)
+            filler.Fill(&points[it][NDIM * i], weights[it][i]);
+      });
+   }
+   for (auto &thread : threads)
+      thread.join();
+}
+
+void CompareHistograms(const TH1 &h, const TH1 &href)
+{
+   EXPECT_EQ(h.GetEntries(), href.GetEntries());
+   EXPECT_NEAR(h.GetSumOfWeights(), href.GetSumOfWeights(), 1.E-6 * href.GetSumOfWeights());
+   for (int bin = 0; bin < href.GetNcells(); ++bin) {
+      EXPECT_NEAR(h.GetBinContent(bin), href.GetBinContent(bin), 1.E-9 * std::abs(href.GetBinContent(bin)));
+      EXPECT_NEAR(h.GetBinError(bin), href.GetBinError(bin), 1.E-9 * href.GetBinError(bin));
+   }
+   for (int axis = 1; axis <= href.GetDimension(); ++axis) {
+      EXPECT_NEAR(h.GetMean(axis), href.GetMean(axis), 1.E-10);
+      EXPECT_NEAR(h.GetStdDev(axis), href.GetStdDev(axis), 1.E-10);
+   }
+}
+
+TEST(TH1ConcurrentFill, TH1D)
+{
+   TH1D h("h", "h", 100, 0, 1);
+   TH1D href("href", "href", 100, 0, 1);
+   FillConcurrently<1>(h, href);
+   CompareHistograms(h, href);
+}
+
+TEST(TH1ConcurrentFill, TH2F)
+{
+   TH2F h("h", "h", 50, 0, 1, 40, 0, 1);
+   TH2F href("href", "href", 50, 0, 1, 40, 0, 1);
+   FillConcurrently<2>(h, href);
+   // the bins are accumulated in single precision in different orders
+   EXPECT_EQ(h.GetEntries(), href.GetEntries());
+   for (int bin = 0; bin < href.GetNcells(); ++bin)
+      EXPECT_NEAR(h.GetBinContent(bin), href.GetBinContent(bin), 1.E-5 * std::abs(href.GetBinContent(bin)));
+   EXPECT_NEAR(h.GetCorrelationFactor(), href.GetCorrelationFactor(), 1.E-10);
+}
+
+TEST(TH1ConcurrentFill, TH3D)
+{
+   std::vector<double> edges = {0., 0.1, 0.3, 0.6, 1.};
+   TH3D h("h", "h", 4, edges.data(), 4, edges.data(), 4, edges.data());
+   TH3D href("href", "href", 4, edges.data(), 4, edges.data(), 4, edges.data());
+   FillConcurrently<3>(h, href);
+   CompareHistograms(h, href);
+}
+
+// histograms with integer bins are filled under a lock
+TEST(TH1ConcurrentFill, TH1I)
+{
+   TH1I h("h", "h", 100, 0, 1);
+   TH1I href("href", "href", 100, 0, 1);
+   h.SetBit(TH1::kIsNotW);
+   href.SetBit(TH1::kIsNotW);
+   TH1ConcurrentFillManager manager(h);
+   EXPECT_FALSE(manager.IsLockFree());
+   std::vector<std::thread> threads;
+   for (int it = 0; it < 4; ++it) {
+      threads.emplace_back([&]() {
+         auto filler = manager.MakeFiller();
+         for (int i = 0; i < 10000; ++i)
+            filler.Fill(0.0001 * i);
+      });
+      for (int i = 0; i < 10000; ++i)
+         href.Fill(0.0001 * i);
+   }
+   for (auto &thread : threads)
+      thread.join();
+   CompareHistograms(h, href);
+}
+
+// TH1K stores the filled values in its TArrayF, not the bin contents: it is filled under a lock
+TEST(TH1ConcurrentFill, TH1K)
+{
+   TH1K h("h", "h", 100, 0, 1);
+   TH1K href("href", "href", 100, 0, 1);
+   TH1ConcurrentFillManager manager(h);
+   EXPECT_FALSE(manager.IsLockFree());
+   EXPECT_EQ(h.GetSumw2N(), 0);
+   std::vector<std::thread> threads;
+   for (int it = 0; it < 4; ++it) {
+      threads.emplace_back([&]() {
+         auto filler = manager.MakeFiller();
+         for (int i = 0; i < 1000; ++i)
+            filler.Fill(0.001 * i);
+      });
+      for (int i = 0; i < 1000; ++i)
+         href.Fill(0.001 * i);
+   }
+   for (auto &thread : threads)
+      thread.join();
+   EXPECT_EQ(h.GetEntries(), href.GetEntries());
+   for (int bin = 1; bin <= href.GetNbinsX(); ++bin)
+      EXPECT_NEAR(h.GetBinContent(bin), href.GetBinContent(bin), 1.E-6 * std::abs(href.GetBinContent(bin)));
+}
@@ -496,4 +496,46 @@ TEST(TKDE, tkde_io_mirror)
    for (size_t i = 0; i < t.xtest.size(); ++i) {
       EXPECT_NEAR(t.values1[i], t.values2[i], delta);
    }
-}
\ No newline at end of file
+}
+// compare the grid evaluation with the direct one
+void TestGridEvaluation(const char *option, bool adaptive)
+{
+   int n = 5000;
+   TRandom3 r(2222);
+   std::vector<double> data(n);
+   for (int i = 0; i < n; ++i)
+      data[i] = (r.Rndm() < 0.2) ? r.Gaus(10, 1) : r.Gaus(10, 7);
+
+   TString opt = TString::Format("%s;Iteration:%s", option, adaptive ? "Adaptive" : "Fixed");
+   TKDE kdeDirect(n, data.data(), 0., 20., opt, 1);
+   TKDE kdeGrid(n, data.data(), 0., 20., opt + ";Evaluation:Grid", 1);
+
+   for (int i = 0; i <= 100; ++i) {
+      double x = 0.2 * i;
+      double direct = kdeDirect(x);
+      EXPECT_NEAR(kdeGrid(x), direct, 1.E-3 * direct) << "x = " << x << " option " << opt;
+   }
+   // outside the range the direct evaluation is used
+   EXPECT_DOUBLE_EQ(kdeGrid(25.), kdeDirect(25.));
+}
+
+TEST(TKDE, tkde_grid)
+{
+   TestGridEvaluation("KernelType:Gaussian", false);
+   TestGridEvaluation("KernelType:Epanechnikov", false);
+}
+
+TEST(TKDE, tkde_grid_adaptive)
+{
+   TestGridEvaluation("KernelType:Gaussian", true);
+}
+
+TEST(TKDE, tkde_grid_binned)
+{
+   TestGridEvaluation("KernelType:Gaussian;Binning:ForcedBinning", false);
+}
+
+TEST(TKDE, tkde_grid_mirror)
+{
+   TestGridEvaluation("KernelType:Gaussian;Mirror:MirrorAsymBoth", false);
+}
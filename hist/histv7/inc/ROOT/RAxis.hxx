@@ -458,6 +458,19 @@ public:
       return AdjustOverflowBinNumber(rawbin);
    }
 
+   /// Find the zero-based index of the regular bin containing the coordinate `x`, without
+   /// branches: returns 0 and sets `inRange` to `false` if `x` is in the under- or overflow bin,
+   /// else leaves `inRange` unchanged. Non-virtual, for the fast path of `RHistImpl`; consistent
+   /// with `FindBin(x) - 1` for regular bins.
+   int FindRegularBin(double x, bool &inRange) const noexcept
+   {
+      // same arithmetic as AdjustOverflowBinNumber(), for identical results on the bin borders
+      const double rawbin = FindBinRaw(x) + 1;
+      const bool regular = rawbin >= GetFirstBin() && rawbin < GetLastBin() + 1;
+      inRange &= regular;
+      return regular ? (int)rawbin - 1 : 0;
+   }
+
    /// This axis cannot grow.
    bool CanGrow() const noexcept override { return false; }
 
@@ -686,6 +699,26 @@ public:
       return rawbin;
    }
 
+   /// Find the zero-based index of the regular bin containing the coordinate `x`, with a binary
+   /// search without branches: returns 0 and sets `inRange` to `false` if `x` is in the under- or
+   /// overflow bin, else leaves `inRange` unchanged. Non-virtual, for the fast path of `RHistImpl`;
+   /// consistent with `FindBin(x) - 1` for regular bins.
+   int FindRegularBin(double x, bool &inRange) const noexcept
+   {
+      // branch-free lower_bound(): index of the first bin border that is >= x
+      const double *borders = fBinBorders.data();
+      const double *first = borders;
+      for (std::size_t n = fBinBorders.size(); n > 1;) {
+         const std::size_t half = n / 2;
+         first = (first[half] < x) ? first + half : first;
+         n -= half;
+      }
+      const int rawbin = (first - borders) + (*first < x);
+      const bool regular = rawbin >= 1 && rawbin < (int)fBinBorders.size();
+      inRange &= regular;
+      return regular ? rawbin - 1 : 0;
+   }
+
    /// Get the bin center of the bin with the given index.
    /// The result of this method on an overflow or underflow bin is unspecified.
    double GetBinCenter(int bin) const final { return 0.5 * (fBinBorders[bin - 1] + fBinBorders[bin]); }
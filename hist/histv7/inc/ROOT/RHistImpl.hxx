@@ -20,6 +20,8 @@
 #include <cctype>
 #include <functional>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 #include "ROOT/RSpan.hxx"
 
 #include "ROOT/RAxis.hxx"
@@ -706,6 +708,15 @@ struct RLocalBinsToCoords {
    }
 };
 
+/// Whether all the axes are `RAxisEquidistant` or `RAxisIrregular`, which cannot grow and whose bins
+/// can be found without virtual calls: `RHistImpl` then computes the global bin index of regular bins
+/// directly.
+template <class... AXISCONFIG>
+struct RHasFixedAxes
+   : std::integral_constant<bool, (... && (std::is_same<AXISCONFIG, RAxisEquidistant>::value ||
+                                            std::is_same<AXISCONFIG, RAxisIrregular>::value))> {
+};
+
 template <class... AXISCONFIG>
 static std::array<const RAxisBase *, sizeof...(AXISCONFIG)> GetAxisView(const AXISCONFIG &... axes) noexcept
 {
@@ -972,11 +983,31 @@ public:
       return VirtualBinsToLocalBins<NDIMS>(virtual_bins);
    }
 
+   /// Compute the global bin index `bin` of the coordinates `x` if they are in a regular bin on all
+   /// the axes, returning `false` otherwise. Only for `RAxisEquidistant` and `RAxisIrregular` axes:
+   /// the axis calls are inlined and the index is computed without branches.
+   template <std::size_t... I>
+   bool GetRegularBinIndex(const CoordArray_t &x, int &bin, std::index_sequence<I...>) const noexcept
+   {
+      bool inRange = true;
+      int binSize = 1;
+      bin = 1;
+      ((bin += binSize * std::get<I>(fAxes).FindRegularBin(x[I], inRange),
+        binSize *= std::get<I>(fAxes).GetNBinsNoOver()), ...);
+      return inRange;
+   }
+
    /// Get the bin index for the given coordinates `x`. The use of `RFindLocalBins`
    /// allows to convert the coordinates to local per-axis bin indices before using
-   /// `ComputeGlobalBin()`.
+   /// `ComputeGlobalBin()`. If all axes are `RAxisEquidistant` or `RAxisIrregular`,
+   /// regular bins are found directly by `GetRegularBinIndex()`.
    int GetBinIndex(const CoordArray_t &x) const final
    {
+      if constexpr (Internal::RHasFixedAxes<AXISCONFIG...>::value) {
+         int bin;
+         if (GetRegularBinIndex(x, bin, std::make_index_sequence<DATA::GetNDim()>()))
+            return bin;
+      }
       BinArray_t localBins = {};
       Internal::RFindLocalBins<DATA::GetNDim() - 1, DATA::GetNDim(), BinArray_t, CoordArray_t, decltype(fAxes)>()(localBins, fAxes, x);
       int result = ComputeGlobalBin<DATA::GetNDim()>(localBins);
@@ -990,6 +1021,9 @@ public:
    /// TODO: implement growable behavior
    int GetBinIndexAndGrow(const CoordArray_t &x) const final
    {
+      // fixed axes cannot grow
+      if constexpr (Internal::RHasFixedAxes<AXISCONFIG...>::value)
+         return GetBinIndex(x);
       Internal::EFindStatus status = Internal::EFindStatus::kCanGrow;
       int ret = 0;
       BinArray_t localBins = {};
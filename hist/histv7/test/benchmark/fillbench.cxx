@@ -0,0 +1,200 @@
+/// \file fillbench.cxx
+///
+/// Compare the fill rates of RH1D, RH2D and RH3D with those of TH1D, TH2D and TH3D, for equidistant and
+/// irregular axes. Run as `histv7fillbench [number of fills]`; not run as part of the tests.
+///
+/// \warning This is part of the ROOT 7 prototype! It will change without notice. It might trigger earthquakes. Feedback
+/// is welcome!
+
+#include "ROOT/RHist.hxx"
+
+#include "TH1.h"
+#include "TH2.h"
+#include "TH3.h"
+#include "TRandom3.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace ROOT::Experimental;
+
+namespace {
+
+constexpr int kNBins = 100;
+constexpr double kMin = 0.;
+constexpr double kMax = 1.;
+constexpr std::size_t kChunk = 256; // number of coordinates per FillN call
+
+/// Print the fill rate of a timed section when going out of scope.
+struct Timer {
+   using Clock_t = std::chrono::high_resolution_clock;
+
+   std::string fTitle;
+   std::size_t fCount;
+   Clock_t::time_point fStart = Clock_t::now();
+
+   Timer(std::string title, std::size_t count) : fTitle(std::move(title)), fCount(count) {}
+
+   ~Timer()
+   {
+      std::chrono::duration<double> seconds = Clock_t::now() - fStart;
+      std::cout << fTitle << ": " << seconds.count() << " seconds, \t" << fCount / 1e6 / seconds.count()
+                << " millions per second\n";
+   }
+};
+
+/// Bin borders of an irregular axis with kNBins bins in [kMin, kMax], of increasing width.
+std::vector<double> GetIrregularBorders()
+{
+   std::vector<double> borders(kNBins + 1);
+   for (int i = 0; i <= kNBins; ++i) {
+      const double u = double(i) / kNBins;
+      borders[i] = kMin + (kMax - kMin) * u * u;
+   }
+   return borders;
+}
+
+/// Random coordinates, 5% of them in the under- or overflow bins.
+template <int NDIM>
+std::vector<Hist::RCoordArray<NDIM>> GenerateInput(std::size_t count)
+{
+   TRandom3 random(42);
+   const double margin = 0.025 * (kMax - kMin);
+   std::vector<Hist::RCoordArray<NDIM>> coords(count);
+   for (auto &x : coords)
+      for (int i = 0; i < NDIM; ++i)
+         x[i] = random.Uniform(kMin - margin, kMax + margin);
+   return coords;
+}
+
+template <int NDIM>
+RHist<NDIM, double, RHistStatContent, RHistStatUncertainty> MakeRHist(bool irregular);
+
+template <>
+RH1D MakeRHist<1>(bool irregular)
+{
+   if (irregular)
+      return RH1D(RAxisConfig(GetIrregularBorders()));
+   return RH1D({kNBins, kMin, kMax});
+}
+
+template <>
+RH2D MakeRHist<2>(bool irregular)
+{
+   if (irregular)
+      return RH2D(RAxisConfig(GetIrregularBorders()), RAxisConfig(GetIrregularBorders()));
+   return RH2D({kNBins, kMin, kMax}, {kNBins, kMin, kMax});
+}
+
+template <>
+RH3D MakeRHist<3>(bool irregular)
+{
+   if (irregular)
+      return RH3D(RAxisConfig(GetIrregularBorders()), RAxisConfig(GetIrregularBorders()),
+                  RAxisConfig(GetIrregularBorders()));
+   return RH3D({kNBins, kMin, kMax}, {kNBins, kMin, kMax}, {kNBins, kMin, kMax});
+}
+
+/// Create the TH1D, TH2D or TH3D equivalent to MakeRHist<NDIM>(irregular).
+template <int NDIM>
+TH1 *MakeTHist(bool irregular)
+{
+   const std::vector<double> borders = GetIrregularBorders();
+   TH1 *hist = nullptr;
+   if (NDIM == 1) {
+      hist = irregular ? new TH1D("h1", "", kNBins, borders.data()) : new TH1D("h1", "", kNBins, kMin, kMax);
+   } else if (NDIM == 2) {
+      hist = irregular ? new TH2D("h2", "", kNBins, borders.data(), kNBins, borders.data())
+                       : new TH2D("h2", "", kNBins, kMin, kMax, kNBins, kMin, kMax);
+   } else {
+      hist = irregular ? new TH3D("h3", "", kNBins, borders.data(), kNBins, borders.data(), kNBins, borders.data())
+                       : new TH3D("h3", "", kNBins, kMin, kMax, kNBins, kMin, kMax, kNBins, kMin, kMax);
+   }
+   hist->SetDirectory(nullptr);
+   hist->Sumw2();
+   return hist;
+}
+
+template <int NDIM>
+void Benchmark(std::size_t count, bool irregular)
+{
+   const auto input = GenerateInput<NDIM>(count);
+   const std::string suffix =
+      std::to_string(NDIM) + "D " + (irregular ? "irregular  " : "equidistant") + " " + std::to_string(count);
+
+   {
+      auto hist = MakeRHist<NDIM>(irregular);
+      {
+         Timer t("RH" + suffix + " Fill   ", count);
+         for (const auto &x : input)
+            hist.Fill(x);
+      }
+   }
+   {
+      auto hist = MakeRHist<NDIM>(irregular);
+      {
+         Timer t("RH" + suffix + " FillN  ", count);
+         for (std::size_t i = 0; i < count; i += kChunk)
+            hist.FillN(std::span<const Hist::RCoordArray<NDIM>>(input.data() + i, std::min(kChunk, count - i)));
+      }
+   }
+   {
+      std::unique_ptr<TH1> hist(MakeTHist<NDIM>(irregular));
+      {
+         Timer t("TH" + suffix + " Fill   ", count);
+         if constexpr (NDIM == 1) {
+            for (const auto &x : input)
+               hist->Fill(x[0]);
+         } else if constexpr (NDIM == 2) {
+            auto h2 = static_cast<TH2 *>(hist.get());
+            for (const auto &x : input)
+               h2->Fill(x[0], x[1]);
+         } else {
+            auto h3 = static_cast<TH3 *>(hist.get());
+            for (const auto &x : input)
+               h3->Fill(x[0], x[1], x[2]);
+         }
+      }
+   }
+   {
+      std::unique_ptr<TH1> hist(MakeTHist<NDIM>(irregular));
+      {
+         Timer t("TH" + suffix + " FillN  ", count);
+         std::array<std::vector<double>, NDIM> coords;
+         for (auto &c : coords)
+            c.resize(kChunk);
+         for (std::size_t i = 0; i < count; i += kChunk) {
+            const Int_t n = std::min(kChunk, count - i);
+            for (Int_t j = 0; j < n; ++j)
+               for (int k = 0; k < NDIM; ++k)
+                  coords[k][j] = input[i + j][k];
+            if constexpr (NDIM == 1)
+               hist->FillN(n, coords[0].data(), nullptr);
+            else if constexpr (NDIM == 2)
+               static_cast<TH2 *>(hist.get())->FillN(n, coords[0].data(), coords[1].data(), nullptr);
+            else
+               static_cast<TH3 *>(hist.get())->FillN(n, coords[0].data(), coords[1].data(), coords[2].data(), nullptr);
+         }
+      }
+   }
+}
+
+} // unnamed namespace
+
+int main(int argc, char **argv)
+{
+   const std::size_t count = argc > 1 ? std::atof(argv[1]) : 1e7;
+
+   for (bool irregular : {false, true}) {
+      Benchmark<1>(count, irregular);
+      Benchmark<2>(count, irregular);
+      Benchmark<3>(count, irregular);
+   }
+   return 0;
+}
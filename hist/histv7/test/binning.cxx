@@ -287,3 +287,75 @@ TEST(HistImplBinning, GrowGrowGrow) {
                         RAxisGrow(9, -6.1, 8.7),
                         RAxisGrow(9, -4.9, 7.6));
 }
+
+// ===
+
+// Histograms with only equidistant and irregular axes find the global bin
+// index of regular bins without going through the generic per-axis lookup:
+// check that it matches the generic result for coordinates in all the regular
+// and under/overflow bins, and on the bin borders.
+template <typename... Axes>
+void TestFixedAxesBinIndex(Axes&&... axes) {
+   static constexpr std::size_t NDIMS = sizeof...(axes);
+   Detail::RHistImpl<Detail::RHistData<NDIMS,
+                                       double,
+                                       std::vector<double>,
+                                       RHistStatContent>,
+                     std::decay_t<Axes>...>
+      hist(std::forward<Axes>(axes)...);
+   // Coordinates to probe along each axis: all bin borders, all bin centers,
+   // and points beyond the axis range
+   std::array<std::vector<double>, NDIMS> axis_coords;
+   for (std::size_t axis = 0; axis < NDIMS; ++axis) {
+      const RAxisBase &a = hist.GetAxis(axis);
+      auto &coords = axis_coords[axis];
+      coords.push_back(a.GetMinimum() - 10.);
+      for (int bin = 1; bin <= a.GetNBinsNoOver(); ++bin) {
+         coords.push_back(a.GetBinFrom(bin));
+         coords.push_back(a.GetBinCenter(bin));
+      }
+      coords.push_back(a.GetMaximum());
+      coords.push_back(a.GetMaximum() + 10.);
+   }
+
+   std::array<std::size_t, NDIMS> iters = {};
+   while (iters.back() != axis_coords.back().size()) {
+      std::array<double, NDIMS> x;
+      std::array<int, NDIMS> local_bins;
+      for (std::size_t axis = 0; axis < NDIMS; ++axis) {
+         x[axis] = axis_coords[axis][iters[axis]];
+         local_bins[axis] = hist.GetAxis(axis).FindBin(x[axis]);
+      }
+      EXPECT_EQ(hist.GetBinIndex(x), hist.GetBinIndexFromLocalBins(local_bins));
+      EXPECT_EQ(hist.GetBinIndexAndGrow(x), hist.GetBinIndexFromLocalBins(local_bins));
+
+      for (std::size_t axis = 0; axis < NDIMS; ++axis) {
+         if (++iters[axis] != axis_coords[axis].size() || axis == NDIMS - 1)
+            break;
+         iters[axis] = 0;
+      }
+   }
+}
+
+TEST(HistImplBinning, FixedAxesEq) {
+   SCOPED_TRACE("1D histogram with equidistant axis");
+   TestFixedAxesBinIndex(RAxisEquidistant(6, -7.5, 5.8));
+}
+
+TEST(HistImplBinning, FixedAxesIrr) {
+   SCOPED_TRACE("1D histogram with irregular axis");
+   TestFixedAxesBinIndex(RAxisIrregular({-3.2, -1., 0.5, 0.7, 4.}));
+}
+
+TEST(HistImplBinning, FixedAxesEqIrr) {
+   SCOPED_TRACE("2D histogram with equidistant-irregular axes");
+   TestFixedAxesBinIndex(RAxisEquidistant(8, -9.5, 4.7),
+                         RAxisIrregular({-2., 0., 1., 3.}));
+}
+
+TEST(HistImplBinning, FixedAxesIrrEqEq) {
+   SCOPED_TRACE("3D histogram with irregular-equidistant-equidistant axes");
+   TestFixedAxesBinIndex(RAxisIrregular({0.1, 0.2, 0.4, 0.8, 1.6}),
+                         RAxisEquidistant(5, -3.2, -2.5),
+                         RAxisEquidistant(3, 1.0, 4.0));
+}
@@ -26,11 +26,15 @@
 #include "TDatime.h"
 #include "TList.h"
 
+#include <vector>
+
 class TKey;
 class TFile;
 
 class TDirectoryFile : public TDirectory {
 
+   friend class TKey;
+
 protected:
    Bool_t      fModified{kFALSE};        ///< True if directory has been modified
    Bool_t      fWritable{kFALSE};        ///< True if directory is writable
@@ -45,9 +49,23 @@ protected:
    TFile      *fFile{nullptr};           ///< Pointer to current file in memory
    TList      *fKeys{nullptr};           ///< Pointer to keys list in memory
 
+   /// Entry of the key index optionally stored at the end of the keys record
+   struct KeyIndexEntry {
+      UInt_t fHash;   ///< Hash of the key name
+      Int_t  fOffset; ///< Offset of the key header in the keys record
+      Int_t  fLength; ///< Length of the key header
+   };
+   mutable Int_t fNKeysIndexed{0};                   ///<! Number of keys on file if they are read on demand, 0 once all keys are in fKeys
+   Int_t       fKeyIndexOffset{0};                   ///<! Offset of the key index in the keys record
+   mutable std::vector<KeyIndexEntry> fKeyIndex;     ///<! Key index, sorted by name hash, read on the first lookup
+
    void        CleanTargets();
    void        InitDirectoryFile(TClass *cl = nullptr);
    void        BuildDirectoryFile(TFile* motherFile, TDirectory* motherDir);
+   Bool_t      ReadKeyIndex();
+   Int_t       ReadKeysRecord() const;
+   void        ReadIndexedKeys(const char *name) const;
+   void        ReadAllIndexedKeys() const;
 
 private:
    TDirectoryFile(const TDirectoryFile &directory) = delete;  //Directories cannot be copied
@@ -91,10 +109,10 @@ public:
    const TDatime      &GetCreationDate() const { return fDatimeC; }
            TFile      *GetFile() const override { return fFile; }
            TKey       *GetKey(const char *name, Short_t cycle=9999) const override;
-           TList      *GetListOfKeys() const override { return fKeys; }
+           TList      *GetListOfKeys() const override { ReadAllIndexedKeys(); return fKeys; }
    const TDatime      &GetModificationDate() const { return fDatimeM; }
            Int_t       GetNbytesKeys() const override { return fNbytesKeys; }
-           Int_t       GetNkeys() const override { return fKeys->GetSize(); }
+           Int_t       GetNkeys() const override { return fNKeysIndexed ? fNKeysIndexed : fKeys->GetSize(); }
            Long64_t    GetSeekDir() const override { return fSeekDir; }
            Long64_t    GetSeekParent() const override { return fSeekParent; }
            Long64_t    GetSeekKeys() const override { return fSeekKeys; }
@@ -123,6 +141,7 @@ public:
            Int_t       Write(const char *name=nullptr, Int_t opt=0, Int_t bufsize=0) override;
            Int_t       Write(const char *name=nullptr, Int_t opt=0, Int_t bufsize=0) const override;
            Int_t       WriteTObject(const TObject *obj, const char *name=nullptr, Option_t *option="", Int_t bufsize=0) override;
+           Int_t       WriteTObjects(const TCollection *objects, Option_t *option="", Int_t bufsize=0);
            Int_t       WriteObjectAny(const void *obj, const char *classname, const char *name, Option_t *option="", Int_t bufsize=0) override;
            Int_t       WriteObjectAny(const void *obj, const TClass *cl, const char *name, Option_t *option="", Int_t bufsize=0) override;
            void        WriteDirHeader() override;
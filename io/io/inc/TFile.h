@@ -50,9 +50,16 @@ class TProcessID;
 class TStopwatch;
 class TFilePrefetch;
 
+namespace ROOT {
+namespace Internal {
+class TFileWriteBehind;
+}
+}
+
 class TFile : public TDirectoryFile {
   friend class TDirectoryFile;
   friend class TFilePrefetch;
+  friend class ROOT::Internal::TFileWriteBehind;
 // TODO: We need to make sure only one TBasket is being written at a time
 // if we are writing multiple baskets in parallel.
 #ifdef R__USE_IMT
@@ -98,6 +105,11 @@ protected:
    TFileCacheRead  *fCacheRead{nullptr};      ///<!Pointer to the read cache (if any)
    TMap            *fCacheReadMap{nullptr};   ///<!Pointer to the read cache (if any)
    TFileCacheWrite *fCacheWrite{nullptr};     ///<!Pointer to the write cache (if any)
+   ROOT::Internal::TFileWriteBehind *fAsyncWrite{nullptr}; ///<!Background writer of the file buffers (if any)
+   Long64_t         fAsyncWriteQueueSize{0};  ///<!Queue size of the asynchronous writing stopped by ReOpen("READ")
+   char            *fMapped{nullptr};         ///<!Read-only memory mapping of the file (if any)
+   Long64_t         fMappedSize{0};           ///<!Size of the memory mapping
+   Long64_t         fMappedReadable{0};       ///<!Size of the mapping that can be read, reduced if the file is truncated
    Long64_t         fArchiveOffset{0};        ///<!Offset at which file starts in archive
    Bool_t           fIsArchive{kFALSE};       ///<!True if this is a pure archive file
    Bool_t           fNoAnchorInName{kFALSE};  ///<!True if we don't want to force the anchor to be appended to the file name
@@ -137,6 +149,9 @@ protected:
    virtual EAsyncOpenStatus GetAsyncOpenStatus() { return fAsyncOpenStatus; }
    virtual void        Init(Bool_t create);
            Bool_t      FlushWriteCache();
+           Bool_t      FlushAsyncWrite();
+           Bool_t      IsInMapping(Long64_t pos, Int_t len);
+           Long64_t    ReadMapped(char *buf, Int_t len);
            Int_t       ReadBufferViaCache(char *buf, Int_t len);
            Int_t       WriteBufferViaCache(const char *buf, Int_t len);
 
@@ -228,6 +243,7 @@ public:
    virtual const TUrl *GetEndpointUrl() const { return &fUrl; }
            TObjArray  *GetListOfProcessIDs() const {return fProcessIDs;}
            TList      *GetListOfFree() const { return fFree; }
+           const char *GetMappedBuffer(Long64_t pos, Int_t len);
    virtual Int_t       GetNfree() const { return fFree->GetSize(); }
    virtual Int_t       GetNProcessIDs() const { return fNProcessIDs; }
            Option_t   *GetOption() const override { return fOption.Data(); }
@@ -252,6 +268,8 @@ public:
            Bool_t      IsBinary() const { return TestBit(kBinaryFile); }
            Bool_t      IsRaw() const { return !fIsRootFile; }
    virtual Bool_t      IsOpen() const;
+           Bool_t      IsAsyncWrite() const { return fAsyncWrite != nullptr; }
+           Bool_t      IsMemoryMapped() const { return fMapped != nullptr; }
            void        ls(Option_t *option="") const override;
    virtual void        MakeFree(Long64_t first, Long64_t last);
    virtual void        MakeProject(const char *dirname, const char *classes="*",
@@ -274,6 +292,8 @@ public:
    virtual void        Seek(Long64_t offset, ERelativeTo pos = kBeg);
    virtual void        SetCacheRead(TFileCacheRead *cache, TObject *tree = nullptr, ECacheAction action = kDisconnect);
    virtual void        SetCacheWrite(TFileCacheWrite *cache);
+           Bool_t      SetAsyncWrite(Long64_t maxQueuedBytes);
+           Bool_t      SetMemoryMapped(Bool_t map = kTRUE);
    virtual void        SetCompressionAlgorithm(Int_t algorithm = ROOT::RCompressionSetting::EAlgorithm::kUseGlobal);
    virtual void        SetCompressionLevel(Int_t level = ROOT::RCompressionSetting::ELevel::kUseMin);
    virtual void        SetCompressionSettings(Int_t settings = ROOT::RCompressionSetting::EDefaults::kUseCompiledDefault);
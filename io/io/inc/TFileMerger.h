@@ -25,6 +25,9 @@ class TKey;
 
 namespace ROOT {
 class TIOFeatures;
+namespace Internal {
+class RFileMergerWorkers;
+}
 }  // namespace ROOT
 
 class TFileMerger : public TObject {
@@ -54,8 +57,12 @@ protected:
    TString        fObjectNames;               ///< List of object names to be either merged exclusively or skipped
    TList          fMergeList;                 ///< list of TObjString containing the name of the files need to be merged
    TList          fExcessFiles;               ///<! List of TObjString containing the name of the files not yet added to fFileList due to user or system limitation on the max number of files opened.
+   Long64_t       fMemoryBudget{0};           ///< Memory (in bytes) the merge should stay within, 0 for no limit
+   Long_t         fBatchMemStart{0};          ///<! Resident memory (in kB) when the current batch of input files started to be opened
+   ROOT::Internal::RFileMergerWorkers *fWorkers{nullptr}; ///<! Threads merging histograms in parallel during PartialMerge() with implicit MT
 
    Bool_t         OpenExcessFiles();
+   Bool_t         IsBatchFull();
    virtual Bool_t AddFile(TFile *source, Bool_t own, Bool_t cpProgress);
    virtual Bool_t MergeRecursive(TDirectory *target, TList *sourcelist, Int_t type = kRegular | kAll);
 
@@ -92,6 +99,8 @@ public:
    TFile      *GetOutputFile() const { return fOutputFile; }
    Int_t       GetMaxOpenedFiles() const { return fMaxOpenedFiles; }
    void        SetMaxOpenedFiles(Int_t newmax);
+   Long64_t    GetMemoryBudget() const { return fMemoryBudget; }
+   void        SetMemoryBudget(Long64_t bytes) { fMemoryBudget = bytes; }
    const char *GetMsgPrefix() const { return fMsgPrefix; }
    void        SetMsgPrefix(const char *prefix);
    const char *GetMergeOptions() { return fMergeOptions; }
@@ -124,7 +133,7 @@ public:
    virtual void   SetNotrees(Bool_t notrees=kFALSE) {fNoTrees = notrees;}
            void   RecursiveRemove(TObject *obj) override;
 
-   ClassDefOverride(TFileMerger, 6)  // File copying and merging services
+   ClassDefOverride(TFileMerger, 7)  // File copying and merging services
 };
 
 #endif
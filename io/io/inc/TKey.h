@@ -21,12 +21,16 @@ class TBuffer;
 #include "TBuffer.h"
 #endif
 
+#include <memory>
+
 class TBrowser;
 class TDirectory;
 class TFile;
 
 class TKey : public TNamed {
 
+   friend class TDirectoryFile;
+
 private:
    enum EStatusBits {
       kIsDirectoryFile = BIT(14),
@@ -57,6 +61,11 @@ protected:
            void     Reset(); // Currently only for the use of TBasket.
    virtual Int_t    WriteFileKeepBuffer(TFile *f = nullptr);
 
+   TKey(const TObject *obj, const char *name, TDirectory* motherDir);
+           Int_t    StreamObject(const TObject *obj, Int_t bufsize);
+           void     CreateStreamed(const TObject *obj, Int_t bufsize, Int_t nbytes);
+           const char *ReadCompressedBuffer(std::unique_ptr<char []> &compressedBuffer);
+
  public:
    TKey();
    TKey(TDirectory* motherDir);
@@ -48,10 +48,41 @@ End_Macro
 #include "TProcessUUID.h"
 #include "TVirtualMutex.h"
 #include "TEmulatedCollectionProxy.h"
+#include "TEnv.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
 
 const UInt_t kIsBigFile = BIT(16);
 const Int_t  kMaxLen = 2048;
 
+namespace {
+
+/// Marks a keys record that ends with a key index ("KIDX").
+constexpr UInt_t kKeyIndexMagic = 0x4b494458;
+/// Size of the key index trailer: number of entries, offset of the index and magic.
+constexpr Int_t kKeyIndexTrailerSize = 3 * sizeof(Int_t);
+/// Size of an entry of the key index: name hash, offset and length of the key header.
+constexpr Int_t kKeyIndexEntrySize = 3 * sizeof(Int_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// Hash of a key name as stored in the key index.
+/// This is FNV-1a rather than TString::Hash(), as it must not depend on the platform.
+
+UInt_t KeyIndexHash(const char *name)
+{
+   UInt_t hash = 2166136261u;
+   for (auto c = reinterpret_cast<const unsigned char *>(name); *c; ++c) {
+      hash ^= *c;
+      hash *= 16777619u;
+   }
+   return hash;
+}
+
+} // namespace
+
 ClassImp(TDirectoryFile);
 
 
@@ -263,6 +294,8 @@ void TDirectoryFile::Browse(TBrowser *b)
    TString name;
 
    if (b) {
+      ReadAllIndexedKeys();
+
       TObject *obj = nullptr;
       TIter nextin(fList);
       TKey *key = nullptr, *keyo = nullptr;
@@ -591,6 +624,8 @@ void TDirectoryFile::Close(Option_t *option)
    if (fKeys) {
       fKeys->Delete("slow");
    }
+   fNKeysIndexed = 0;
+   fKeyIndex.clear();
 
    TDirectoryFile::CleanTargets();
 }
@@ -801,7 +836,8 @@ TKey *TDirectoryFile::FindKeyAny(const char *keyname) const
 
    DecodeNameCycle(keyname, name, cycle, kMaxLen);
 
-   auto listOfKeys = dynamic_cast<THashList *>(GetListOfKeys());
+   ReadIndexedKeys(name);
+   auto listOfKeys = dynamic_cast<THashList *>(fKeys);
    if (!listOfKeys) {
       Error("FindKeyAny", "Unexpected type of TDirectoryFile::fKeys!");
       return nullptr;
@@ -853,7 +889,8 @@ TObject *TDirectoryFile::FindObjectAny(const char *aname) const
 
    DecodeNameCycle(aname, name, cycle, kMaxLen);
 
-   auto listOfKeys = dynamic_cast<THashList *>(GetListOfKeys());
+   ReadIndexedKeys(name);
+   auto listOfKeys = dynamic_cast<THashList *>(fKeys);
    if (!listOfKeys) {
       Error("FindObjectAny", "Unexpected type of TDirectoryFile::fKeys!");
       return nullptr;
@@ -974,7 +1011,8 @@ TObject *TDirectoryFile::Get(const char *namecycle)
 
 //*-*---------------------Case of Key---------------------
 //                        ===========
-   auto listOfKeys = dynamic_cast<THashList *>(GetListOfKeys());
+   ReadIndexedKeys(namobj);
+   auto listOfKeys = dynamic_cast<THashList *>(fKeys);
    if (!listOfKeys) {
       Error("Get", "Unexpected type of TDirectoryFile::fKeys!");
       return nullptr;
@@ -1097,7 +1135,8 @@ void *TDirectoryFile::GetObjectChecked(const char *namecycle, const TClass* expe
 
 //*-*---------------------Case of Key---------------------
 //                        ===========
-   auto listOfKeys = dynamic_cast<THashList *>(GetListOfKeys());
+   ReadIndexedKeys(namobj);
+   auto listOfKeys = dynamic_cast<THashList *>(fKeys);
    if (!listOfKeys) {
       Error("GetObjectChecked", "Unexpected type of TDirectoryFile::fKeys!");
       return nullptr;
@@ -1138,7 +1177,8 @@ TKey *TDirectoryFile::GetKey(const char *name, Short_t cycle) const
 {
    if (!fKeys) return nullptr;
 
-   auto listOfKeys = dynamic_cast<THashList *>(GetListOfKeys());
+   ReadIndexedKeys(name);
+   auto listOfKeys = dynamic_cast<THashList *>(fKeys);
    if (!listOfKeys) {
       Error("GetKey", "Unexpected type of TDirectoryFile::fKeys!");
       return nullptr;
@@ -1204,6 +1244,7 @@ void TDirectoryFile::ls(Option_t *option) const
    }
 
    if (diskobj && fKeys) {
+      ReadAllIndexedKeys();
       //*-* Loop on all the keys
       for (TObjLink *lnk = fKeys->FirstLink(); lnk != nullptr; lnk = lnk->Next()) {
          TKey *key = (TKey*)lnk->GetObject();
@@ -1415,10 +1456,70 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
       delete [] header;
    }
 
+   fNKeysIndexed = 0;
+   fKeyIndex.clear();
+   // Directories of files opened read-only read their keys on demand when
+   // the keys record has a key index, see WriteKeys().
+   if (fSeekKeys > 0 && !fFile->IsWritable() && ReadKeyIndex())
+      return fNKeysIndexed;
+
+   return ReadKeysRecord();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the trailer of the key index at the end of the keys record, if any.
+///
+/// Only the trailer is read: the index itself is read on the first lookup by
+/// ReadIndexedKeys(). Returns kTRUE if the keys record has a key index.
+
+Bool_t TDirectoryFile::ReadKeyIndex()
+{
+   if (fNbytesKeys < kKeyIndexTrailerSize)
+      return kFALSE;
+
+   char trailer[kKeyIndexTrailerSize];
+   fFile->Seek(fSeekKeys + fNbytesKeys - kKeyIndexTrailerSize);
+   if (fFile->ReadBuffer(trailer, kKeyIndexTrailerSize))
+      return kFALSE;
+
+   char *buffer = trailer;
+   Int_t nkeys, offset;
+   UInt_t magic;
+   frombuf(buffer, &nkeys);
+   frombuf(buffer, &offset);
+   frombuf(buffer, &magic);
+   if (magic != kKeyIndexMagic || nkeys <= 0 || offset <= 0 ||
+       Long64_t(offset) + Long64_t(nkeys) * kKeyIndexEntrySize + kKeyIndexTrailerSize != fNbytesKeys)
+      return kFALSE;
+
+   fNKeysIndexed = nkeys;
+   fKeyIndexOffset = offset;
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read all the keys of the keys record into fKeys.
+///
+/// Keys that are already in fKeys, because they were read through the key
+/// index, are kept (and keep their position in the record).
+
+Int_t TDirectoryFile::ReadKeysRecord() const
+{
+   auto self = const_cast<TDirectoryFile *>(this);
+   TDirectory::TContext ctxt(self);
+
+   std::unordered_map<Long64_t, TKey *> known;
+   if (fKeys->GetSize()) {
+      for (auto key : TRangeDynCast<TKey>(*fKeys))
+         known[key->GetSeekKey()] = key;
+      fKeys->Clear("nodelete");
+   }
+
+   char *buffer;
    Int_t nkeys = 0;
    Long64_t fsize = fFile->GetSize();
    if ( fSeekKeys >  0) {
-      TKey *headerkey    = new TKey(fSeekKeys, fNbytesKeys, this);
+      TKey *headerkey    = new TKey(fSeekKeys, fNbytesKeys, self);
       headerkey->ReadFile();
       buffer = headerkey->GetBuffer();
       headerkey->ReadKeyBuffer(buffer);
@@ -1426,7 +1527,7 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
       TKey *key;
       frombuf(buffer, &nkeys);
       for (Int_t i = 0; i < nkeys; i++) {
-         key = new TKey(this);
+         key = new TKey(self);
          key->ReadKeyBuffer(buffer);
          if (key->GetSeekKey() < 64 || key->GetSeekKey() > fsize) {
             Error("ReadKeys","reading illegal key, exiting after %d keys",i);
@@ -1440,14 +1541,94 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
             nkeys = i;
             break;
          }
+         auto iter = known.find(key->GetSeekKey());
+         if (iter != known.end()) {
+            delete key;
+            key = iter->second;
+            known.erase(iter);
+         }
          fKeys->Add(key);
       }
       delete headerkey;
    }
+   // Keys read through the index but not found in the record (this can only
+   // happen for a corrupted record) stay available.
+   for (auto &entry : known)
+      fKeys->Add(entry.second);
 
    return nkeys;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read the keys called `name` through the key index into fKeys.
+///
+/// Only the headers of the keys whose name hash matches are read from the
+/// file. Does nothing if all keys are already in memory or if keys with this
+/// name have been read before.
+
+void TDirectoryFile::ReadIndexedKeys(const char *name) const
+{
+   if (!fNKeysIndexed || !fKeys || fKeys->FindObject(name))
+      return;
+
+   if (fKeyIndex.empty()) {
+      Int_t nbytes = fNKeysIndexed * kKeyIndexEntrySize;
+      std::vector<char> index(nbytes);
+      fFile->Seek(fSeekKeys + fKeyIndexOffset);
+      if (fFile->ReadBuffer(index.data(), nbytes)) {
+         Error("ReadIndexedKeys", "cannot read the key index, reading all keys");
+         ReadAllIndexedKeys();
+         return;
+      }
+      fKeyIndex.resize(fNKeysIndexed);
+      char *buffer = index.data();
+      for (auto &entry : fKeyIndex) {
+         frombuf(buffer, &entry.fHash);
+         frombuf(buffer, &entry.fOffset);
+         frombuf(buffer, &entry.fLength);
+      }
+   }
+
+   auto self = const_cast<TDirectoryFile *>(this);
+   TDirectory::TContext ctxt(self);
+
+   const KeyIndexEntry value{KeyIndexHash(name), 0, 0};
+   auto range = std::equal_range(fKeyIndex.begin(), fKeyIndex.end(), value,
+                                 [](const KeyIndexEntry &a, const KeyIndexEntry &b) { return a.fHash < b.fHash; });
+   Long64_t fsize = fFile->GetSize();
+   std::vector<char> header;
+   for (auto entry = range.first; entry != range.second; ++entry) {
+      header.resize(entry->fLength);
+      fFile->Seek(fSeekKeys + entry->fOffset);
+      if (fFile->ReadBuffer(header.data(), entry->fLength)) {
+         Error("ReadIndexedKeys", "cannot read the header of key %s", name);
+         return;
+      }
+      char *buffer = header.data();
+      TKey *key = new TKey(self);
+      key->ReadKeyBuffer(buffer);
+      if (strcmp(key->GetName(), name) || key->GetSeekKey() < 64 || key->GetSeekKey() > fsize ||
+          key->GetSeekPdir() < 64 || key->GetSeekPdir() > fsize) {
+         delete key;
+         continue;
+      }
+      fKeys->Add(key);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read all the keys that were not read yet through the key index.
+
+void TDirectoryFile::ReadAllIndexedKeys() const
+{
+   if (!fNKeysIndexed || !fKeys)
+      return;
+
+   fNKeysIndexed = 0;
+   fKeyIndex.clear();
+   ReadKeysRecord();
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Read object with keyname from the current directory
@@ -1461,7 +1642,8 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
 Int_t TDirectoryFile::ReadTObject(TObject *obj, const char *keyname)
 {
    if (!fFile) { Error("ReadTObject","No file open"); return 0; }
-   auto listOfKeys = dynamic_cast<THashList *>(GetListOfKeys());
+   ReadIndexedKeys(keyname);
+   auto listOfKeys = dynamic_cast<THashList *>(fKeys);
    if (!listOfKeys) {
       Error("ReadTObject", "Unexpected type of TDirectoryFile::fKeys!");
       return 0;
@@ -1681,6 +1863,10 @@ void TDirectoryFile::SetWritable(Bool_t writable)
 {
    TDirectory::TContext ctxt(this);
 
+   // Keys that are updated or written must all be in memory.
+   if (writable)
+      ReadAllIndexedKeys();
+
    fWritable = writable;
 
    // recursively set all sub-directories
@@ -1986,6 +2172,147 @@ Int_t TDirectoryFile::WriteTObject(const TObject *obj, const char *name, Option_
    return nbytes;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Write each object of the collection in its own key in this directory.
+///
+/// The result is the same as calling WriteTObject(obj, nullptr, option, bufsize)
+/// for each object, in order: the keys are named after the objects and get the
+/// same cycles and the same order. When implicit multi-threading is enabled,
+/// the objects are however streamed and compressed in parallel; only the
+/// allocation of the keys on file and the writing of the buffers are done, in
+/// order, by the calling thread. This speeds up writing large numbers of
+/// objects, for example all the histograms of a job.
+///
+/// The options "overwrite" and "writedelete" are supported, see WriteTObject().
+/// The objects must not be modified while they are written. Objects that
+/// reference other objects through a TRef must be written with WriteTObject().
+///
+/// Returns the total number of bytes written, 0 in case of error.
+
+Int_t TDirectoryFile::WriteTObjects(const TCollection *objects, Option_t *option, Int_t bufsize)
+{
+   TDirectory::TContext ctxt(this);
+
+   if (!fFile) {
+      Error("WriteTObjects","The current directory (%s) is not associated with a file. The objects have not been written.",GetName());
+      return 0;
+   }
+
+   if (!fFile->IsWritable()) {
+      if (!fFile->TestBit(TFile::kWriteError)) {
+         // Do not print the error if the file already had a SysError.
+         Error("WriteTObjects","Directory %s is not writable", fFile->GetName());
+      }
+      return 0;
+   }
+
+   if (!objects) return 0;
+
+   const UInt_t nthreads = ROOT::IsImplicitMTEnabled() ? ROOT::GetThreadPoolSize() : 1;
+   if (nthreads < 2 || objects->GetSize() < 2 || !fFile->IsBinary()) {
+      Int_t nbytes = 0;
+      for (auto obj : *objects)
+         nbytes += WriteTObject(obj, nullptr, option, bufsize);
+      return nbytes;
+   }
+
+   TString opt = option;
+   opt.ToLower();
+   const Bool_t overwrite = opt.Contains("overwrite");
+   const Bool_t writedelete = opt.Contains("writedelete");
+
+   Int_t bsize = GetBufferSize();
+   if (bufsize > 0) bsize = bufsize;
+
+   struct PendingKey {
+      const TObject *fObject; // Object to write, nullptr if replaced by a later object of the batch
+      TKey *fKey;             // Key of the object, allocated on file only once streamed
+      TKey *fOldKey;          // Key to delete once the object is written ("writedelete")
+      Int_t fNbytes;          // Number of bytes of the streamed object
+   };
+   std::vector<PendingKey> pending;
+   std::unordered_map<TKey *, std::size_t> pendingIndex;
+   pending.reserve(objects->GetSize());
+
+   // Create the keys in order, so that they get the same cycles as with
+   // WriteTObject. The keys of the batch are not allocated on file yet.
+   for (auto obj : *objects) {
+      if (!obj) continue;
+      TString oname = obj->GetName();
+      oname = oname.Strip(TString::kTrailing);
+
+      if (overwrite) {
+         //One must use GetKey. FindObject would return the lowest cycle of the key!
+         if (TKey *key = GetKey(oname)) {
+            if (key->GetSeekKey()) {
+               key->Delete();
+            } else {
+               pending[pendingIndex[key]] = {nullptr, nullptr, nullptr, 0};
+               pendingIndex.erase(key);
+            }
+            delete key;
+         }
+      }
+      TKey *oldkey = writedelete ? GetKey(oname) : nullptr;
+      if (oldkey && !oldkey->GetSeekKey()) {
+         // The previous object of the batch is not written, but its key is
+         // kept until the end, like WriteTObject would keep it.
+         auto &previous = pending[pendingIndex[oldkey]];
+         previous.fObject = nullptr;
+         oldkey = previous.fOldKey;
+         previous.fOldKey = nullptr;
+      }
+      auto key = new TKey(obj, oname, this);
+      pendingIndex[key] = pending.size();
+      pending.push_back({obj, key, oldkey, 0});
+   }
+
+   // Stream and compress the objects in parallel, with as many threads as
+   // the implicit MT pool.
+   std::atomic<std::size_t> next{0};
+   auto streamObjects = [&]() {
+      for (std::size_t i = next++; i < pending.size(); i = next++) {
+         if (pending[i].fObject)
+            pending[i].fNbytes = pending[i].fKey->StreamObject(pending[i].fObject, bsize);
+      }
+   };
+   std::vector<std::thread> threads;
+   for (UInt_t i = 1; i < std::min<std::size_t>(nthreads, pending.size()); ++i)
+      threads.emplace_back(streamObjects);
+   streamObjects();
+   for (auto &thread : threads)
+      thread.join();
+
+   // Allocate and write the keys in order.
+   Int_t nbytes = 0;
+   Bool_t error = kFALSE;
+   for (auto &entry : pending) {
+      if (!entry.fObject || error) {
+         delete entry.fKey;
+         continue;
+      }
+      entry.fKey->CreateStreamed(entry.fObject, bsize, entry.fNbytes);
+      if (!entry.fKey->GetSeekKey()) {
+         delete entry.fKey;
+         error = kTRUE;
+         continue;
+      }
+      fFile->SumBuffer(entry.fKey->GetObjlen());
+      nbytes += entry.fKey->WriteFile(0);
+      if (fFile->TestBit(TFile::kWriteError)) {
+         error = kTRUE;
+         continue;
+      }
+      if (entry.fOldKey) {
+         entry.fOldKey->Delete();
+         delete entry.fOldKey;
+      }
+   }
+   if (bufsize) fFile->SetBufferSize(bufsize);
+
+   return error ? 0 : nbytes;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Write object from pointer of class classname in this directory.
 ///
@@ -2186,6 +2513,11 @@ void TDirectoryFile::WriteKeys()
    while ((key = (TKey*)next())) {
       nbytes += key->Sizeof();
    }
+   // Large directories get a key index after the keys, see ReadKeys().
+   const Int_t minIndexedKeys = gEnv->GetValue("TFile.KeyIndexMinKeys", 0);
+   const Bool_t writeIndex = minIndexedKeys > 0 && nkeys >= minIndexedKeys;
+   if (writeIndex)
+      nbytes += nkeys * kKeyIndexEntrySize + kKeyIndexTrailerSize;
    TKey *headerkey  = new TKey(fName,fTitle,IsA(),nbytes,this);
    if (headerkey->GetSeekKey() == 0) {
       delete headerkey;
@@ -2194,8 +2526,31 @@ void TDirectoryFile::WriteKeys()
    char *buffer = headerkey->GetBuffer();
    next.Reset();
    tobuf(buffer, nkeys);
+   std::vector<KeyIndexEntry> index;
+   if (writeIndex)
+      index.reserve(nkeys);
    while ((key = (TKey*)next())) {
+      const Int_t offset = headerkey->GetKeylen() + (buffer - headerkey->GetBuffer());
       key->FillBuffer(buffer);
+      if (writeIndex)
+         index.push_back({KeyIndexHash(key->GetName()), offset,
+                          Int_t(headerkey->GetKeylen() + (buffer - headerkey->GetBuffer())) - offset});
+   }
+   if (writeIndex) {
+      // The index goes at the very end of the record, after the spare bytes
+      // of big files; the order of the cycles of a key must be preserved.
+      std::stable_sort(index.begin(), index.end(),
+                       [](const KeyIndexEntry &a, const KeyIndexEntry &b) { return a.fHash < b.fHash; });
+      const Int_t indexOffset = headerkey->GetKeylen() + nbytes - nkeys * kKeyIndexEntrySize - kKeyIndexTrailerSize;
+      buffer = headerkey->GetBuffer() + (indexOffset - headerkey->GetKeylen());
+      for (const auto &entry : index) {
+         tobuf(buffer, entry.fHash);
+         tobuf(buffer, entry.fOffset);
+         tobuf(buffer, entry.fLength);
+      }
+      tobuf(buffer, nkeys);
+      tobuf(buffer, indexOffset);
+      tobuf(buffer, kKeyIndexMagic);
    }
 
    fSeekKeys     = headerkey->GetSeekKey();
@@ -85,6 +85,7 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include <sys/stat.h>
 #ifndef WIN32
 #include <unistd.h>
+#include <sys/mman.h>
 #ifndef R__FBSD
 #include <sys/xattr.h>
 #endif
@@ -141,7 +142,13 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include "TThreadSlots.h"
 #include "TGlobal.h"
 #include "ROOT/RConcurrentHashColl.hxx"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #ifdef R__FBSD
 #include <sys/extattr.h>
@@ -186,6 +193,127 @@ AddPseudoGlobals() {
 }
 } gAddPseudoGlobals;
 }
+
+namespace ROOT {
+namespace Internal {
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Writes the buffers of a TFile from a background thread, in the order in which they were queued.
+///
+/// The writer uses its own file descriptor, so that the position of the file's descriptor (used for reading)
+/// is not changed under the feet of the thread owning the TFile. Queueing blocks while more than the maximum
+/// number of bytes are waiting to be written.
+
+class TFileWriteBehind {
+   struct RWrite {
+      Long64_t fOffset;
+      std::vector<char> fData;
+   };
+
+   TFile &fFile;
+   Int_t fD;                   ///< File descriptor used by the writer thread
+   Long64_t fMaxQueued;        ///< Maximum number of bytes queued or being written
+   Long64_t fQueued = 0;       ///< Number of bytes queued or being written
+   std::deque<RWrite> fQueue;  ///< Buffers waiting to be written
+   bool fStop = false;         ///< Whether the writer thread should exit once the queue is empty
+   TString fError;             ///< Description of the first failed write, if any
+   std::mutex fMutex;
+   std::condition_variable fQueueChanged;
+   std::thread fThread;
+
+   void Run();
+
+public:
+   TFileWriteBehind(TFile &file, Int_t fd, Long64_t maxQueued);
+   ~TFileWriteBehind();
+
+   bool Push(Long64_t offset, const char *buf, Int_t len);
+   bool Drain();
+   const TString &GetError() const { return fError; }
+   Long64_t GetMaxQueued() const { return fMaxQueued; }
+   Int_t GetFd() const { return fD; }
+};
+
+TFileWriteBehind::TFileWriteBehind(TFile &file, Int_t fd, Long64_t maxQueued)
+   : fFile(file), fD(fd), fMaxQueued(maxQueued), fThread(&TFileWriteBehind::Run, this)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write out all the queued buffers, then stop the writer thread and close its file descriptor.
+
+TFileWriteBehind::~TFileWriteBehind()
+{
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fStop = true;
+   }
+   fQueueChanged.notify_all();
+   fThread.join();
+   fFile.SysClose(fD);
+}
+
+void TFileWriteBehind::Run()
+{
+   std::unique_lock<std::mutex> lock(fMutex);
+   while (true) {
+      fQueueChanged.wait(lock, [this] { return fStop || !fQueue.empty(); });
+      if (fQueue.empty())
+         return;
+      // The buffer stays in the queue (and counted in fQueued) until it is written.
+      RWrite &write = fQueue.front();
+      const Int_t len = write.fData.size();
+      lock.unlock();
+
+      Long64_t siz = -1;
+      if (fFile.SysSeek(fD, write.fOffset, SEEK_SET) >= 0) {
+         while ((siz = fFile.SysWrite(fD, write.fData.data(), len)) < 0 && fFile.GetErrno() == EINTR)
+            fFile.ResetErrno();
+      }
+
+      lock.lock();
+      if (siz != len && fError.IsNull()) {
+         if (siz < 0)
+            fError.Form("error writing %d bytes at offset %lld (errno %d)", len, write.fOffset, fFile.GetErrno());
+         else
+            fError.Form("error writing all requested bytes at offset %lld, wrote %lld of %d", write.fOffset, siz, len);
+      }
+      fQueued -= len;
+      fQueue.pop_front();
+      fQueueChanged.notify_all();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Queue a copy of `len` bytes of `buf`, to be written at (absolute) position `offset` of the file.
+/// Returns false if a previous write failed, in which case nothing is queued.
+
+bool TFileWriteBehind::Push(Long64_t offset, const char *buf, Int_t len)
+{
+   std::unique_lock<std::mutex> lock(fMutex);
+   // A buffer larger than the queue is accepted once the queue is empty.
+   fQueueChanged.wait(lock, [&] { return !fError.IsNull() || fQueued == 0 || fQueued + len <= fMaxQueued; });
+   if (!fError.IsNull())
+      return false;
+   fQueue.push_back({offset, std::vector<char>(buf, buf + len)});
+   fQueued += len;
+   lock.unlock();
+   fQueueChanged.notify_all();
+   return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Wait until all the queued buffers are written. Returns false if a write failed.
+
+bool TFileWriteBehind::Drain()
+{
+   std::unique_lock<std::mutex> lock(fMutex);
+   fQueueChanged.wait(lock, [this] { return fQueue.empty(); });
+   return fError.IsNull();
+}
+
+} // namespace Internal
+} // namespace ROOT
 ////////////////////////////////////////////////////////////////////////////////
 /// File default Constructor.
 
@@ -326,6 +454,13 @@ TFile::TFile() : TDirectoryFile(), fCompress(ROOT::RCompressionSetting::EAlgorit
 /// ~~~{.cpp}
 ///   TFile *f = TFile::Open("tmpname.root?reproducible=fixedname","RECREATE","File title");
 /// ~~~
+///
+/// A local file opened for reading can be memory mapped with the `"mmap"` url
+/// option (or for all files with the `TFile.MemoryMap` rootrc variable), see
+/// TFile::SetMemoryMapped():
+/// ~~~{.cpp}
+///   TFile *f = TFile::Open("name.root?mmap");
+/// ~~~
 
 TFile::TFile(const char *fname1, Option_t *option, const char *ftitle, Int_t compress)
            : TDirectoryFile(), fCompress(compress), fUrl(fname1,kTRUE)
@@ -543,11 +678,20 @@ TFile::TFile(const char *fname1, Option_t *option, const char *ftitle, Int_t com
          return;
       }
       fWritable = kFALSE;
+
+      if (fUrl.HasOption("mmap") || gEnv->GetValue("TFile.MemoryMap", 0))
+         SetMemoryMapped(kTRUE);
    }
 
    // calling virtual methods from constructor not a good idea, but it is how code was developed
    TFile::Init(create);                        // NOLINT: silence clang-tidy warnings
 
+   if (fWritable && !IsZombie()) {
+      const Long64_t asyncQueueSize = gEnv->GetValue("TFile.AsyncWriteQueueSize", 0);
+      if (asyncQueueSize > 0)
+         SetAsyncWrite(asyncQueueSize);
+   }
+
    return;
 }
 
@@ -573,6 +717,7 @@ TFile::~TFile()
    SafeDelete(fCacheRead);
    SafeDelete(fCacheReadMap);
    SafeDelete(fCacheWrite);
+   SafeDelete(fAsyncWrite);
    SafeDelete(fProcessIDs);
    SafeDelete(fFree);
    SafeDelete(fArchive);
@@ -885,7 +1030,7 @@ void TFile::Init(Bool_t create)
             }
          } else if (fVersion != gROOT->GetVersionInt() && fVersion > 30000) {
             // Don't complain about missing streamer info for empty files.
-            if (fKeys->GetSize()) {
+            if (GetNkeys()) {
                Warning("Init","no StreamerInfo found in %s therefore preventing schema evolution when reading this file."
                               " The file was produced with version %d.%02d/%02d of ROOT.",
                               GetName(),  fVersion / 10000, (fVersion / 100) % (100), fVersion  % 100);
@@ -895,7 +1040,13 @@ void TFile::Init(Bool_t create)
    }
 
    // Count number of TProcessIDs in this file
-   {
+   if (fNKeysIndexed) {
+      // The keys are read on demand: look the process IDs up by name instead
+      // of reading all keys. They are written as ProcessID0, ProcessID1, ...
+      while (GetKey(TString::Format("ProcessID%d", fNProcessIDs)))
+         fNProcessIDs++;
+      fProcessIDs = new TObjArray(fNProcessIDs+1);
+   } else {
       TIter next(fKeys);
       TKey *key;
       while ((key = (TKey*)next())) {
@@ -939,6 +1090,7 @@ void TFile::Close(Option_t *option)
 
    if (fIsArchive || !fIsRootFile) {
       FlushWriteCache();
+      SetMemoryMapped(kFALSE);
       SysClose(fD);
       fD = -1;
 
@@ -981,6 +1133,7 @@ void TFile::Close(Option_t *option)
    fMustFlush = kTRUE;
 
    FlushWriteCache();
+   SetAsyncWrite(0);
 
    if (gMonitoringWriter)
       gMonitoringWriter->SendFileCloseEvent(this);
@@ -994,6 +1147,7 @@ void TFile::Close(Option_t *option)
    }
 
    if (IsOpen()) {
+      SetMemoryMapped(kFALSE);
       SysClose(fD);
       fD = -1;
    }
@@ -1124,6 +1278,7 @@ void TFile::Flush()
 {
    if (IsOpen() && fWritable) {
       FlushWriteCache();
+      FlushAsyncWrite();
       if (SysSync(fD) < 0) {
          // Write the system error only once for this file
          SetBit(kWriteError); SetWritable(kFALSE);
@@ -1334,6 +1489,7 @@ Long64_t TFile::GetSize() const
       size = fArchive->GetMember()->GetDecompressedSize();
    } else {
       Long_t id, flags, modtime;
+      const_cast<TFile*>(this)->FlushAsyncWrite();
       if (const_cast<TFile*>(this)->SysStat(fD, &id, &size, &flags, &modtime)) {  // NOLINT: silence clang-tidy warnings
          Error("GetSize", "cannot stat the file %s", GetName());
          return -1;
@@ -1703,6 +1859,7 @@ Bool_t TFile::ReadBuffer(char *buf, Long64_t pos, Int_t len)
 {
    if (IsOpen()) {
 
+      FlushAsyncWrite();
       SetOffset(pos);
 
       Int_t st;
@@ -1718,8 +1875,12 @@ Bool_t TFile::ReadBuffer(char *buf, Long64_t pos, Int_t len)
       Seek(pos);
       ssize_t siz;
 
-      while ((siz = SysRead(fD, buf, len)) < 0 && GetErrno() == EINTR)
-         ResetErrno();
+      if (fMapped) {
+         siz = ReadMapped(buf, len);
+      } else {
+         while ((siz = SysRead(fD, buf, len)) < 0 && GetErrno() == EINTR)
+            ResetErrno();
+      }
 
       if (siz < 0) {
          SysError("ReadBuffer", "error reading from file %s", GetName());
@@ -1753,6 +1914,8 @@ Bool_t TFile::ReadBuffer(char *buf, Int_t len)
 {
    if (IsOpen()) {
 
+      FlushAsyncWrite();
+
       Int_t st;
       if ((st = ReadBufferViaCache(buf, len))) {
          if (st == 2)
@@ -1760,13 +1923,17 @@ Bool_t TFile::ReadBuffer(char *buf, Int_t len)
          return kFALSE;
       }
 
-      ssize_t siz;
       Double_t start = 0;
 
       if (gPerfStats) start = TTimeStamp();
 
-      while ((siz = SysRead(fD, buf, len)) < 0 && GetErrno() == EINTR)
-         ResetErrno();
+      ssize_t siz;
+      if (fMapped) {
+         siz = ReadMapped(buf, len);
+      } else {
+         while ((siz = SysRead(fD, buf, len)) < 0 && GetErrno() == EINTR)
+            ResetErrno();
+      }
 
       if (siz < 0) {
          SysError("ReadBuffer", "error reading from file %s", GetName());
@@ -1812,10 +1979,24 @@ Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
       return kFALSE;
    }
 
+   FlushAsyncWrite();
+
    Int_t k = 0;
    Bool_t result = kTRUE;
    TFileCacheRead *old = fCacheRead;
    fCacheRead = nullptr;
+
+   if (fMapped) {
+      // No need to read ahead: the blocks are copied from the mapping one by one
+      for (Int_t i = 0; i < nbuf; i++) {
+         Seek(pos[i]);
+         result = ReadBuffer(&buf[k], len[i]);
+         if (result) break;
+         k += len[i];
+      }
+      fCacheRead = old;
+      return result;
+   }
    Long64_t curbegin = pos[0];
    Long64_t cur;
    char *buf2 = nullptr;
@@ -2140,6 +2321,11 @@ Int_t TFile::Recover()
 /// did not change (was already as requested or wrong input arguments)
 /// and -1 in case of failure, in which case the file cannot be used
 /// anymore. The current directory (gFile) is changed to this file.
+///
+/// Asynchronous writing (see SetAsyncWrite()) is stopped when switching
+/// to READ, and enabled again with the same queue size when switching
+/// back to UPDATE (or as set by `TFile.AsyncWriteQueueSize` if it was not
+/// enabled before).
 
 Int_t TFile::ReOpen(Option_t *mode)
 {
@@ -2173,6 +2359,9 @@ Int_t TFile::ReOpen(Option_t *mode)
          }
 
          FlushWriteCache();
+         if (fAsyncWrite)
+            fAsyncWriteQueueSize = fAsyncWrite->GetMaxQueued();
+         SetAsyncWrite(0);
 
          // delete free segments from free list
          fFree->Delete();
@@ -2202,6 +2391,7 @@ Int_t TFile::ReOpen(Option_t *mode)
 
       // close readonly file
       if (IsOpen()) {
+         SetMemoryMapped(kFALSE);
          SysClose(fD);
          fD = -1;
       }
@@ -2224,6 +2414,12 @@ Int_t TFile::ReOpen(Option_t *mode)
          ReadFree();
       else
          Warning("ReOpen","file %s probably not closed, cannot read free segments", GetName());
+
+      const Long64_t asyncQueueSize =
+         fAsyncWriteQueueSize > 0 ? fAsyncWriteQueueSize : gEnv->GetValue("TFile.AsyncWriteQueueSize", 0);
+      fAsyncWriteQueueSize = 0;
+      if (asyncQueueSize > 0)
+         SetAsyncWrite(asyncQueueSize);
    }
 
    return 0;
@@ -2269,8 +2465,14 @@ void TFile::Seek(Long64_t offset, ERelativeTo pos)
          // this option is not used currently in the ROOT code
          if (fArchiveOffset)
             Error("Seek", "seeking from end in archive is not (yet) supported");
+         FlushAsyncWrite();
          break;
    }
+   if (fMapped && whence != SEEK_END) {
+      // Reading from the mapping does not use the position of the file descriptor
+      fOffset = whence == SEEK_SET ? offset : fOffset + offset;
+      return;
+   }
    Long64_t retpos;
    if ((retpos = SysSeek(fD, offset, whence)) < 0)  // NOLINT: silence clang-tidy warnings
       SysError("Seek", "cannot seek to position %lld in file %s, retpos=%lld",
@@ -2466,6 +2668,24 @@ Bool_t TFile::WriteBuffer(const char *buf, Int_t len)
          return kFALSE;
       }
 
+      if (fAsyncWrite) {
+         // Queue the buffer at the current position, and move the file descriptor as the write would.
+         const Long64_t pos = SysSeek(fD, 0, SEEK_CUR);
+         if (pos < 0 || !fAsyncWrite->Push(pos, buf, len)) {
+            SetBit(kWriteError); SetWritable(kFALSE);
+            Error("WriteBuffer", "error writing to file %s: %s", GetName(), fAsyncWrite->GetError().Data());
+            return kTRUE;
+         }
+         SysSeek(fD, len, SEEK_CUR);
+         fBytesWrite  += len;
+         fgBytesWrite += len;
+
+         if (gMonitoringWriter)
+            gMonitoringWriter->SendFileWriteProgress(this);
+
+         return kFALSE;
+      }
+
       ssize_t siz;
       gSystem->IgnoreInterrupt();
       while ((siz = SysWrite(fD, buf, len)) < 0 && GetErrno() == EINTR)  // NOLINT: silence clang-tidy warnings
@@ -2494,6 +2714,214 @@ Bool_t TFile::WriteBuffer(const char *buf, Int_t len)
    return kTRUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable or disable asynchronous writing ("write-behind") for this file.
+///
+/// When enabled, WriteBuffer() queues a copy of the buffer, e.g. a compressed basket or key, and returns
+/// immediately; a dedicated thread writes the queued buffers to disk in order. At most `maxQueuedBytes`
+/// bytes are queued at any time: beyond that, WriteBuffer() waits for the writer thread to catch up.
+/// Reading from the file, Flush() and Close() first wait for all queued buffers to be written, so the
+/// file header, free segments list and keys lists written at Close() always land after the data.
+///
+/// A value of 0 for `maxQueuedBytes` writes out the pending buffers and disables asynchronous writing.
+/// Asynchronous writing can also be enabled for all local files opened for writing with the
+/// `TFile.AsyncWriteQueueSize` rootrc variable.
+///
+/// Only local files (TFile itself, not its derived classes) support asynchronous writing.
+/// Returns kFALSE in case of failure.
+
+Bool_t TFile::SetAsyncWrite(Long64_t maxQueuedBytes)
+{
+   if (maxQueuedBytes <= 0) {
+      if (!fAsyncWrite)
+         return kTRUE;
+      const Bool_t ok = FlushAsyncWrite();
+      delete fAsyncWrite;
+      fAsyncWrite = nullptr;
+      return ok;
+   }
+   if (!IsOpen() || !IsWritable()) {
+      Error("SetAsyncWrite", "file %s is not open for writing", GetName());
+      return kFALSE;
+   }
+   if (IsA() != TFile::Class() || fIsArchive) {
+      Error("SetAsyncWrite", "asynchronous writing is only supported for local files");
+      return kFALSE;
+   }
+   if (fAsyncWrite)
+      return SetAsyncWrite(0) && SetAsyncWrite(maxQueuedBytes);
+
+#ifndef WIN32
+   const Int_t fd = SysOpen(fRealName, O_WRONLY, 0644);
+#else
+   const Int_t fd = SysOpen(fRealName, O_WRONLY | O_BINARY, S_IREAD | S_IWRITE);
+#endif
+   if (fd == -1) {
+      SysError("SetAsyncWrite", "file %s can not be opened for asynchronous writing", GetName());
+      return kFALSE;
+   }
+   fAsyncWrite = new ROOT::Internal::TFileWriteBehind(*this, fd, maxQueuedBytes);
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Wait until all the buffers queued for asynchronous writing are on disk.
+/// Returns kFALSE in case of failure.
+
+Bool_t TFile::FlushAsyncWrite()
+{
+   if (!fAsyncWrite)
+      return kTRUE;
+   if (!fAsyncWrite->Drain()) {
+      if (!TestBit(kWriteError)) {
+         // Write the system error only once for this file
+         SetBit(kWriteError); SetWritable(kFALSE);
+         Error("FlushAsyncWrite", "error writing to file %s: %s", GetName(), fAsyncWrite->GetError().Data());
+      }
+      return kFALSE;
+   }
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Map (or unmap) a local file opened for reading in memory.
+///
+/// Reads of memory mapped files copy the data from the mapping instead of
+/// issuing a system call for each buffer, and TKey decompresses objects
+/// directly from the mapping (see GetMappedBuffer()). This suits files on a
+/// local disk that are read many times, e.g. analysis files in a local cache.
+/// Files can also be mapped when they are opened, with the `"mmap"` url option
+/// or the `TFile.MemoryMap` rootrc variable.
+///
+/// Only local files (TFile itself, not its derived classes) opened for reading
+/// can be memory mapped. The mapping is released when the file is closed or
+/// reopened for update. If the file is truncated while it is mapped, the data
+/// beyond its new end is read with system calls, which report the error,
+/// instead of through the mapping. Returns kFALSE in case of failure.
+
+Bool_t TFile::SetMemoryMapped(Bool_t map)
+{
+   if (!map) {
+#ifndef WIN32
+      if (fMapped)
+         munmap(fMapped, fMappedSize);
+#endif
+      fMapped = nullptr;
+      fMappedSize = 0;
+      fMappedReadable = 0;
+      return kTRUE;
+   }
+   if (fMapped)
+      return kTRUE;
+   if (!IsOpen() || IsWritable()) {
+      Error("SetMemoryMapped", "file %s is not open for reading only", GetName());
+      return kFALSE;
+   }
+   if (IsA() != TFile::Class()) {
+      Error("SetMemoryMapped", "memory mapping is only supported for local files");
+      return kFALSE;
+   }
+#ifndef WIN32
+   Long_t id, flags, modtime;
+   Long64_t size;
+   if (SysStat(fD, &id, &size, &flags, &modtime) || size <= 0) {
+      Error("SetMemoryMapped", "cannot stat the file %s", GetName());
+      return kFALSE;
+   }
+   void *mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, fD, 0);
+   if (mapped == MAP_FAILED) {
+      SysError("SetMemoryMapped", "cannot map file %s in memory", GetName());
+      return kFALSE;
+   }
+   fMapped = static_cast<char *>(mapped);
+   fMappedSize = size;
+   fMappedReadable = size;
+   return kTRUE;
+#else
+   Error("SetMemoryMapped", "memory mapping is not supported on this platform");
+   return kFALSE;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a pointer to the len bytes at position pos of a memory mapped
+/// file, or nullptr if the file is not memory mapped (see SetMemoryMapped())
+/// or the range is not in the mapping.
+///
+/// This allows to use the data without copying it; it is accounted for as a
+/// read of the file. The pointer is valid until the file is closed.
+
+const char *TFile::GetMappedBuffer(Long64_t pos, Int_t len)
+{
+   pos += fArchiveOffset;
+   if (!IsInMapping(pos, len))
+      return nullptr;
+
+   fBytesRead  += len;
+   fgBytesRead += len;
+   fReadCalls++;
+   fgReadCalls++;
+
+   if (gMonitoringWriter)
+      gMonitoringWriter->SendFileReadProgress(this);
+   if (gPerfStats)
+      gPerfStats->FileReadEvent(this, len, TTimeStamp());
+   return fMapped + pos;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if the len bytes at (absolute) position pos can be read from
+/// the mapping of the file.
+///
+/// Accessing the pages of the mapping beyond the end of a file truncated
+/// after it was mapped raises SIGBUS: the size of the file is compared with
+/// the readable size of the mapping, which is reduced if the file shrank.
+
+Bool_t TFile::IsInMapping(Long64_t pos, Int_t len)
+{
+   if (!fMapped || pos < 0 || len < 0 || pos + len > fMappedReadable)
+      return kFALSE;
+#ifndef WIN32
+   Long_t id, flags, modtime;
+   Long64_t size;
+   if (SysStat(fD, &id, &size, &flags, &modtime))
+      return kFALSE;
+   if (size < fMappedReadable) {
+      Warning("IsInMapping", "file %s was truncated from %lld to %lld bytes while memory mapped", GetName(),
+              fMappedReadable, size);
+      fMappedReadable = std::max<Long64_t>(0, size);
+      return pos + len <= fMappedReadable;
+   }
+#endif
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read len bytes at the current position of a memory mapped file, and
+/// advance the current position.
+///
+/// The data is copied from the mapping, or read from the file if it is beyond
+/// the mapping (i.e. the file grew since it was mapped, or was truncated, in
+/// which case the read reports the error).
+/// Returns the number of bytes read, or -1 in case of error.
+
+Long64_t TFile::ReadMapped(char *buf, Int_t len)
+{
+   if (IsInMapping(fOffset, len)) {
+      memcpy(buf, fMapped + fOffset, len);
+   } else {
+      ssize_t siz;
+      SysSeek(fD, fOffset, SEEK_SET);
+      while ((siz = SysRead(fD, buf, len)) < 0 && GetErrno() == EINTR)
+         ResetErrno();
+      if (siz < 0)
+         return -1;
+      len = siz;
+   }
+   fOffset += len;
+   return len;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Write buffer via cache. Returns 0 if cache is not active, 1 in case
 /// write via cache was successful, 2 in case write via cache failed.
@@ -39,6 +39,7 @@ to be merged, like the standalone hadd program.
 #include "TROOT.h"
 #include "TMemFile.h"
 #include "TVirtualMutex.h"
+#include "TStopwatch.h"
 
 #ifdef WIN32
 // For _getmaxstdio
@@ -49,7 +50,89 @@ to be merged, like the standalone hadd program.
 #include <sys/resource.h>
 #endif
 
+#include <algorithm>
+#include <condition_variable>
 #include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+
+/// Threads that merge histograms in parallel. The Imt library depends on RIO (through MultiProc and Net), so RIO
+/// cannot submit tasks to the implicit MT pool and keeps its own threads instead, as many as the pool has. They are
+/// started at the first Run() and kept for the whole PartialMerge() rather than started again for each key.
+class RFileMergerWorkers {
+   unsigned int fNThreads;
+   std::vector<std::thread> fThreads;
+   std::mutex fMutex;
+   std::condition_variable fWakeUp;   ///< Signals new tasks, or the end of the workers
+   std::condition_variable fAllDone;  ///< Signals that the last task of Run() finished
+   std::function<void(unsigned int)> fTask;
+   unsigned int fNextTask = 0;
+   unsigned int fNTasks = 0;
+   unsigned int fNPending = 0;
+   bool fStop = false;
+
+   void Work()
+   {
+      std::unique_lock<std::mutex> lock(fMutex);
+      while (true) {
+         fWakeUp.wait(lock, [this] { return fStop || fNextTask < fNTasks; });
+         if (fStop)
+            return;
+         const unsigned int task = fNextTask++;
+         lock.unlock();
+         fTask(task);
+         lock.lock();
+         if (--fNPending == 0)
+            fAllDone.notify_one();
+      }
+   }
+
+public:
+   explicit RFileMergerWorkers(unsigned int nThreads) : fNThreads(nThreads) {}
+
+   ~RFileMergerWorkers()
+   {
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         fStop = true;
+      }
+      fWakeUp.notify_all();
+      for (auto &thread : fThreads)
+         thread.join();
+   }
+
+   unsigned int GetSize() const { return fNThreads; }
+
+   /// Call task(0), ..., task(nTasks - 1) on the worker threads and wait until they all returned.
+   void Run(unsigned int nTasks, std::function<void(unsigned int)> task)
+   {
+      if (nTasks == 0)
+         return;
+      // only merges that have objects to merge in parallel pay for the threads
+      if (fThreads.empty()) {
+         for (unsigned int i = 0; i < fNThreads; ++i)
+            fThreads.emplace_back(&RFileMergerWorkers::Work, this);
+      }
+      std::unique_lock<std::mutex> lock(fMutex);
+      fTask = std::move(task);
+      fNextTask = 0;
+      fNTasks = nTasks;
+      fNPending = nTasks;
+      fWakeUp.notify_all();
+      fAllDone.wait(lock, [this] { return fNPending == 0; });
+      fNTasks = 0;
+      fTask = nullptr;
+   }
+};
+
+} // namespace Internal
+} // namespace ROOT
 
 ClassImp(TFileMerger);
 
@@ -58,6 +141,8 @@ TClassRef R__TTree_Class("TTree");
 
 static const Int_t kCpProgress = BIT(14);
 static const Int_t kCintFileNumber = 100;
+// Print level above which PartialMerge reports its progress: above the default level of hadd (98)
+static const Int_t kProgressPrintLevel = 98;
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the maximum number of allowed opened files minus some wiggle room
 /// for CINT or at least of the standard library (stdio).
@@ -134,7 +219,7 @@ Bool_t TFileMerger::AddFile(const char *url, Bool_t cpProgress)
    TFile *newfile = 0;
    TString localcopy;
 
-   if (fFileList.GetEntries() >= (fMaxOpenedFiles-1)) {
+   if (IsBatchFull()) {
 
       TObjString *urlObj = new TObjString(url);
       fMergeList.Add(urlObj);
@@ -445,6 +530,96 @@ Bool_t WriteCycleInOrder(const TString &name, TIter &nextkey, TIter &peeknextkey
    return WriteOneAndDelete(name, cl, obj, kFALSE, kTRUE, target) && result;
 };
 
+#ifdef R__USE_IMT
+/// Minimum number of source files read by each task of a parallel merge
+constexpr std::size_t kMinFilesPerMergeTask = 4;
+
+/// Return the directory `path` of `source`, reusing it if it was already read. Directories read here are added to
+/// `toDelete`.
+TDirectory *GetSourceDirectory(TFile *source, const char *name, const TString &path,
+                               std::vector<TDirectory *> &toDelete)
+{
+   if (auto dir = dynamic_cast<TDirectory *>(source->GetList()->FindObject(name)))
+      return dir;
+   TDirectory *dir = source->GetDirectory(path);
+   if (dir && dir != source)
+      toDelete.push_back(dir);
+   return dir;
+}
+
+/// Merge into obj the objects called keyname found in the given directory of the source files, using the given
+/// worker threads. Each task reads and merges the objects of a contiguous group of source files, so that each file is
+/// only accessed by one thread; the partial results are then merged into obj.
+void MergeInParallel(ROOT::Internal::RFileMergerWorkers &workers, TObject *obj, TClass *cl, const char *keyname,
+                     const char *dirname, const TString &path, const std::vector<TFile *> &sources,
+                     TFileMergeInfo &info)
+{
+   const auto nTasks = std::min<std::size_t>(workers.GetSize(), sources.size() / kMinFilesPerMergeTask);
+   std::vector<TObject *> partials(nTasks, nullptr);
+   std::vector<std::vector<TDirectory *>> dirsToDelete(nTasks);
+   ROOT::MergeFunc_t func = cl->GetMerge();
+   ROOT::DirAutoAdd_t dirAutoAdd = cl->GetDirectoryAutoAdd();
+
+   auto mergeGroup = [&](unsigned int task) {
+      TFileMergeInfo taskInfo(info.fOutputDirectory);
+      taskInfo.fOptions = info.fOptions;
+      taskInfo.fIOFeatures = info.fIOFeatures;
+      TList inputs;
+      inputs.SetOwner(kTRUE);
+      TObject *&partial = partials[task];
+      for (auto i = sources.size() * task / nTasks; i < sources.size() * (task + 1) / nTasks; ++i) {
+         TDirectory *ndir = GetSourceDirectory(sources[i], dirname, path, dirsToDelete[task]);
+         if (!ndir)
+            continue;
+         TDirectory::TContext ctxt(ndir);
+         TObject *hobj = ndir->GetList()->FindObject(keyname);
+         if (hobj) {
+            // owned by the source directory: work on a copy
+            hobj = hobj->Clone();
+         } else if (auto key = static_cast<TKey *>(ndir->GetListOfKeys()->FindObject(keyname))) {
+            hobj = key->ReadObj();
+            if (!hobj) {
+               ::Info("MergeRecursive", "could not read object for key {%s, %s}; skipping file %s", keyname,
+                      key->GetTitle(), sources[i]->GetName());
+               continue;
+            }
+         } else {
+            continue;
+         }
+         hobj->ResetBit(kMustCleanup);
+         if (dirAutoAdd)
+            dirAutoAdd(hobj, nullptr);
+         if (partial)
+            inputs.Add(hobj);
+         else
+            partial = hobj;
+      }
+      if (partial && !inputs.IsEmpty() && func(partial, &inputs, &taskInfo) < 0)
+         ::Error("MergeRecursive", "calling Merge() on '%s' with the corresponding objects in %d files", keyname,
+                 inputs.GetSize());
+   };
+   workers.Run(nTasks, mergeGroup);
+
+   // As in the sequential merge, the directories read from the source files are not kept beyond this key
+   for (auto &dirs : dirsToDelete) {
+      for (auto dir : dirs) {
+         dir->ResetBit(kMustCleanup);
+         delete dir;
+      }
+   }
+
+   TList inputs;
+   inputs.SetOwner(kTRUE);
+   for (auto partial : partials) {
+      if (partial)
+         inputs.Add(partial);
+   }
+   if (func(obj, &inputs, &info) < 0)
+      ::Error("MergeRecursive", "calling Merge() on '%s' with the partially merged objects", keyname);
+   info.fIsFirst = kFALSE;
+}
+#endif
+
 } // anonymous namespace
 
 Bool_t TFileMerger::MergeOne(TDirectory *target, TList *sourcelist, Int_t type, TFileMergeInfo &info,
@@ -617,9 +792,28 @@ Bool_t TFileMerger::MergeOne(TDirectory *target, TList *sourcelist, Int_t type,
       TList inputs;
       TList todelete;
       Bool_t oneGo = fHistoOneGo && cl->InheritsFrom(R__TH1_Class);
+      if (oneGo && fMemoryBudget > 0 && key) {
+         // Merging in one go keeps the objects of all the input files in memory: if they do not fit in the
+         // budget, accumulate them into the output object one input file at a time instead.
+         const Long64_t nInputs = current_file ? sourcelist->GetSize() - sourcelist->IndexOf(current_file)
+                                               : sourcelist->GetSize();
+         if (nInputs * key->GetObjlen() > fMemoryBudget)
+            oneGo = kFALSE;
+      }
 
       // Loop over all source files and merge same-name object
       TFile *nextsource = current_file ? (TFile*)sourcelist->After( current_file ) : (TFile*)sourcelist->First();
+#ifdef R__USE_IMT
+      // With IMT, histograms from different groups of source files are read and merged concurrently
+      std::vector<TFile *> sources;
+      if (oneGo && fWorkers) {
+         for (auto source = nextsource; source; source = (TFile*)sourcelist->After(source))
+            sources.push_back(source);
+      }
+      if (sources.size() >= 2 * kMinFilesPerMergeTask) {
+         MergeInParallel(*fWorkers, obj, cl, keyname, target->GetName(), path, sources, info);
+      } else
+#endif
       if (nextsource == 0) {
          // There is only one file in the list
          ROOT::MergeFunc_t func = cl->GetMerge();
@@ -964,6 +1158,19 @@ Bool_t TFileMerger::PartialMerge(Int_t in_type)
 
    Bool_t result = kTRUE;
    Int_t type = in_type;
+   const Int_t nTotalFiles = fFileList.GetEntries() + fExcessFiles.GetEntries();
+   Int_t nMergedFiles = 0;
+   Long64_t nMergedBytes = 0;
+   TStopwatch watch;
+#ifdef R__USE_IMT
+   // With IMT, histograms from different groups of source files are merged concurrently by threads that are shared
+   // by all the keys, and started only if there is such a histogram.
+   std::unique_ptr<ROOT::Internal::RFileMergerWorkers> workers;
+   if (fHistoOneGo && ROOT::IsImplicitMTEnabled() && ROOT::GetThreadPoolSize() > 1) {
+      workers = std::make_unique<ROOT::Internal::RFileMergerWorkers>(ROOT::GetThreadPoolSize());
+      fWorkers = workers.get();
+   }
+#endif
    while (result && fFileList.GetEntries()>0) {
       result = MergeRecursive(fOutputFile, &fFileList, type);
 
@@ -971,6 +1178,8 @@ Bool_t TFileMerger::PartialMerge(Int_t in_type)
       TIter next(&fFileList);
       TFile *file;
       while ((file = (TFile*) next())) {
+         ++nMergedFiles;
+         nMergedBytes += file->GetSize();
          // close the files
          if (file->TestBit(kCanDelete)) file->Close();
          // remove the temporary files
@@ -982,6 +1191,12 @@ Bool_t TFileMerger::PartialMerge(Int_t in_type)
          }
       }
       fFileList.Clear();
+      if (fPrintLevel > kProgressPrintLevel) {
+         const Double_t seconds = watch.RealTime();
+         watch.Continue();
+         Printf("%s Merged %d/%d input files (%.1f MB in %.1f s, %.1f MB/s)", fMsgPrefix.Data(), nMergedFiles,
+                nTotalFiles, nMergedBytes / 1e6, seconds, seconds > 0 ? nMergedBytes / 1e6 / seconds : 0.);
+      }
       if (result && fExcessFiles.GetEntries() > 0) {
          // We merge the first set of files in the output,
          // we now need to open the next set and make
@@ -1022,6 +1237,9 @@ Bool_t TFileMerger::PartialMerge(Int_t in_type)
       fOutputFile->ResetBit(kMustCleanup);
       SafeDelete(fOutputFile);
    }
+#ifdef R__USE_IMT
+   fWorkers = nullptr;
+#endif
    return result;
 }
 
@@ -1039,7 +1257,8 @@ Bool_t TFileMerger::OpenExcessFiles()
    TString localcopy;
    // We want gDirectory untouched by anything going on here
    TDirectory::TContext ctxt;
-   while( nfiles < (fMaxOpenedFiles-1) && ( url = (TObjString*)next() ) ) {
+   fBatchMemStart = 0;
+   while( !IsBatchFull() && ( url = (TObjString*)next() ) ) {
       TFile *newfile = 0;
       if (fLocal) {
          TUUID uuid;
@@ -1072,6 +1291,32 @@ Bool_t TFileMerger::OpenExcessFiles()
    return kTRUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return whether no more input files should be opened for the current batch.
+///
+/// This is the case if fMaxOpenedFiles are already open or, with a memory budget, if the files opened
+/// for this batch already take half of it: the other half is left for the objects being merged.
+
+Bool_t TFileMerger::IsBatchFull()
+{
+   const Int_t nfiles = fFileList.GetEntries();
+   if (nfiles >= (fMaxOpenedFiles-1))
+      return kTRUE;
+   if (fMemoryBudget <= 0)
+      return kFALSE;
+
+   ProcInfo_t procInfo;
+   gSystem->GetProcInfo(&procInfo);
+   if (nfiles == 0 || fBatchMemStart == 0) {
+      fBatchMemStart = procInfo.fMemResident;
+      return kFALSE;
+   }
+   // Always open at least two files, so that the merge makes progress
+   const Long64_t used = 1024LL * (procInfo.fMemResident - fBatchMemStart);
+   const Long64_t perFile = used / nfiles;
+   return nfiles >= 2 && used + perFile > fMemoryBudget / 2;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Intercept the case where the output TFile is deleted!
 
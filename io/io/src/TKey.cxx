@@ -224,6 +224,20 @@ TKey::TKey(const TString &name, const TString &title, const TClass *cl, Int_t nb
 ///  by the regular expression parser (see TRegexp).
 
 TKey::TKey(const TObject *obj, const char *name, Int_t bufsize, TDirectory* motherDir)
+     : TKey(obj, name, motherDir)
+{
+   CreateStreamed(obj, bufsize, StreamObject(obj, bufsize));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create a TKey object for a TObject* without streaming the object.
+///
+/// The key is added to the list of keys of motherDir. The object must then be
+/// streamed with StreamObject() and the key allocated on file with
+/// CreateStreamed(). StreamObject() does not access the file, so that
+/// TDirectoryFile::WriteTObjects() can stream several keys concurrently.
+
+TKey::TKey(const TObject *obj, const char *name, TDirectory* motherDir)
      : TNamed(name, obj->GetTitle())
 {
    R__ASSERT(obj);
@@ -237,11 +251,22 @@ TKey::TKey(const TObject *obj, const char *name, Int_t bufsize, TDirectory* moth
    }
 
    Build(motherDir, obj->ClassName(), -1);
+   fCycle     = fMotherDir->AppendKey(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Stream the key and the object obj, and compress the object if the file
+/// is compressed.
+///
+/// Returns the number of bytes of the object in the key, i.e. after
+/// compression. The key header is streamed again by CreateStreamed(), once
+/// the key is allocated on file.
 
+Int_t TKey::StreamObject(const TObject *obj, Int_t bufsize)
+{
    Int_t lbuf, nout, noutot, bufmax, nzip;
    fBufferRef = new TBufferFile(TBuffer::kWrite, bufsize);
    fBufferRef->SetParent(GetFile());
-   fCycle     = fMotherDir->AppendKey(this);
 
    Streamer(*fBufferRef);         //write key itself
    fKeylen    = fBufferRef->Length();
@@ -265,27 +290,45 @@ TKey::TKey(const TObject *obj, const char *name, Int_t bufsize, TDirectory* moth
          else               bufmax = kMAXZIPBUF;
          R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
          if (nout == 0 || nout >= fObjlen) { //this happens when the buffer cannot be compressed
+            delete [] fBuffer;
             fBuffer = fBufferRef->Buffer();
-            Create(fObjlen);
-            fBufferRef->SetBufferOffset(0);
-            Streamer(*fBufferRef);         //write key itself again
-            return;
+            return fObjlen;
          }
          bufcur += nout;
          noutot += nout;
          objbuf += kMAXZIPBUF;
          nzip   += kMAXZIPBUF;
       }
-      Create(noutot);
-      fBufferRef->SetBufferOffset(0);
-      Streamer(*fBufferRef);         //write key itself again
-      memcpy(fBuffer,fBufferRef->Buffer(),fKeylen);
+      // The key header is streamed again in its own buffer by CreateStreamed()
       delete fBufferRef; fBufferRef = 0;
-   } else {
-      fBuffer = fBufferRef->Buffer();
-      Create(fObjlen);
+      return noutot;
+   }
+   fBuffer = fBufferRef->Buffer();
+   return fObjlen;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Allocate on file the key of obj, streamed by StreamObject() into nbytes
+/// bytes, and stream the key header again.
+
+void TKey::CreateStreamed(const TObject *obj, Int_t bufsize, Int_t nbytes)
+{
+   // The file may have grown beyond TFile::kStartBigFile since the key was
+   // built: the key then needs the large header, which shifts the object.
+   if (fVersion <= 1000 && GetFile() && GetFile()->GetEND() > TFile::kStartBigFile) {
+      DeleteBuffer();
+      fVersion += 1000;
+      nbytes = StreamObject(obj, bufsize);
+   }
+
+   Create(nbytes);
+   if (fBufferRef) {
       fBufferRef->SetBufferOffset(0);
       Streamer(*fBufferRef);         //write key itself again
+   } else {
+      TBufferFile header(TBuffer::kWrite, fKeylen);
+      Streamer(header);              //write key itself again
+      memcpy(fBuffer,header.Buffer(),fKeylen);
    }
 }
 
@@ -524,7 +567,12 @@ void TKey::Create(Int_t nbytes, TFile* externFile)
 
 TKey::~TKey()
 {
-   if (fMotherDir && fMotherDir->GetListOfKeys())
+   // Bypass GetListOfKeys() for TDirectoryFile: it would read all the keys of
+   // a directory whose keys are otherwise read on demand.
+   if (auto dirFile = dynamic_cast<TDirectoryFile *>(fMotherDir)) {
+      if (dirFile->fKeys)
+         dirFile->fKeys->Remove(this);
+   } else if (fMotherDir && fMotherDir->GetListOfKeys())
       fMotherDir->GetListOfKeys()->Remove(this);
    TKey::DeleteBuffer();
 }
@@ -777,16 +825,15 @@ TObject *TKey::ReadObj()
    bufferRef.SetPidOffset(fPidOffset);
 
    std::unique_ptr<char []> compressedBuffer;
+   const char *compressed = nullptr;
    auto storeBuffer = fBuffer;
    if (fObjlen > fNbytes-fKeylen) {
-      compressedBuffer.reset(new char[fNbytes]);
-      fBuffer = compressedBuffer.get();
-      if( !ReadFile() )                    //Read object structure from file
-      {
+      compressed = ReadCompressedBuffer(compressedBuffer);
+      if (!compressed) {
         fBuffer = 0;
         return 0;
       }
-      memcpy(bufferRef.Buffer(),fBuffer,fKeylen);
+      memcpy(bufferRef.Buffer(),compressed,fKeylen);
    } else {
       fBuffer = bufferRef.Buffer();
       if( !ReadFile() ) {                   //Read object structure from file
@@ -824,7 +871,7 @@ TObject *TKey::ReadObj()
 
    if (fObjlen > fNbytes-fKeylen) {
       char *objbuf = bufferRef.Buffer() + fKeylen;
-      UChar_t *bufcur = (UChar_t *)&compressedBuffer[fKeylen];
+      UChar_t *bufcur = (UChar_t *)&compressed[fKeylen];
       Int_t nin, nout = 0, nbuf;
       Int_t noutot = 0;
       while (1) {
@@ -1032,12 +1079,13 @@ void *TKey::ReadObjectAny(const TClass* expectedClass)
    bufferRef.SetPidOffset(fPidOffset);
 
    std::unique_ptr<char []> compressedBuffer;
+   const char *compressed = nullptr;
    auto storeBuffer = fBuffer;
    if (fObjlen > fNbytes-fKeylen) {
-      compressedBuffer.reset(new char[fNbytes]);
-      fBuffer = compressedBuffer.get();
-      ReadFile();                    //Read object structure from file
-      memcpy(bufferRef.Buffer(),fBuffer,fKeylen);
+      compressed = ReadCompressedBuffer(compressedBuffer);
+      if (!compressed)
+         return 0;
+      memcpy(bufferRef.Buffer(),compressed,fKeylen);
    } else {
       fBuffer = bufferRef.Buffer();
       ReadFile();                    //Read object structure from file
@@ -1093,7 +1141,7 @@ void *TKey::ReadObjectAny(const TClass* expectedClass)
 
    if (fObjlen > fNbytes-fKeylen) {
       char *objbuf = bufferRef.Buffer() + fKeylen;
-      UChar_t *bufcur = (UChar_t *)&compressedBuffer[fKeylen];
+      UChar_t *bufcur = (UChar_t *)&compressed[fKeylen];
       Int_t nin, nout = 0, nbuf;
       Int_t noutot = 0;
       while (1) {
@@ -1166,12 +1214,13 @@ Int_t TKey::Read(TObject *obj)
       bufferRef.MapObject(obj);  //register obj in map to handle self reference
 
    std::unique_ptr<char []> compressedBuffer;
+   const char *compressed = nullptr;
    auto storeBuffer = fBuffer;
    if (fObjlen > fNbytes-fKeylen) {
-      compressedBuffer.reset(new char[fNbytes]);
-      fBuffer = compressedBuffer.get();
-      ReadFile();                    //Read object structure from file
-      memcpy(bufferRef.Buffer(),fBuffer,fKeylen);
+      compressed = ReadCompressedBuffer(compressedBuffer);
+      if (!compressed)
+         return 0;
+      memcpy(bufferRef.Buffer(),compressed,fKeylen);
    } else {
       fBuffer = bufferRef.Buffer();
       ReadFile();                    //Read object structure from file
@@ -1181,7 +1230,7 @@ Int_t TKey::Read(TObject *obj)
    bufferRef.SetBufferOffset(fKeylen);
    if (fObjlen > fNbytes-fKeylen) {
       char *objbuf = bufferRef.Buffer() + fKeylen;
-      UChar_t *bufcur = (UChar_t *)&compressedBuffer[fKeylen];
+      UChar_t *bufcur = (UChar_t *)&compressed[fKeylen];
       Int_t nin, nout = 0, nbuf;
       Int_t noutot = 0;
       while (1) {
@@ -1267,6 +1316,29 @@ void TKey::ReadKeyBuffer(char *&buffer)
    fTitle.ReadBuffer(buffer);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the key and the compressed object read from the file.
+///
+/// For memory mapped files (see TFile::SetMemoryMapped()) this points into
+/// the mapping, so that the object is decompressed without copying it;
+/// otherwise the data is read into compressedBuffer.
+/// Returns nullptr in case of failure.
+
+const char *TKey::ReadCompressedBuffer(std::unique_ptr<char []> &compressedBuffer)
+{
+   TFile *f = GetFile();
+   if (!f) return nullptr;
+   if (const char *mapped = f->GetMappedBuffer(fSeekKey, fNbytes))
+      return mapped;
+
+   compressedBuffer.reset(new char[fNbytes]);
+   auto storeBuffer = fBuffer;
+   fBuffer = compressedBuffer.get();
+   Bool_t ok = ReadFile();               //Read object structure from file
+   fBuffer = storeBuffer;
+   return ok ? compressedBuffer.get() : nullptr;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read the key structure from the file
 
@@ -25,6 +25,8 @@
 #include "TProcessID.h"
 #include "TFile.h"
 
+#include <algorithm>
+
 static const Int_t kRegrouped = TStreamerInfo::kOffsetL;
 
 // More possible optimizations:
@@ -1694,6 +1696,37 @@ namespace TStreamerInfoActions
       return 0;
    }
 
+   /// Number of values read at once by ReadMemberWise.
+   constexpr Int_t kMemberWiseChunkSize = 256;
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Read the `n` consecutive values that a member-wise streamed collection holds, on file, for one data member
+   /// of fundamental type, and store them (converted from `From` to `To`) at `addr(0)`, ..., `addr(n-1)`.
+   ///
+   /// With a TBufferFile the values are unpacked in chunks by a single ReadFastArray call each, in a tight loop
+   /// that the compiler can vectorize, rather than through one virtual call per value; the chunk is then
+   /// scattered to the elements of the collection. Other buffers read the values one by one.
+
+   template <typename From, typename To, typename AddressOf>
+   inline void ReadMemberWise(TBuffer &buf, Long_t n, AddressOf addr)
+   {
+      if (!dynamic_cast<TBufferFile *>(&buf)) {
+         From temp;
+         for (Long_t i = 0; i < n; ++i) {
+            buf >> temp;
+            *addr(i) = (To)temp;
+         }
+         return;
+      }
+      From chunk[kMemberWiseChunkSize];
+      for (Long_t first = 0; first < n; first += kMemberWiseChunkSize) {
+         const Int_t size = (Int_t)std::min<Long_t>(kMemberWiseChunkSize, n - first);
+         buf.ReadFastArray(chunk, size);
+         for (Int_t i = 0; i < size; ++i)
+            *addr(first + i) = (To)chunk[i];
+      }
+   }
+
    enum ESelectLooper { kVectorLooper, kVectorPtrLooper, kAssociativeLooper, kGenericLooper };
 
    ESelectLooper SelectLooper(TVirtualCollectionProxy &proxy)
@@ -1721,13 +1754,15 @@ namespace TStreamerInfoActions
       template <typename T>
       static INLINE_TEMPLATE_ARGS Int_t ReadBasicType(TBuffer &buf, void *iter, const void *end, const TLoopConfiguration *loopconfig, const TConfiguration *config)
       {
-         const Int_t incr = ((TVectorLoopConfig*)loopconfig)->fIncrement;
-         iter = (char*)iter + config->fOffset;
-         end = (char*)end + config->fOffset;
-         for(; iter != end; iter = (char*)iter + incr ) {
-            T *x = (T*) ((char*) iter);
-            buf >> *x;
+         const Long_t incr = ((TVectorLoopConfig*)loopconfig)->fIncrement;
+         const Long_t n = (((char*)end)-((char*)iter))/incr;
+         char *first = (char*)iter + config->fOffset;
+         if (incr == sizeof(T) && dynamic_cast<TBufferFile*>(&buf)) {
+            // The values are contiguous in memory as they are on file.
+            buf.ReadFastArray((T*)first, (Int_t)n);
+            return 0;
          }
+         ReadMemberWise<T, T>(buf, n, [first, incr](Long_t i) { return (T*)(first + i * incr); });
          return 0;
       }
 
@@ -1736,14 +1771,10 @@ namespace TStreamerInfoActions
          static INLINE_TEMPLATE_ARGS Int_t Action(TBuffer &buf, void *iter, const void *end, const TLoopConfiguration *loopconfig, const TConfiguration *config)
          {
             // Simple conversion from a 'From' on disk to a 'To' in memory.
-            From temp;
-            const Int_t incr = ((TVectorLoopConfig*)loopconfig)->fIncrement;
-            iter = (char*)iter + config->fOffset;
-            end = (char*)end + config->fOffset;
-            for(; iter != end; iter = (char*)iter + incr ) {
-               buf >> temp;
-               *(To*)( ((char*)iter) ) = (To)temp;
-            }
+            const Long_t incr = ((TVectorLoopConfig*)loopconfig)->fIncrement;
+            const Long_t n = (((char*)end)-((char*)iter))/incr;
+            char *first = (char*)iter + config->fOffset;
+            ReadMemberWise<From, To>(buf, n, [first, incr](Long_t i) { return (To*)(first + i * incr); });
             return 0;
          }
       };
@@ -2098,11 +2129,9 @@ namespace TStreamerInfoActions
       static INLINE_TEMPLATE_ARGS Int_t ReadBasicType(TBuffer &buf, void *iter, const void *end, const TConfiguration *config)
       {
          const Int_t offset = config->fOffset;
-
-         for(; iter != end; iter = (char*)iter + sizeof(void*) ) {
-            T *x = (T*)( ((char*) (*(void**)iter) ) + offset );
-            buf >> *x;
-         }
+         char **objects = (char**)iter;
+         const Long_t n = ((char**)end) - objects;
+         ReadMemberWise<T, T>(buf, n, [objects, offset](Long_t i) { return (T*)(objects[i] + offset); });
          return 0;
       }
 
@@ -2111,13 +2140,10 @@ namespace TStreamerInfoActions
          static INLINE_TEMPLATE_ARGS Int_t Action(TBuffer &buf, void *iter, const void *end, const TConfiguration *config)
          {
             // Simple conversion from a 'From' on disk to a 'To' in memory.
-            From temp;
             const Int_t offset = config->fOffset;
-            for(; iter != end; iter = (char*)iter + sizeof(void*) ) {
-               buf >> temp;
-               To *x = (To*)( ((char*) (*(void**)iter) ) + offset );
-               *x = (To)temp;
-            }
+            char **objects = (char**)iter;
+            const Long_t n = ((char**)end) - objects;
+            ReadMemberWise<From, To>(buf, n, [objects, offset](Long_t i) { return (To*)(objects[i] + offset); });
             return 0;
          }
       };
@@ -2,6 +2,9 @@
 
 #include "TBufferFile.h"
 #include "TClass.h"
+#include "TClonesArray.h"
+#include "TParameter.h"
+#include <memory>
 #include <vector>
 #include <iostream>
 
@@ -26,3 +29,27 @@ TEST(TBufferFile, ROOT_8367)
    EXPECT_FLOAT_EQ(v2[6], 7.);
    EXPECT_EQ(v2.size(), 7);
 }
+
+// The members of split TClonesArray elements are read member-wise, in chunks
+TEST(TBufferFile, ReadClonesMemberWise)
+{
+   // more elements than values read per chunk, and not a multiple of it
+   const int n = 1000;
+   TClonesArray arr("TParameter<Double_t>", n);
+   for (int i = 0; i < n; ++i)
+      new (arr[i]) TParameter<Double_t>("p", 0.5 * i);
+
+   TBufferFile buf(TBuffer::kWrite);
+   buf.WriteObject(&arr);
+   buf.SetReadMode();
+   buf.Reset();
+   std::unique_ptr<TClonesArray> read(static_cast<TClonesArray *>(buf.ReadObject(TClonesArray::Class())));
+
+   ASSERT_TRUE(read != nullptr);
+   ASSERT_EQ(n, read->GetEntriesFast());
+   for (int i = 0; i < n; ++i) {
+      auto p = static_cast<TParameter<Double_t> *>(read->UncheckedAt(i));
+      EXPECT_STREQ("p", p->GetName());
+      EXPECT_DOUBLE_EQ(0.5 * i, p->GetVal());
+   }
+}
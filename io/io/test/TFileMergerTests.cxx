@@ -2,9 +2,15 @@
 
 #include "TFileMerger.h"
 
+#include "TH1D.h"
 #include "TMemFile.h"
+#include "TROOT.h"
 #include "TTree.h"
 
+#include <memory>
+#include <string>
+#include <vector>
+
 static void CreateATuple(TMemFile &file, const char *name, double value)
 {
    auto mytree = new TTree(name, "A tree");
@@ -68,3 +74,81 @@ TEST(TFileMerger, CreateWithUnwritableTFilePointer)
    ROOT_EXPECT_ERROR(merger.OutputFile(std::move(output)), "TFileMerger::OutputFile",
                      "output file output.root is not writable");
 }
+
+TEST(TFileMerger, MergeHistogramsMemoryBudget)
+{
+   const int nFiles = 10;
+   std::vector<std::unique_ptr<TMemFile>> files;
+   for (int i = 0; i < nFiles; ++i) {
+      files.emplace_back(new TMemFile(("budget_input" + std::to_string(i) + ".root").c_str(), "RECREATE"));
+      TH1D h("h", "h", 10, 0, 10);
+      h.SetDirectory(nullptr);
+      h.Fill(i);
+      files.back()->WriteObject(&h, "h");
+   }
+
+   TFileMerger merger;
+   // a budget smaller than a single histogram: the inputs are accumulated one at a time
+   merger.SetMemoryBudget(1);
+   EXPECT_EQ(1, merger.GetMemoryBudget());
+   ASSERT_TRUE(merger.OutputFile(std::unique_ptr<TMemFile>(new TMemFile("budget_output.root", "CREATE"))));
+   for (auto &f : files)
+      merger.AddFile(f.get(), false);
+   ASSERT_TRUE(merger.PartialMerge());
+
+   auto h = merger.GetOutputFile()->Get<TH1D>("h");
+   ASSERT_TRUE(h != nullptr);
+   EXPECT_EQ(nFiles, h->GetEntries());
+   for (int i = 0; i < nFiles; ++i)
+      EXPECT_EQ(1, h->GetBinContent(i + 1));
+}
+
+#ifdef R__USE_IMT
+TEST(TFileMerger, MergeHistogramsMT)
+{
+   ROOT::EnableImplicitMT(4);
+
+   // enough files for the histograms to be merged by several threads
+   const int nFiles = 20;
+   std::vector<std::unique_ptr<TMemFile>> files;
+   for (int i = 0; i < nFiles; ++i) {
+      files.emplace_back(new TMemFile(("mt_input" + std::to_string(i) + ".root").c_str(), "RECREATE"));
+      TH1D h("h", "h", 10, 0, 10);
+      h.SetDirectory(nullptr);
+      for (int j = 0; j <= i; ++j)
+         h.Fill(j % 10);
+      files.back()->WriteObject(&h, "h");
+      // more keys, also in a subdirectory, are merged by the same worker threads
+      TDirectory *sub = files.back()->mkdir("sub");
+      for (TDirectory *dir : {static_cast<TDirectory *>(files.back().get()), sub}) {
+         TH1D other("other", "other", 5, 0, 5);
+         other.SetDirectory(nullptr);
+         other.Fill(i % 5);
+         dir->WriteObject(&other, dir == sub ? "h3" : "h2");
+         dir->WriteObject(&other, dir == sub ? "h4" : "h5");
+      }
+   }
+
+   TFileMerger merger;
+   ASSERT_TRUE(merger.OutputFile(std::unique_ptr<TMemFile>(new TMemFile("mt_output.root", "CREATE"))));
+   for (auto &f : files)
+      merger.AddFile(f.get(), false);
+   merger.PartialMerge();
+
+   auto h = merger.GetOutputFile()->Get<TH1D>("h");
+   ASSERT_TRUE(h != nullptr);
+   EXPECT_EQ(nFiles * (nFiles + 1) / 2, h->GetEntries());
+   EXPECT_EQ(nFiles * (nFiles + 1) / 2, h->Integral());
+   // the first bin gets one entry from each file, and a second one from the files with more than 10 entries
+   EXPECT_EQ(nFiles + (nFiles - 10), h->GetBinContent(1));
+
+   for (const char *name : {"h2", "h5", "sub/h3", "sub/h4"}) {
+      auto other = merger.GetOutputFile()->Get<TH1D>(name);
+      ASSERT_TRUE(other != nullptr) << name;
+      EXPECT_EQ(nFiles, other->GetEntries()) << name;
+      EXPECT_EQ(nFiles / 5, other->GetBinContent(1)) << name;
+   }
+
+   ROOT::DisableImplicitMT();
+}
+#endif
@@ -1,15 +1,24 @@
+#include <cstring>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "gtest/gtest.h"
 
+#include "ROOT/TestSupport.hxx"
+#include "TEnv.h"
 #include "TFile.h"
 #include "TKey.h"
+#include "TList.h"
 #include "TNamed.h"
 #include "TPluginManager.h"
 #include "TROOT.h" // gROOT
 #include "TSystem.h"
 
+#ifndef R__WIN32
+#include <unistd.h> // truncate
+#endif
+
 TEST(TFile, WriteObjectTObject)
 {
     auto filename{"tfile_writeobject_tobject.root"};
@@ -89,6 +98,290 @@ TEST(TFile, ReadFromSameFile)
    EXPECT_TRUE(o1 != o2) << "Same objects read from two different files have the same pointer!";
 }
 
+namespace {
+
+/// Title of the i-th object written by WriteObjects: empty or too short to be compressed for some objects,
+/// compressed for the others
+std::string ObjectTitle(int i)
+{
+   return std::string(10 * (i % 100), 'a' + i % 26);
+}
+
+/// The n objects "obj0", "obj1", ... written by WriteObjects
+std::vector<std::unique_ptr<TNamed>> MakeObjects(int n)
+{
+   std::vector<std::unique_ptr<TNamed>> objects;
+   for (int i = 0; i < n; ++i)
+      objects.emplace_back(new TNamed(("obj" + std::to_string(i)).c_str(), ObjectTitle(i).c_str()));
+   return objects;
+}
+
+/// Write the n objects of MakeObjects in dir, one key each
+void WriteObjects(TDirectory &dir, int n)
+{
+   for (auto &named : MakeObjects(n))
+      dir.WriteObject(named.get(), named->GetName());
+}
+
+/// Check that the n objects of MakeObjects are read back from dir
+void CheckObjects(TDirectory &dir, int n)
+{
+   for (int i = 0; i < n; ++i) {
+      auto named = std::unique_ptr<TNamed>(dir.Get<TNamed>(("obj" + std::to_string(i)).c_str()));
+      ASSERT_TRUE(named != nullptr) << "obj" << i;
+      EXPECT_EQ(ObjectTitle(i), named->GetTitle());
+   }
+}
+
+/// Set an integer gEnv value for the lifetime of the object
+class EnvValueRAII {
+   std::string fName;
+   Int_t fOldValue;
+
+public:
+   EnvValueRAII(const char *name, Int_t value) : fName(name), fOldValue(gEnv->GetValue(name, 0))
+   {
+      gEnv->SetValue(name, value);
+   }
+   ~EnvValueRAII() { gEnv->SetValue(fName.c_str(), fOldValue); }
+};
+
+} // anonymous namespace
+
+TEST(TFile, AsyncWrite)
+{
+   const auto filename = "tfile_asyncwrite.root";
+   const int nObjects = 500;
+   {
+      TFile f(filename, "RECREATE");
+      // a small queue, so that writing has to wait for the writer thread
+      ASSERT_TRUE(f.SetAsyncWrite(4096));
+      EXPECT_TRUE(f.IsAsyncWrite());
+      WriteObjects(f, nObjects);
+      // read back from the file while buffers may still be queued
+      auto last = std::unique_ptr<TNamed>(f.Get<TNamed>(("obj" + std::to_string(nObjects - 1)).c_str()));
+      ASSERT_TRUE(last != nullptr);
+      EXPECT_EQ(ObjectTitle(nObjects - 1), last->GetTitle());
+
+      // once flushed, the queue is drained: all the keys are on disk
+      f.Flush();
+      const TKey *lastKey = f.GetKey(last->GetName());
+      ASSERT_TRUE(lastKey != nullptr);
+      FileStat_t stat;
+      ASSERT_EQ(0, gSystem->GetPathInfo(filename, stat));
+      EXPECT_GE(stat.fSize, lastKey->GetSeekKey() + lastKey->GetNbytes());
+
+      // reading stops the asynchronous writing, which resumes with the same queue size for updating
+      EXPECT_EQ(0, f.ReOpen("READ"));
+      EXPECT_FALSE(f.IsAsyncWrite());
+      EXPECT_EQ(0, f.ReOpen("UPDATE"));
+      EXPECT_TRUE(f.IsAsyncWrite());
+      TNamed added("added", "after ReOpen");
+      f.WriteObject(&added, added.GetName());
+      f.Close();
+      EXPECT_FALSE(f.IsAsyncWrite());
+   }
+
+   TFile input(filename);
+   ASSERT_FALSE(input.IsZombie());
+   EXPECT_FALSE(input.TestBit(TFile::kRecovered));
+   EXPECT_EQ(nObjects + 1, input.GetListOfKeys()->GetSize());
+   CheckObjects(input, nObjects);
+   auto added = std::unique_ptr<TNamed>(input.Get<TNamed>("added"));
+   ASSERT_TRUE(added != nullptr);
+   EXPECT_STREQ("after ReOpen", added->GetTitle());
+   input.Close();
+   gSystem->Unlink(filename);
+}
+
+TEST(TFile, KeyIndex)
+{
+   const auto filename = "tfile_keyindex.root";
+   const auto filenameNoIndex = "tfile_nokeyindex.root";
+   const int nObjects = 1000;
+   for (auto name : {filename, filenameNoIndex}) {
+      EnvValueRAII minKeys("TFile.KeyIndexMinKeys", name == filename ? 100 : 0);
+      TFile f(name, "RECREATE");
+      auto dir = f.mkdir("dir");
+      WriteObjects(f, nObjects);
+      TNamed second("obj7", "second cycle");
+      f.WriteObject(&second, second.GetName());
+      TNamed sub("sub", "in dir");
+      dir->WriteObject(&sub, sub.GetName());
+      f.Close();
+   }
+
+   // without the index, opening the file reads all the keys
+   Long64_t bytesReadNoIndex = 0;
+   {
+      TFile input(filenameNoIndex);
+      ASSERT_FALSE(input.IsZombie());
+      bytesReadNoIndex = input.GetBytesRead();
+   }
+
+   TFile input(filename);
+   ASSERT_FALSE(input.IsZombie());
+   // the keys of the top directory are read on demand, through the index
+   EXPECT_EQ(nObjects + 2, input.GetNkeys());
+   auto named = std::unique_ptr<TNamed>(input.Get<TNamed>("obj42"));
+   ASSERT_TRUE(named != nullptr);
+   EXPECT_EQ(ObjectTitle(42), named->GetTitle());
+   EXPECT_LT(input.GetBytesRead(), bytesReadNoIndex / 2);
+   named.reset(input.Get<TNamed>("obj7"));
+   ASSERT_TRUE(named != nullptr);
+   EXPECT_STREQ("second cycle", named->GetTitle());
+   named.reset(input.Get<TNamed>("obj7;1"));
+   ASSERT_TRUE(named != nullptr);
+   EXPECT_EQ(ObjectTitle(7), named->GetTitle());
+   EXPECT_EQ(nullptr, input.GetKey("missing"));
+   named.reset(input.Get<TNamed>("dir/sub"));
+   ASSERT_TRUE(named != nullptr);
+   EXPECT_STREQ("in dir", named->GetTitle());
+
+   // listing the keys reads all of them, keeping those already read
+   auto key = input.GetKey("obj42");
+   ASSERT_TRUE(key != nullptr);
+   EXPECT_EQ(nObjects + 2, input.GetListOfKeys()->GetSize());
+   EXPECT_EQ(key, input.GetKey("obj42"));
+   EXPECT_EQ(key, input.GetListOfKeys()->FindObject("obj42"));
+   input.Close();
+   gSystem->Unlink(filename);
+   gSystem->Unlink(filenameNoIndex);
+}
+
+#ifdef R__USE_IMT
+TEST(TFile, WriteTObjectsMT)
+{
+   ROOT::EnableImplicitMT(4);
+
+   const auto filename = "tfile_writetobjects.root";
+   const int nObjects = 300;
+   auto objects = MakeObjects(nObjects);
+   TList list;
+   for (auto &named : objects)
+      list.Add(named.get());
+   {
+      TFile f(filename, "RECREATE");
+      EXPECT_LT(0, f.WriteTObjects(&list));
+      // the objects streamed in parallel are written one after the other, in the order of the list
+      Long64_t previousSeek = 0;
+      for (auto &named : objects) {
+         auto key = f.GetKey(named->GetName());
+         ASSERT_TRUE(key != nullptr);
+         EXPECT_LT(previousSeek, key->GetSeekKey());
+         previousSeek = key->GetSeekKey();
+      }
+      // a second cycle for each object, and replacing it within the batch
+      TNamed replaced("obj0", "replaced");
+      list.Add(&replaced);
+      EXPECT_LT(0, f.WriteTObjects(&list, "overwrite"));
+      list.Remove(&replaced);
+      f.Close();
+   }
+
+   TFile input(filename);
+   ASSERT_FALSE(input.IsZombie());
+   EXPECT_EQ(nObjects, input.GetListOfKeys()->GetSize());
+   for (auto &named : objects) {
+      auto key = input.GetKey(named->GetName());
+      ASSERT_TRUE(key != nullptr);
+      EXPECT_EQ(1, key->GetCycle());
+   }
+   auto replaced = std::unique_ptr<TNamed>(input.Get<TNamed>("obj0"));
+   ASSERT_TRUE(replaced != nullptr);
+   EXPECT_STREQ("replaced", replaced->GetTitle());
+   for (int i = 1; i < nObjects; ++i) {
+      auto named = std::unique_ptr<TNamed>(input.Get<TNamed>(("obj" + std::to_string(i)).c_str()));
+      ASSERT_TRUE(named != nullptr);
+      EXPECT_EQ(ObjectTitle(i), named->GetTitle());
+   }
+   input.Close();
+   gSystem->Unlink(filename);
+
+   ROOT::DisableImplicitMT();
+}
+#endif
+
+TEST(TFile, MemoryMapped)
+{
+   const auto filename = "tfile_mmap.root";
+   const int nObjects = 100;
+   {
+      TFile f(filename, "RECREATE");
+      {
+         ROOT::TestSupport::CheckDiagsRAII diags;
+         diags.requiredDiag(kError, "TFile::SetMemoryMapped", "is not open for reading only", false);
+         EXPECT_FALSE(f.SetMemoryMapped());
+      }
+      EXPECT_FALSE(f.IsMemoryMapped());
+      WriteObjects(f, nObjects);
+      f.Close();
+   }
+
+   TFile input((std::string(filename) + "?mmap").c_str());
+   ASSERT_FALSE(input.IsZombie());
+   ASSERT_TRUE(input.IsMemoryMapped());
+   EXPECT_EQ(nObjects, input.GetListOfKeys()->GetSize());
+
+   // the keys are read directly from the mapping
+   const TKey *key = input.GetKey("obj50");
+   ASSERT_TRUE(key != nullptr);
+   const Long64_t pos = key->GetSeekKey();
+   const char *mapping = input.GetMappedBuffer(pos, key->GetNbytes());
+   ASSERT_TRUE(mapping != nullptr);
+   const Long64_t bytesRead = input.GetBytesRead();
+   CheckObjects(input, nObjects);
+   EXPECT_LT(bytesRead, input.GetBytesRead());
+
+   // reading the same bytes with and without the mapping
+   char mapped[64], unmapped[64];
+   ASSERT_FALSE(input.ReadBuffer(mapped, pos, sizeof(mapped)));
+   EXPECT_EQ(0, memcmp(mapping, mapped, sizeof(mapped)));
+   EXPECT_TRUE(input.SetMemoryMapped(kFALSE));
+   EXPECT_FALSE(input.IsMemoryMapped());
+   EXPECT_EQ(nullptr, input.GetMappedBuffer(pos, sizeof(mapped)));
+   ASSERT_FALSE(input.ReadBuffer(unmapped, pos, sizeof(unmapped)));
+   EXPECT_EQ(0, memcmp(mapped, unmapped, sizeof(mapped)));
+   input.Close();
+   gSystem->Unlink(filename);
+}
+
+#ifndef R__WIN32
+// a file truncated while it is mapped gives read errors instead of SIGBUS
+TEST(TFile, MemoryMappedTruncated)
+{
+   const auto filename = "tfile_mmap_truncated.root";
+   {
+      TFile f(filename, "RECREATE");
+      WriteObjects(f, 100);
+      f.Close();
+   }
+
+   TFile input((std::string(filename) + "?mmap").c_str());
+   ASSERT_FALSE(input.IsZombie());
+   ASSERT_TRUE(input.IsMemoryMapped());
+   const TKey *first = input.GetKey("obj1");
+   const TKey *last = input.GetKey("obj99");
+   ASSERT_TRUE(first != nullptr && last != nullptr);
+   const Long64_t newSize = last->GetSeekKey();
+   ASSERT_EQ(0, truncate(filename, newSize));
+
+   std::vector<char> buf(last->GetNbytes());
+   {
+      ROOT::TestSupport::CheckDiagsRAII diags;
+      diags.requiredDiag(kWarning, "TFile::IsInMapping", "was truncated", false);
+      diags.requiredDiag(kError, "TFile::ReadBuffer", "error reading all requested bytes", false);
+      EXPECT_EQ(nullptr, input.GetMappedBuffer(last->GetSeekKey(), last->GetNbytes()));
+      EXPECT_TRUE(input.ReadBuffer(buf.data(), last->GetSeekKey(), last->GetNbytes()));
+   }
+   // the data before the new end of the file is still read from the mapping
+   EXPECT_NE(nullptr, input.GetMappedBuffer(first->GetSeekKey(), first->GetNbytes()));
+   EXPECT_FALSE(input.ReadBuffer(buf.data(), first->GetSeekKey(), first->GetNbytes()));
+   input.Close();
+   gSystem->Unlink(filename);
+}
+#endif
+
 TEST(TFile, ReadWithoutGlobalRegistrationLocal)
 {
    const auto localFile = "TFileTestReadWithoutGlobalRegistrationLocal.root";
@@ -37,10 +37,15 @@ def get_argparse():
     parser.add_argument("-O", help="Re-optimize basket size when merging TTree", action = 'store_true')
     parser.add_argument("-T", help="Do not merge Trees", action = 'store_true')
     parser.add_argument("-v", help=textwrap.fill(
-        "Explicitly set the verbosity level: 0 request no output, 99 is the default"))
+        "Explicitly set the verbosity level: 0 request no output, 99 is the default, "
+        "100 also reports the progress of the merge"))
     parser.add_argument("-j", help=textwrap.fill(
         "Parallelize the execution in 'J' processes. If the number of "
         "processes is not specified, use the system maximum."))
+    parser.add_argument("-t", help=textwrap.fill(
+        "Merge histograms in parallel within this process using 'T' threads. "
+        "If the number of threads is not specified, use the system maximum, "
+        "shared by the processes of -j."))
     parser.add_argument("-dbg", help=textwrap.fill(
         "Enable verbosity. If -j was specified, do not not delete partial files "
         "stored inside working directory."), action = 'store_true')
@@ -48,6 +53,9 @@ def get_argparse():
         "Carry out the partial multiprocess execution in the specified directory"))
     parser.add_argument("-n", help=textwrap.fill(
         "Open at most 'N' files at once (use 0 to request to use the system maximum)"))
+    parser.add_argument("-memory", help=textwrap.fill(
+        "Keep the memory used by the merge within the given size: the number of "
+        "input files opened at once is then chosen automatically"))
     parser.add_argument("-cachesize", help=textwrap.fill(
         "Resize the prefetching cache use to speed up I/O operations (use 0 to disable)"))
     parser.add_argument("-experimental-io-features", help=textwrap.fill(
@@ -26,11 +26,16 @@
   \param -k   Skip corrupt or non-existent files, do not exit
   \param -O   Re-optimize basket size when merging TTree
   \param -T   Do not merge Trees
-  \param -v   Explicitly set the verbosity level: 0 request no output, 99 is the default
+  \param -v   Explicitly set the verbosity level: 0 request no output, 99 is the default, 100 also reports the
+              progress of the merge
   \param -j   Parallelise the execution in `J` processes. If the number of processes is not specified, use the system maximum.
+  \param -t   Merge histograms in parallel within this process using `T` threads (implicit multi-threading).
+              If the number of threads is not specified, use the system maximum, shared by the processes of -j.
   \param -dbg Enable verbosity. If -j was specified, do not not delete partial files stored inside working directory.
   \param -d   Carry out the partial multiprocess execution in the specified directory
   \param -n   Open at most `N` files at once (use 0 to request to use the system maximum)
+  \param -memory Keep the memory used by the merge within the given size: the number of input files opened at once
+              is then chosen automatically and histograms are accumulated one input file at a time when needed.
   \param -cachesize Resize the prefetching cache use to speed up I/O operations (use 0 to disable).
   \param -experimental-io-features `<feature>` Enables the corresponding experimental feature for output trees. \see ROOT::Experimental::EIOFeatures
   \return hadd returns a status code: 0 if OK, -1 otherwise
@@ -99,11 +104,13 @@
 #include "THashList.h"
 #include "TKey.h"
 #include "TClass.h"
+#include "TROOT.h"
 #include "TSystem.h"
 #include "TUUID.h"
 #include "ROOT/StringConv.hxx"
 #include "snprintf.h"
 
+#include <algorithm>
 #include <string>
 #include <iostream>
 #include <fstream>
@@ -137,6 +144,9 @@ int main( int argc, char **argv )
    Bool_t multiproc = kFALSE;
    Bool_t debug = kFALSE;
    Int_t maxopenedfiles = 0;
+   Long64_t memoryBudget = 0;
+   Bool_t imt = kFALSE;
+   UInt_t nThreads = 0;
    Int_t verbosity = 99;
    TString cacheSize;
    SysInfo_t s;
@@ -209,6 +219,26 @@ int main( int argc, char **argv )
          }
          multiproc = kTRUE;
          ++ffirst;
+      } else if (strcmp(argv[a], "-t") == 0) {
+         // If the number of threads is not specified, use the default.
+         if (a + 1 != argc && argv[a + 1][0] != '-') {
+            char *end = nullptr;
+            const Long_t request = strtol(argv[a + 1], &end, 10);
+            if (*end == '\0' && request >= 0 && request < kMaxInt) {
+               nThreads = (UInt_t)request;
+               ++a;
+               ++ffirst;
+            } else {
+               std::cerr << "Error: could not parse the number of threads to use passed after -t: " << argv[a + 1]
+                         << ". We will use the default value (number of logical cores).\n";
+            }
+         }
+#ifdef R__USE_IMT
+         imt = kTRUE;
+#else
+         std::cerr << "Error: -t requires ROOT to be built with implicit multi-threading support; ignoring.\n";
+#endif
+         ++ffirst;
       } else if ( strcmp(argv[a],"-cachesize=") == 0 ) {
          int size;
          static const size_t arglen = strlen("-cachesize=");
@@ -283,6 +313,22 @@ int main( int argc, char **argv )
             }
          }
          ++ffirst;
+      } else if ( strcmp(argv[a],"-memory") == 0 ) {
+         if (a+1 >= argc) {
+            std::cerr << "Error: no memory size was provided after -memory.\n";
+         } else {
+            Long64_t size;
+            auto parseResult = ROOT::FromHumanReadableSize(argv[a+1],size);
+            if (parseResult != ROOT::EFromHumanReadableSize::kSuccess || size < 0) {
+               std::cerr << "Error: could not parse the memory size passed after -memory: " << argv[a+1]
+                         << ". The memory use will not be limited.\n";
+            } else {
+               memoryBudget = size;
+               ++a;
+               ++ffirst;
+            }
+         }
+         ++ffirst;
       } else if ( strcmp(argv[a],"-v") == 0 ) {
          if (a+1 == argc || argv[a+1][0] == '-') {
             // Verbosity level was not specified use the default:
@@ -376,6 +422,9 @@ int main( int argc, char **argv )
    if (maxopenedfiles > 0) {
       fileMerger.SetMaxOpenedFiles(maxopenedfiles);
    }
+   if (memoryBudget > 0) {
+      fileMerger.SetMemoryBudget(memoryBudget);
+   }
    if (newcomp == -1) {
       if (useFirstInputCompression || keepCompressionAsIs) {
          // grab from the first file.
@@ -432,6 +481,20 @@ int main( int argc, char **argv )
    if (nProcesses == 1)
       multiproc = kFALSE;
 
+#ifdef R__USE_IMT
+   // The thread pool must not be running when the processes of -j are forked: each of them then starts its own,
+   // sharing the cores unless the number of threads was given, and this process starts it for the final merge.
+   auto enableIMT = [&]() {
+      if (!imt || ROOT::IsImplicitMTEnabled())
+         return;
+      ROOT::EnableImplicitMT(nThreads);
+      if (verbosity > 1)
+         std::cout << "hadd merging histograms with " << ROOT::GetThreadPoolSize() << " threads" << std::endl;
+   };
+   if (!multiproc)
+      enableIMT();
+#endif
+
    std::vector<std::string> partialFiles;
 
 #ifndef R__WIN32
@@ -498,12 +561,19 @@ int main( int argc, char **argv )
    };
 
    auto parallelMerge = [&](int start) {
+#ifdef R__USE_IMT
+      if (imt && !ROOT::IsImplicitMTEnabled())
+         ROOT::EnableImplicitMT(nThreads > 0 ? nThreads : std::max<UInt_t>(1, s.fCpus / nProcesses));
+#endif
       TFileMerger mergerP(kFALSE, kFALSE);
       mergerP.SetMsgPrefix("hadd");
       mergerP.SetPrintLevel(verbosity - 1);
       if (maxopenedfiles > 0) {
          mergerP.SetMaxOpenedFiles(maxopenedfiles / nProcesses);
       }
+      if (memoryBudget > 0) {
+         mergerP.SetMemoryBudget(memoryBudget / nProcesses);
+      }
       if (!mergerP.OutputFile(partialFiles[(start - ffirst) / step].c_str(), newcomp)) {
          std::cerr << "hadd error opening target partial file" << std::endl;
          exit(1);
@@ -526,6 +596,9 @@ int main( int argc, char **argv )
       auto res = p.Map(parallelMerge, ROOT::TSeqI(ffirst, argc, step));
       status = std::accumulate(res.begin(), res.end(), 0U) == partialFiles.size();
       if (status) {
+#ifdef R__USE_IMT
+         enableIMT();
+#endif
          status = reductionFunc();
       } else {
          std::cout << "hadd failed at the parallel stage" << std::endl;
@@ -64,7 +64,8 @@ public:
       BaseFCN( data, func),
       fNEffPoints(0),
       fGrad ( std::vector<double> ( func->NPar() ) ),
-      fExecutionPolicy(executionPolicy)
+      fExecutionPolicy(FitUtil::CheckExecutionPolicy<T>(executionPolicy)),
+      fMPEvaluator(FitUtil::MakeMultiProcessEvaluator(fExecutionPolicy))
    { }
 
    /**
@@ -74,7 +75,8 @@ public:
       BaseFCN(std::make_shared<BinData>(data), std::shared_ptr<IModelFunction>(dynamic_cast<IModelFunction*>(func.Clone() ) ) ),
       fNEffPoints(0),
       fGrad ( std::vector<double> ( func.NPar() ) ),
-      fExecutionPolicy(executionPolicy)
+      fExecutionPolicy(FitUtil::CheckExecutionPolicy<T>(executionPolicy)),
+      fMPEvaluator(FitUtil::MakeMultiProcessEvaluator(fExecutionPolicy))
    { }
 
    /**
@@ -88,7 +90,8 @@ public:
       BaseFCN(f.DataPtr(), f.ModelFunctionPtr() ),
       fNEffPoints( f.fNEffPoints ),
       fGrad( f.fGrad),
-      fExecutionPolicy(f.fExecutionPolicy)
+      fExecutionPolicy(f.fExecutionPolicy),
+      fMPEvaluator(f.fMPEvaluator)
    {  }
 
    /**
@@ -99,6 +102,7 @@ public:
       SetModelFunction(rhs.ModelFunctionPtr() );
       fNEffPoints = rhs.fNEffPoints;
       fGrad = rhs.fGrad;
+      fMPEvaluator = rhs.fMPEvaluator;
    }
 
    /*
@@ -130,6 +134,12 @@ public:
    /// get type of fit method function
    virtual  typename BaseObjFunction::Type_t Type() const { return BaseObjFunction::kLeastSquare; }
 
+   /// stop the worker processes used by the kMultiProcess execution policy.
+   /// They are started again if the function is evaluated afterwards.
+   void TerminateWorkers() const {
+      if (fMPEvaluator) fMPEvaluator->Terminate();
+   }
+
 
 protected:
 
@@ -146,7 +156,8 @@ private:
       if (BaseFCN::Data().HaveCoordErrors() || BaseFCN::Data().HaveAsymErrors())
          return FitUtil::Evaluate<T>::EvalChi2Effective(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fNEffPoints);
       else
-         return FitUtil::Evaluate<T>::EvalChi2(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fNEffPoints, fExecutionPolicy);
+         return FitUtil::Evaluate<T>::EvalChi2(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fNEffPoints,
+                                               fExecutionPolicy, 0, fMPEvaluator.get());
    }
 
    // for derivatives
@@ -160,6 +171,7 @@ private:
 
    mutable std::vector<double> fGrad; ///< for derivatives
    ::ROOT::EExecutionPolicy fExecutionPolicy;
+   std::shared_ptr<FitUtil::MultiProcessEvaluator> fMPEvaluator; ///<! worker processes used by the kMultiProcess policy
 
 };
 
@@ -29,6 +29,10 @@
 #include "Math/IntegratorMultiDim.h"
 
 #include "TError.h"
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
 #include <vector>
 
 // using parameter cache is not thread safe but needed for normalizing the functions
@@ -264,14 +268,104 @@ namespace FitUtil {
      ROOT::Math::IMultiGenFunction *fFuncNDim;
   };
 
+  /**
+     Pool of worker processes evaluating the fit method functions with the
+     ROOT::EExecutionPolicy::kMultiProcess execution policy.
+
+     The workers are forked at the first evaluation and inherit a copy of the model function and of the data.
+     Each of them is then responsible for a fixed chunk of the data points for the lifetime of the pool: at every
+     evaluation only the parameter values are sent to the workers and their partial sums are sent back, both
+     through memory shared with the parent process. This allows to use all the cores also with model functions
+     which are not thread safe (e.g. interpreted functions or functions using global state).
+
+     The workers evaluate the function they have been started with until the pool is terminated, therefore a pool
+     must be used only with the model function and the data of its first evaluation.
+     The Fitter terminates the workers at the end of each minimization; they are started again if the objective
+     function is evaluated afterwards (e.g. for a later Minos or contour computation).
+     The pool is not available on Windows, where the evaluation falls back to the sequential execution.
+  */
+  class MultiProcessEvaluator {
+  public:
+     /// number of partial sums computed by each worker
+     static constexpr unsigned int kNSums = 3;
+
+     /// function adding to sums the contributions of the data points in [begin, end) for the parameters p
+     using ChunkFunction_t = std::function<void(const double *p, unsigned int begin, unsigned int end, double *sums)>;
+
+     /// create a pool of nWorkers processes (by default one per available core)
+     explicit MultiProcessEvaluator(unsigned int nWorkers = 0);
+
+     /// terminate the workers
+     ~MultiProcessEvaluator();
+
+     MultiProcessEvaluator(const MultiProcessEvaluator &) = delete;
+     MultiProcessEvaluator &operator=(const MultiProcessEvaluator &) = delete;
+
+     /// evaluate in the workers the kNSums sums of func over the n data points for the npar parameters p.
+     /// The workers are started at the first call. Return false if the evaluation could not be performed.
+     bool Evaluate(const ChunkFunction_t &func, const double *p, unsigned int npar, unsigned int n, double *sums);
+
+     /// stop the worker processes, they are started again at the next evaluation
+     void Terminate();
+
+     /// number of worker processes used by the pool
+     unsigned int NWorkers() const { return fNWorkers; }
+
+     /// return true if the worker processes are running
+     bool IsRunning() const { return !fWorkers.empty(); }
+
+  private:
+     struct Worker {
+        int fPid;     ///< process id of the worker
+        int fCommand; ///< pipe used to send commands to the worker
+        int fReply;   ///< pipe used by the worker to notify the end of the evaluation
+     };
+
+     bool Start(const ChunkFunction_t &func, unsigned int npar, unsigned int n);
+     // stop the workers, the caller must hold fMutex
+     void Stop();
+
+     unsigned int fNWorkers;       ///< number of requested workers
+     unsigned int fNPar = 0;       ///< number of parameters the workers have been started with
+     unsigned int fNPoints = 0;    ///< number of data points the workers have been started with
+     std::vector<Worker> fWorkers; ///< running workers
+     void *fShared = nullptr;      ///< shared memory holding the parameters and the partial sums
+     size_t fSharedSize = 0;       ///< size of the shared memory
+     std::mutex fMutex;            ///< serialize the evaluations
+  };
+
+  /// return the pool of worker processes to be used with the given execution policy (null if not needed)
+  inline std::shared_ptr<MultiProcessEvaluator> MakeMultiProcessEvaluator(::ROOT::EExecutionPolicy executionPolicy)
+  {
+     if (executionPolicy == ::ROOT::EExecutionPolicy::kMultiProcess)
+        return std::make_shared<MultiProcessEvaluator>();
+     return nullptr;
+  }
+
+  /// return the execution policy to be used for evaluating model functions with the backend type T:
+  /// the vectorized evaluation does not support the kMultiProcess policy and falls back to kSequential
+  template <class T>
+  ::ROOT::EExecutionPolicy CheckExecutionPolicy(::ROOT::EExecutionPolicy executionPolicy)
+  {
+     if (!std::is_same<T, double>::value && executionPolicy == ::ROOT::EExecutionPolicy::kMultiProcess) {
+        Warning("FitUtil::CheckExecutionPolicy", "Multiprocess execution policy is not supported by the vectorized "
+                                                 "evaluation. Changing to ::ROOT::EExecutionPolicy::kSequential.");
+        return ::ROOT::EExecutionPolicy::kSequential;
+     }
+     return executionPolicy;
+  }
+
   /** Chi2 Functions */
 
   /**
       evaluate the Chi2 given a model function and the data at the point x.
       return also nPoints as the effective number of used points in the Chi2 evaluation
+      With the kMultiProcess policy the evaluation is done by the workers of mpEvaluator, or of a
+      temporary pool if it is not given.
   */
   double EvaluateChi2(const IModelFunction &func, const BinData &data, const double *p, unsigned int &nPoints,
-                      ::ROOT::EExecutionPolicy executionPolicy, unsigned nChunks = 0);
+                      ::ROOT::EExecutionPolicy executionPolicy, unsigned nChunks = 0,
+                      MultiProcessEvaluator *mpEvaluator = nullptr);
 
   /**
       evaluate the effective Chi2 given a model function and the data at the point x.
@@ -292,9 +386,11 @@ namespace FitUtil {
   /**
       evaluate the LogL given a model function and the data at the point x.
       return also nPoints as the effective number of used points in the LogL evaluation
+      See EvaluateChi2 for the use of mpEvaluator.
   */
   double EvaluateLogL(const IModelFunction &func, const UnBinData &data, const double *p, int iWeight, bool extended,
-                      unsigned int &nPoints, ::ROOT::EExecutionPolicy executionPolicy, unsigned nChunks = 0);
+                      unsigned int &nPoints, ::ROOT::EExecutionPolicy executionPolicy, unsigned nChunks = 0,
+                      MultiProcessEvaluator *mpEvaluator = nullptr);
 
   /**
       evaluate the LogL gradient given a model function and the data at the point p.
@@ -315,10 +411,11 @@ namespace FitUtil {
       evaluate the Poisson LogL given a model function and the data at the point p.
       return also nPoints as the effective number of used points in the LogL evaluation
       By default is extended, pass extend to false if want to be not extended (MultiNomial)
+      See EvaluateChi2 for the use of mpEvaluator.
   */
   double EvaluatePoissonLogL(const IModelFunction &func, const BinData &data, const double *p, int iWeight,
                              bool extended, unsigned int &nPoints, ::ROOT::EExecutionPolicy executionPolicy,
-                             unsigned nChunks = 0);
+                             unsigned nChunks = 0, MultiProcessEvaluator *mpEvaluator = nullptr);
 
   /**
       evaluate the Poisson LogL given a model function and the data at the point p.
@@ -364,7 +461,8 @@ namespace FitUtil {
    struct Evaluate {
 #ifdef R__HAS_VECCORE
       static double EvalChi2(const IModelFunctionTempl<T> &func, const BinData &data, const double *p,
-                             unsigned int &nPoints, ::ROOT::EExecutionPolicy executionPolicy, unsigned nChunks = 0)
+                             unsigned int &nPoints, ::ROOT::EExecutionPolicy executionPolicy, unsigned nChunks = 0,
+                             MultiProcessEvaluator * = nullptr)
       {
          // evaluate the chi2 given a  vectorized function reference  , the data and returns the value and also in nPoints
          // the actual number of used points
@@ -475,7 +573,8 @@ namespace FitUtil {
 
       static double EvalLogL(const IModelFunctionTempl<T> &func, const UnBinData &data, const double *const p,
                              int iWeight, bool extended, unsigned int &nPoints,
-                             ::ROOT::EExecutionPolicy executionPolicy, unsigned nChunks = 0)
+                             ::ROOT::EExecutionPolicy executionPolicy, unsigned nChunks = 0,
+                             MultiProcessEvaluator * = nullptr)
       {
          // evaluate the LogLikelihood
          unsigned int n = data.Size();
@@ -725,7 +824,8 @@ namespace FitUtil {
 
       static double EvalPoissonLogL(const IModelFunctionTempl<T> &func, const BinData &data, const double *p,
                                     int iWeight, bool extended, unsigned int,
-                                    ::ROOT::EExecutionPolicy executionPolicy, unsigned nChunks = 0)
+                                    ::ROOT::EExecutionPolicy executionPolicy, unsigned nChunks = 0,
+                                    MultiProcessEvaluator * = nullptr)
       {
          // evaluate the Poisson Log Likelihood
          // for binned likelihood fits
@@ -1397,7 +1497,8 @@ namespace FitUtil {
 #endif
 
       static double EvalChi2(const IModelFunction &func, const BinData &data, const double *p, unsigned int &nPoints,
-                             ::ROOT::EExecutionPolicy executionPolicy, unsigned nChunks = 0)
+                             ::ROOT::EExecutionPolicy executionPolicy, unsigned nChunks = 0,
+                             MultiProcessEvaluator *mpEvaluator = nullptr)
       {
          // evaluate the chi2 given a  function reference, the data and returns the value and also in nPoints
          // the actual number of used points
@@ -1407,21 +1508,25 @@ namespace FitUtil {
 
          //Info("EvalChi2","Using non-vectorized implementation %d",(int) data.Opt().fIntegral);
 
-         return FitUtil::EvaluateChi2(func, data, p, nPoints, executionPolicy, nChunks);
+         return FitUtil::EvaluateChi2(func, data, p, nPoints, executionPolicy, nChunks, mpEvaluator);
       }
 
       static double EvalLogL(const IModelFunctionTempl<double> &func, const UnBinData &data, const double *p,
                              int iWeight, bool extended, unsigned int &nPoints,
-                             ::ROOT::EExecutionPolicy executionPolicy, unsigned nChunks = 0)
+                             ::ROOT::EExecutionPolicy executionPolicy, unsigned nChunks = 0,
+                             MultiProcessEvaluator *mpEvaluator = nullptr)
       {
-         return FitUtil::EvaluateLogL(func, data, p, iWeight, extended, nPoints, executionPolicy, nChunks);
+         return FitUtil::EvaluateLogL(func, data, p, iWeight, extended, nPoints, executionPolicy, nChunks,
+                                      mpEvaluator);
       }
 
       static double EvalPoissonLogL(const IModelFunctionTempl<double> &func, const BinData &data, const double *p,
                                     int iWeight, bool extended, unsigned int &nPoints,
-                                    ::ROOT::EExecutionPolicy executionPolicy, unsigned nChunks = 0)
+                                    ::ROOT::EExecutionPolicy executionPolicy, unsigned nChunks = 0,
+                                    MultiProcessEvaluator *mpEvaluator = nullptr)
       {
-         return FitUtil::EvaluatePoissonLogL(func, data, p, iWeight, extended, nPoints, executionPolicy, nChunks);
+         return FitUtil::EvaluatePoissonLogL(func, data, p, iWeight, extended, nPoints, executionPolicy, nChunks,
+                                             mpEvaluator);
       }
 
       static double EvalChi2Effective(const IModelFunctionTempl<double> &func, const BinData & data, const double * p, unsigned int &nPoints)
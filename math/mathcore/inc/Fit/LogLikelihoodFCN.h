@@ -60,7 +60,8 @@ public:
       fWeight(weight),
       fNEffPoints(0),
       fGrad ( std::vector<double> ( func->NPar() ) ),
-      fExecutionPolicy(executionPolicy)
+      fExecutionPolicy(FitUtil::CheckExecutionPolicy<T>(executionPolicy)),
+      fMPEvaluator(FitUtil::MakeMultiProcessEvaluator(fExecutionPolicy))
    {}
 
       /**
@@ -72,7 +73,8 @@ public:
       fWeight(weight),
       fNEffPoints(0),
       fGrad ( std::vector<double> ( func.NPar() ) ),
-      fExecutionPolicy(executionPolicy)
+      fExecutionPolicy(FitUtil::CheckExecutionPolicy<T>(executionPolicy)),
+      fMPEvaluator(FitUtil::MakeMultiProcessEvaluator(fExecutionPolicy))
    {}
 
    /**
@@ -89,7 +91,8 @@ public:
       fWeight( f.fWeight ),
       fNEffPoints( f.fNEffPoints ),
       fGrad( f.fGrad),
-      fExecutionPolicy(f.fExecutionPolicy)
+      fExecutionPolicy(f.fExecutionPolicy),
+      fMPEvaluator(f.fMPEvaluator)
    {  }
 
 
@@ -104,6 +107,7 @@ public:
       fIsExtended = rhs.fIsExtended;
       fWeight = rhs.fWeight;
       fExecutionPolicy = rhs.fExecutionPolicy;
+      fMPEvaluator = rhs.fMPEvaluator;
       return *this;
    }
 
@@ -133,6 +137,12 @@ public:
    /// get type of fit method function
    virtual  typename BaseObjFunction::Type_t Type() const { return BaseObjFunction::kLogLikelihood; }
 
+   /// stop the worker processes used by the kMultiProcess execution policy.
+   /// They are started again if the function is evaluated afterwards.
+   void TerminateWorkers() const {
+      if (fMPEvaluator) fMPEvaluator->Terminate();
+   }
+
 
    // Use sum of the weight squared in evaluating the likelihood
    // (this is needed for calculating the errors)
@@ -154,7 +164,8 @@ private:
     */
    virtual double DoEval (const double * x) const {
       this->UpdateNCalls();
-      return FitUtil::Evaluate<T>::EvalLogL(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fWeight, fIsExtended, fNEffPoints, fExecutionPolicy);
+      return FitUtil::Evaluate<T>::EvalLogL(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fWeight, fIsExtended, fNEffPoints,
+                                            fExecutionPolicy, 0, fMPEvaluator.get());
    }
 
    // for derivatives
@@ -174,6 +185,7 @@ private:
    mutable std::vector<double> fGrad; ///< for derivatives
 
    ::ROOT::EExecutionPolicy fExecutionPolicy; ///< Execution policy
+   std::shared_ptr<FitUtil::MultiProcessEvaluator> fMPEvaluator; ///<! worker processes used by the kMultiProcess policy
 };
       // define useful typedef's
       // using LogLikelihoodFunction_v = LogLikelihoodFCN<ROOT::Math::IMultiGenFunction, ROOT::Math::IParametricFunctionMultiDimTempl<T>>;
@@ -64,7 +64,8 @@ public:
       fWeight(weight),
       fNEffPoints(0),
       fGrad ( std::vector<double> ( func->NPar() ) ),
-      fExecutionPolicy(executionPolicy)
+      fExecutionPolicy(FitUtil::CheckExecutionPolicy<T>(executionPolicy)),
+      fMPEvaluator(FitUtil::MakeMultiProcessEvaluator(fExecutionPolicy))
    { }
 
    /**
@@ -76,7 +77,8 @@ public:
       fWeight(weight),
       fNEffPoints(0),
       fGrad ( std::vector<double> ( func.NPar() ) ),
-      fExecutionPolicy(executionPolicy)
+      fExecutionPolicy(FitUtil::CheckExecutionPolicy<T>(executionPolicy)),
+      fMPEvaluator(FitUtil::MakeMultiProcessEvaluator(fExecutionPolicy))
    { }
 
 
@@ -94,7 +96,8 @@ public:
       fWeight( f.fWeight ),
       fNEffPoints( f.fNEffPoints ),
       fGrad( f.fGrad),
-      fExecutionPolicy(f.fExecutionPolicy)
+      fExecutionPolicy(f.fExecutionPolicy),
+      fMPEvaluator(f.fMPEvaluator)
    {  }
 
    /**
@@ -108,6 +111,7 @@ public:
       fIsExtended = rhs.fIsExtended;
       fWeight = rhs.fWeight;
       fExecutionPolicy = rhs.fExecutionPolicy;
+      fMPEvaluator = rhs.fMPEvaluator;
    }
 
 
@@ -160,6 +164,12 @@ public:
    /// get type of fit method function
    virtual  typename BaseObjFunction::Type_t Type() const { return BaseObjFunction::kPoissonLikelihood; }
 
+   /// stop the worker processes used by the kMultiProcess execution policy.
+   /// They are started again if the function is evaluated afterwards.
+   void TerminateWorkers() const {
+      if (fMPEvaluator) fMPEvaluator->Terminate();
+   }
+
    bool IsWeighted() const { return (fWeight != 0); }
 
    // Use the weights in evaluating the likelihood
@@ -188,7 +198,7 @@ private:
    virtual double DoEval (const double * x) const {
       this->UpdateNCalls();
       return FitUtil::Evaluate<T>::EvalPoissonLogL(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fWeight, fIsExtended,
-                                                   fNEffPoints, fExecutionPolicy);
+                                                   fNEffPoints, fExecutionPolicy, 0, fMPEvaluator.get());
    }
 
    // for derivatives
@@ -208,6 +218,7 @@ private:
    mutable std::vector<double> fGrad; ///< for derivatives
 
    ::ROOT::EExecutionPolicy fExecutionPolicy; ///< Execution policy
+   std::shared_ptr<FitUtil::MultiProcessEvaluator> fMPEvaluator; ///<! worker processes used by the kMultiProcess policy
 };
 
       // define useful typedef's
@@ -103,7 +103,11 @@ namespace ROOT {
 
    To speed up localisation of points (to see to which triangle belong) a grid is laid over the internal coordinate space.
    A reference to triangle ABC is added to _all_ grid cells that include ABC's bounding box.
-   The size of the grid is defined to be 25x25
+   The size of the grid grows with the number of triangles (it is at least 25x25), such that each cell
+   contains only a few triangles. The triangle lists of all the cells are stored contiguously.
+
+   Many points can be interpolated at once with Interpolate(n, x, y, z), which evaluates them in parallel
+   when the implicit multi-threading is enabled.
 
    Optionally (if the compiler macro `HAS_GCAL` is defined ) the triangle findings and interpolation can be computed
    using the GCAL library. This is however not supported when using the class within ROOT
@@ -142,6 +146,11 @@ public:
    /// See the class documentation for  how the interpolation is computed.
    double  Interpolate(double x, double y);
 
+   /// Compute the interpolated z values for the n points (x[i], y[i]) and store them in z.
+   /// The triangles are found once, and the points are then interpolated in parallel
+   /// if the implicit multi-threading is enabled (see ROOT::EnableImplicitMT).
+   void    Interpolate(int n, const double *x, const double *y, double *z);
+
    /// Find all triangles
    void      FindAllTriangles();
 
@@ -225,10 +234,11 @@ protected:
    std::vector<double> fXN; ///<! normalized X
    std::vector<double> fYN; ///<! normalized Y
 
-   static const int fNCells = 25; ///<! number of cells to divide the normalized space
+   int fNCells = 25;  ///<! number of cells to divide the normalized space in each direction
    double fXCellStep; ///<! inverse denominator to calculate X cell = fNCells / (fXNmax - fXNmin)
    double fYCellStep; ///<! inverse denominator to calculate X cell = fNCells / (fYNmax - fYNmin)
-   std::set<unsigned int> fCells[(fNCells+1)*(fNCells+1)]; ///<! grid cells with containing triangles
+   std::vector<unsigned int> fCellFirst;     ///<! index in fCellTriangles of the first triangle of each grid cell
+   std::vector<unsigned int> fCellTriangles; ///<! triangles overlapping the grid cells, stored cell after cell
 
    inline unsigned int Cell(unsigned int x, unsigned int y) const {
       return x*(fNCells+1) + y;
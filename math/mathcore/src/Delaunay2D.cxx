@@ -21,7 +21,13 @@
 #include "triangle.h"
 #endif
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "TROOT.h"
+#endif
+
 #include <algorithm>
+#include <cmath>
 #include <cstdlib>
 
 #include <iostream>
@@ -132,6 +138,41 @@ double Delaunay2D::Interpolate(double x, double y)
    return zz;
 }
 
+//______________________________________________________________________________
+void Delaunay2D::Interpolate(int n, const double *x, const double *y, double *z)
+{
+   // Return the interpolated z values corresponding to the given (x[i],y[i]) points
+
+   FindAllTriangles();
+
+   if (fNdt == 0) {
+      std::fill(z, z + n, fZout);
+      return;
+   }
+
+   auto interpolateRange = [&](int begin, int end) {
+      for (int i = begin; i < end; ++i) {
+         z[i] = DoInterpolateNormalized(Linear_transform(x[i], fOffsetX, fScaleFactorX),
+                                        Linear_transform(y[i], fOffsetY, fScaleFactorY));
+      }
+   };
+
+#if defined(R__USE_IMT) && !defined(HAS_CGAL)
+   // the triangles and the cell grid are only read after FindAllTriangles: the points
+   // can be interpolated concurrently
+   const int minPointsPerChunk = 1000;
+   if (ROOT::IsImplicitMTEnabled() && n >= 2 * minPointsPerChunk) {
+      const int nChunks = std::min<int>(n / minPointsPerChunk, 4 * ROOT::GetThreadPoolSize());
+      const int chunkSize = (n + nChunks - 1) / nChunks;
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](unsigned int chunk) { interpolateRange(chunk * chunkSize, std::min(n, int(chunk + 1) * chunkSize)); },
+                   ROOT::TSeq<unsigned int>(0, nChunks));
+      return;
+   }
+#endif
+   interpolateRange(0, n);
+}
+
 //______________________________________________________________________________
 void Delaunay2D::FindAllTriangles()
 {
@@ -163,14 +204,12 @@ void Delaunay2D::FindAllTriangles()
 
 /// Triangle implementation for points normalization
 void Delaunay2D::DoNormalizePoints() {
+   fXN.clear();
+   fYN.clear();
    for (Int_t n = 0; n < fNpoints; n++) {
       fXN.push_back(Linear_transform(fX[n], fOffsetX, fScaleFactorX));
       fYN.push_back(Linear_transform(fY[n], fOffsetY, fScaleFactorY));
    }
-
-   //also initialize fXCellStep and FYCellStep
-   fXCellStep = fNCells / (fXNmax - fXNmin);
-   fYCellStep = fNCells / (fYNmax - fYNmin);
 }
 
 /// Triangle implementation for finding all the triangles
@@ -244,6 +283,27 @@ void Delaunay2D::DoFindTriangles() {
 
    triangulate((char *) "zQN", &in, &out, nullptr);
 
+   // size the cell grid such that there is about one triangle per cell, each triangle being
+   // then referenced by a few cells
+   fNCells = std::max(25, std::min(2048, int(std::sqrt(double(out.numberoftriangles)))));
+   fXCellStep = fNCells / (fXNmax - fXNmin);
+   fYCellStep = fNCells / (fYNmax - fYNmin);
+
+   // range of cells covered by the bounding box of a triangle
+   auto cellRange = [&](const Triangle &tri, unsigned int &cellXmin, unsigned int &cellXmax, unsigned int &cellYmin,
+                        unsigned int &cellYmax) {
+      auto bx = std::minmax({tri.x[0], tri.x[1], tri.x[2]});
+      auto by = std::minmax({tri.y[0], tri.y[1], tri.y[2]});
+      cellXmin = std::max(0, std::min(fNCells, CellX(bx.first)));
+      cellXmax = std::max(0, std::min(fNCells, CellX(bx.second)));
+      cellYmin = std::max(0, std::min(fNCells, CellY(by.first)));
+      cellYmax = std::max(0, std::min(fNCells, CellY(by.second)));
+   };
+
+   // number of triangles overlapping each cell, converted afterwards in the index of
+   // the first triangle of the cell in fCellTriangles
+   fCellFirst.assign((fNCells + 1) * (fNCells + 1) + 1, 0);
+
    fTriangles.resize(out.numberoftriangles);
    for(int t = 0; t < out.numberoftriangles; ++t){
       Triangle tri;
@@ -273,19 +333,28 @@ void Delaunay2D::DoFindTriangles() {
 
       fTriangles[t] = tri;
 
-      auto bx = std::minmax({tri.x[0], tri.x[1], tri.x[2]});
-      auto by = std::minmax({tri.y[0], tri.y[1], tri.y[2]});
-
-      unsigned int cellXmin = CellX(bx.first);
-      unsigned int cellXmax = CellX(bx.second);
+      unsigned int cellXmin, cellXmax, cellYmin, cellYmax;
+      cellRange(tri, cellXmin, cellXmax, cellYmin, cellYmax);
+      for(unsigned int i = cellXmin; i <= cellXmax; ++i) {
+         for(unsigned int j = cellYmin; j <= cellYmax; ++j) {
+            fCellFirst[Cell(i,j) + 1]++;
+         }
+      }
+   }
 
-      unsigned int cellYmin = CellY(by.first);
-      unsigned int cellYmax = CellY(by.second);
+   for (size_t c = 1; c < fCellFirst.size(); ++c)
+      fCellFirst[c] += fCellFirst[c - 1];
 
+   // fill the triangles of each cell, in increasing order as the triangles are visited in order
+   fCellTriangles.resize(fCellFirst.back());
+   std::vector<unsigned int> cellFill(fCellFirst.begin(), fCellFirst.end() - 1);
+   for (int t = 0; t < out.numberoftriangles; ++t) {
+      unsigned int cellXmin, cellXmax, cellYmin, cellYmax;
+      cellRange(fTriangles[t], cellXmin, cellXmax, cellYmin, cellYmax);
       for(unsigned int i = cellXmin; i <= cellXmax; ++i) {
          for(unsigned int j = cellYmin; j <= cellYmax; ++j) {
             //printf("(%u,%u) = %u\n", i, j, Cell(i,j));
-            fCells[Cell(i,j)].insert(t);
+            fCellTriangles[cellFill[Cell(i,j)]++] = t;
          }
       }
    }
@@ -331,7 +400,9 @@ double Delaunay2D::DoInterpolateNormalized(double xx, double yy)
    if (cX < 0 || cX > fNCells || cY < 0 || cY > fNCells)
       return fZout; // TODO some more fancy interpolation here
 
-   for (unsigned int t : fCells[Cell(cX, cY)]) {
+   const unsigned int cell = Cell(cX, cY);
+   for (unsigned int it = fCellFirst[cell]; it < fCellFirst[cell + 1]; ++it) {
+      const unsigned int t = fCellTriangles[it];
 
       auto coords = bayCoords(t);
 
@@ -31,8 +31,18 @@
 #include <cassert>
 #include <algorithm>
 #include <numeric>
+#include <thread>
+#include <cstdio>
+#include <iostream>
 //#include <memory>
 
+#ifndef _WIN32
+#include <cerrno>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 #include "TROOT.h"
 
 //#define DEBUG
@@ -218,13 +228,233 @@ namespace ROOT {
       } // end namespace  FitUtil
 
 
+//___________________________________________________________________________________________________________________________
+// worker processes for the kMultiProcess execution policy
+//___________________________________________________________________________________________________________________________
+
+namespace {
+
+#ifndef _WIN32
+// write and read one command byte on a pipe, retrying if interrupted by a signal
+bool WriteCommand(int fd, char c)
+{
+   ssize_t nw;
+   do {
+      nw = ::write(fd, &c, 1);
+   } while (nw < 0 && errno == EINTR);
+   return nw == 1;
+}
+
+bool ReadCommand(int fd, char &c)
+{
+   ssize_t nr;
+   do {
+      nr = ::read(fd, &c, 1);
+   } while (nr < 0 && errno == EINTR);
+   return nr == 1;
+}
+#endif
+
+// evaluate using the given pool of workers or, if there is none, a pool used only for this evaluation
+bool EvaluateInWorkers(FitUtil::MultiProcessEvaluator *mpEvaluator,
+                       const FitUtil::MultiProcessEvaluator::ChunkFunction_t &func, const double *p, unsigned int npar,
+                       unsigned int n, double *sums)
+{
+   if (mpEvaluator)
+      return mpEvaluator->Evaluate(func, p, npar, n, sums);
+   FitUtil::MultiProcessEvaluator tmpEvaluator;
+   return tmpEvaluator.Evaluate(func, p, npar, n, sums);
+}
+
+} // anonymous namespace
+
+FitUtil::MultiProcessEvaluator::MultiProcessEvaluator(unsigned int nWorkers) : fNWorkers(nWorkers)
+{
+   if (fNWorkers == 0)
+      fNWorkers = std::max(1u, std::thread::hardware_concurrency());
+}
+
+FitUtil::MultiProcessEvaluator::~MultiProcessEvaluator()
+{
+   Stop();
+}
+
+bool FitUtil::MultiProcessEvaluator::Start(const ChunkFunction_t &func, unsigned int npar, unsigned int n)
+{
+#ifdef _WIN32
+   (void)func;
+   (void)npar;
+   (void)n;
+   Warning("FitUtil::MultiProcessEvaluator::Start", "Multiprocess execution policy is not supported on Windows. "
+                                                    "Changing to ROOT::EExecutionPolicy::kSequential.");
+   return false;
+#else
+   // do not start more workers than data points
+   unsigned int nworkers = std::max(1u, std::min(fNWorkers, n));
+
+   // shared memory layout: the parameter values followed by the partial sums of each worker
+   fSharedSize = (npar + kNSums * nworkers) * sizeof(double);
+   fShared = ::mmap(nullptr, fSharedSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+   if (fShared == MAP_FAILED) {
+      fShared = nullptr;
+      SysError("FitUtil::MultiProcessEvaluator::Start", "cannot allocate the shared memory");
+      return false;
+   }
+   fNPar = npar;
+   fNPoints = n;
+   const double *params = static_cast<double *>(fShared);
+   double *results = static_cast<double *>(fShared) + npar;
+
+   // avoid that buffered output is written again by the workers
+   std::cout.flush();
+   std::cerr.flush();
+   std::fflush(nullptr);
+
+   for (unsigned int iw = 0; iw < nworkers; ++iw) {
+      int command[2];
+      int reply[2];
+      if (::pipe(command) != 0) {
+         SysError("FitUtil::MultiProcessEvaluator::Start", "cannot create the pipes for the workers");
+         Stop();
+         return false;
+      }
+      if (::pipe(reply) != 0) {
+         SysError("FitUtil::MultiProcessEvaluator::Start", "cannot create the pipes for the workers");
+         ::close(command[0]);
+         ::close(command[1]);
+         Stop();
+         return false;
+      }
+      pid_t pid = ::fork();
+      if (pid < 0) {
+         SysError("FitUtil::MultiProcessEvaluator::Start", "cannot fork the workers");
+         ::close(command[0]);
+         ::close(command[1]);
+         ::close(reply[0]);
+         ::close(reply[1]);
+         Stop();
+         return false;
+      }
+      if (pid == 0) {
+         // worker process: keep only its own ends of the pipes, so that it sees the end of file
+         // of the command pipe when the parent goes away
+         for (auto &w : fWorkers) {
+            ::close(w.fCommand);
+            ::close(w.fReply);
+         }
+         ::close(command[1]);
+         ::close(reply[0]);
+         const unsigned int begin = (unsigned long long)n * iw / nworkers;
+         const unsigned int end = (unsigned long long)n * (iw + 1) / nworkers;
+         double *sums = results + kNSums * iw;
+         std::vector<double> par(params, params + npar);
+         char c;
+         while (ReadCommand(command[0], c) && c == 'e') {
+            std::copy(params, params + npar, par.begin());
+            std::fill(sums, sums + kNSums, 0.);
+            func(par.data(), begin, end, sums);
+            if (!WriteCommand(reply[1], 'd'))
+               break;
+         }
+         // never return to the caller in the worker and skip the exit handlers of the parent
+         ::_exit(0);
+      }
+      ::close(command[0]);
+      ::close(reply[1]);
+      fWorkers.push_back({pid, command[1], reply[0]});
+   }
+   return true;
+#endif
+}
+
+bool FitUtil::MultiProcessEvaluator::Evaluate(const ChunkFunction_t &func, const double *p, unsigned int npar,
+                                              unsigned int n, double *sums)
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   std::fill(sums, sums + kNSums, 0.);
+#ifdef _WIN32
+   return Start(func, npar, n);
+#else
+   if (IsRunning() && (npar != fNPar || n != fNPoints))
+      Stop();
+   if (!IsRunning() && !Start(func, npar, n))
+      return false;
+
+   // check that no worker has been terminated meanwhile, since writing to its pipe would raise SIGPIPE
+   for (auto &w : fWorkers) {
+      int status;
+      if (::waitpid(w.fPid, &status, WNOHANG) != 0) {
+         Error("FitUtil::MultiProcessEvaluator::Evaluate", "worker %d is not running anymore", w.fPid);
+         Stop();
+         return false;
+      }
+   }
+   std::copy(p, p + npar, static_cast<double *>(fShared));
+   for (auto &w : fWorkers) {
+      if (!WriteCommand(w.fCommand, 'e')) {
+         Error("FitUtil::MultiProcessEvaluator::Evaluate", "worker %d is not running anymore", w.fPid);
+         Stop();
+         return false;
+      }
+   }
+   bool ok = true;
+   for (auto &w : fWorkers) {
+      char c;
+      if (!ReadCommand(w.fReply, c)) {
+         Error("FitUtil::MultiProcessEvaluator::Evaluate", "worker %d terminated during the evaluation", w.fPid);
+         ok = false;
+      }
+   }
+   if (!ok) {
+      Stop();
+      return false;
+   }
+   // always add the partial sums in the same order for reproducible results
+   const double *results = static_cast<double *>(fShared) + npar;
+   for (unsigned int iw = 0; iw < fWorkers.size(); ++iw) {
+      for (unsigned int k = 0; k < kNSums; ++k)
+         sums[k] += results[kNSums * iw + k];
+   }
+   return true;
+#endif
+}
+
+void FitUtil::MultiProcessEvaluator::Terminate()
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   Stop();
+}
+
+void FitUtil::MultiProcessEvaluator::Stop()
+{
+#ifndef _WIN32
+   // the workers exit when they find the end of file of their command pipe
+   for (auto &w : fWorkers) {
+      ::close(w.fCommand);
+      ::close(w.fReply);
+   }
+   for (auto &w : fWorkers) {
+      int status;
+      while (::waitpid(w.fPid, &status, 0) < 0 && errno == EINTR) {
+      }
+   }
+   fWorkers.clear();
+   if (fShared)
+      ::munmap(fShared, fSharedSize);
+#endif
+   fShared = nullptr;
+   fSharedSize = 0;
+}
+
+
 
 //___________________________________________________________________________________________________________________________
 // for chi2 functions
 //___________________________________________________________________________________________________________________________
 
 double FitUtil::EvaluateChi2(const IModelFunction &func, const BinData &data, const double *p, unsigned int &nPoints,
-                              ::ROOT::EExecutionPolicy executionPolicy, unsigned nChunks)
+                              ::ROOT::EExecutionPolicy executionPolicy, unsigned nChunks,
+                              MultiProcessEvaluator *mpEvaluator)
 {
          // evaluate the chi2 given a  function reference  , the data and returns the value and also in nPoints
          // the actual number of used points
@@ -404,11 +634,26 @@ double FitUtil::EvaluateChi2(const IModelFunction &func, const BinData &data, co
     auto chunks = nChunks !=0? nChunks: setAutomaticChunking(data.Size());
     res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction, chunks);
 #endif
-//   } else if(executionPolicy == ROOT::Fit::kMultitProcess){
-    // ROOT::TProcessExecutor pool;
-    // res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction);
+  } else if(executionPolicy == ROOT::EExecutionPolicy::kMultiProcess) {
+    // executed by the workers, which receive the parameter values through the shared memory
+    auto chunkFunction = [&](const double *par, unsigned int begin, unsigned int end, double *sums) {
+      p = par;
+      (const_cast<IModelFunction &>(func)).SetParameters(p);
+#ifndef USE_PARAMCACHE
+      igEval.SetParameters(p);
+#endif
+      for (unsigned int i = begin; i < end; ++i)
+        sums[0] += mapFunction(i);
+    };
+    double sums[MultiProcessEvaluator::kNSums];
+    if (EvaluateInWorkers(mpEvaluator, chunkFunction, p, func.NPar(), n, sums)) {
+      res = sums[0];
+    } else {
+      for (unsigned int i=0; i<n; ++i)
+        res += mapFunction(i);
+    }
   } else{
-    Error("FitUtil::EvaluateChi2","Execution policy unknown. Available choices:\n ROOT::EExecutionPolicy::kSequential (default)\n ROOT::EExecutionPolicy::kMultiThread (requires IMT)\n");
+    Error("FitUtil::EvaluateChi2","Execution policy unknown. Available choices:\n ROOT::EExecutionPolicy::kSequential (default)\n ROOT::EExecutionPolicy::kMultiThread (requires IMT)\n ROOT::EExecutionPolicy::kMultiProcess\n");
   }
 
   // reset the number of fitting data points
@@ -834,6 +1079,10 @@ void FitUtil::EvaluateChi2Gradient(const IModelFunction &f, const BinData &data,
    }
 #endif
 
+   // the gradient is not evaluated in the worker processes of the multi-process policy
+   if (executionPolicy == ROOT::EExecutionPolicy::kMultiProcess)
+      executionPolicy = ROOT::EExecutionPolicy::kSequential;
+
    if (executionPolicy == ROOT::EExecutionPolicy::kSequential) {
       std::vector<std::vector<double>> allGradients(initialNPoints);
       for (unsigned int i = 0; i < initialNPoints; ++i) {
@@ -938,7 +1187,8 @@ double FitUtil::EvaluatePdf(const IModelFunction & func, const UnBinData & data,
 
 double FitUtil::EvaluateLogL(const IModelFunction &func, const UnBinData &data, const double *p,
                              int iWeight, bool extended, unsigned int &nPoints,
-                             ROOT::EExecutionPolicy executionPolicy, unsigned nChunks)
+                             ROOT::EExecutionPolicy executionPolicy, unsigned nChunks,
+                             MultiProcessEvaluator *mpEvaluator)
 {
    // evaluate the LogLikelihood
 
@@ -1090,11 +1340,33 @@ double FitUtil::EvaluateLogL(const IModelFunction &func, const UnBinData &data,
     sumW=resArray.weight;
     sumW2=resArray.weight2;
 #endif
-//   } else if(executionPolicy == ROOT::Fit::kMultiProcess){
-    // ROOT::TProcessExecutor pool;
-    // res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction);
+  } else if(executionPolicy == ROOT::EExecutionPolicy::kMultiProcess) {
+    // executed by the workers, which receive the parameter values through the shared memory
+    auto chunkFunction = [&](const double *par, unsigned int begin, unsigned int end, double *sums) {
+      p = par;
+      (const_cast<IModelFunction &>(func)).SetParameters(p);
+      for (unsigned int i = begin; i < end; ++i) {
+        auto resArray = mapFunction(i);
+        sums[0] += resArray.logvalue;
+        sums[1] += resArray.weight;
+        sums[2] += resArray.weight2;
+      }
+    };
+    double sums[MultiProcessEvaluator::kNSums];
+    if (EvaluateInWorkers(mpEvaluator, chunkFunction, p, func.NPar(), n, sums)) {
+      logl = sums[0];
+      sumW = sums[1];
+      sumW2 = sums[2];
+    } else {
+      for (unsigned int i=0; i<n; ++i) {
+        auto resArray = mapFunction(i);
+        logl+=resArray.logvalue;
+        sumW+=resArray.weight;
+        sumW2+=resArray.weight2;
+      }
+    }
   } else{
-    Error("FitUtil::EvaluateLogL","Execution policy unknown. Available choices:\n ROOT::EExecutionPolicy::kSequential (default)\n ROOT::EExecutionPolicy::kMultiThread (requires IMT)\n");
+    Error("FitUtil::EvaluateLogL","Execution policy unknown. Available choices:\n ROOT::EExecutionPolicy::kSequential (default)\n ROOT::EExecutionPolicy::kMultiThread (requires IMT)\n ROOT::EExecutionPolicy::kMultiProcess\n");
   }
 
   if (extended) {
@@ -1251,6 +1523,10 @@ void FitUtil::EvaluateLogLGradient(const IModelFunction &f, const UnBinData &dat
    }
 #endif
 
+   // the gradient is not evaluated in the worker processes of the multi-process policy
+   if (executionPolicy == ROOT::EExecutionPolicy::kMultiProcess)
+      executionPolicy = ROOT::EExecutionPolicy::kSequential;
+
    if (executionPolicy == ROOT::EExecutionPolicy::kSequential) {
       std::vector<std::vector<double>> allGradients(initialNPoints);
       for (unsigned int i = 0; i < initialNPoints; ++i) {
@@ -1433,7 +1709,7 @@ double FitUtil::EvaluatePoissonBinPdf(const IModelFunction & func, const BinData
 
 double FitUtil::EvaluatePoissonLogL(const IModelFunction &func, const BinData &data, const double *p, int iWeight,
                                     bool extended, unsigned int &nPoints, ROOT::EExecutionPolicy executionPolicy,
-                                    unsigned nChunks)
+                                    unsigned nChunks, MultiProcessEvaluator *mpEvaluator)
 {
    // evaluate the Poisson Log Likelihood
    // for binned likelihood fits
@@ -1631,12 +1907,27 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction &func, const BinData &d
       auto chunks = nChunks != 0 ? nChunks : setAutomaticChunking(data.Size());
       res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction, chunks);
 #endif
-      //   } else if(executionPolicy == ROOT::Fit::kMultitProcess){
-      // ROOT::TProcessExecutor pool;
-      // res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction);
+   } else if (executionPolicy == ROOT::EExecutionPolicy::kMultiProcess) {
+      // executed by the workers, which receive the parameter values through the shared memory
+      auto chunkFunction = [&](const double *par, unsigned int begin, unsigned int end, double *sums) {
+         p = par;
+         (const_cast<IModelFunction &>(func)).SetParameters(p);
+#ifndef USE_PARAMCACHE
+         igEval.SetParameters(p);
+#endif
+         for (unsigned int i = begin; i < end; ++i)
+            sums[0] += mapFunction(i);
+      };
+      double sums[MultiProcessEvaluator::kNSums];
+      if (EvaluateInWorkers(mpEvaluator, chunkFunction, p, func.NPar(), n, sums)) {
+         res = sums[0];
+      } else {
+         for (unsigned int i = 0; i < n; ++i)
+            res += mapFunction(i);
+      }
    } else {
       Error("FitUtil::EvaluatePoissonLogL",
-            "Execution policy unknown. Available choices:\n ROOT::EExecutionPolicy::kSequential (default)\n ROOT::EExecutionPolicy::kMultiThread (requires IMT)\n");
+            "Execution policy unknown. Available choices:\n ROOT::EExecutionPolicy::kSequential (default)\n ROOT::EExecutionPolicy::kMultiThread (requires IMT)\n ROOT::EExecutionPolicy::kMultiProcess\n");
    }
 
 #ifdef DEBUG
@@ -1797,6 +2088,10 @@ void FitUtil::EvaluatePoissonLogLGradient(const IModelFunction &f, const BinData
    }
 #endif
 
+   // the gradient is not evaluated in the worker processes of the multi-process policy
+   if (executionPolicy == ROOT::EExecutionPolicy::kMultiProcess)
+      executionPolicy = ROOT::EExecutionPolicy::kSequential;
+
    if (executionPolicy == ROOT::EExecutionPolicy::kSequential) {
       std::vector<std::vector<double>> allGradients(initialNPoints);
       for (unsigned int i = 0; i < initialNPoints; ++i) {
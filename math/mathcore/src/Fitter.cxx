@@ -839,9 +839,13 @@ bool Fitter::DoMinimization(std::unique_ptr<ObjFunc_t>  objFunc, const ROOT::Mat
    // perform the minimization initializing the minimizer starting from a given obj function
    fFitType = objFunc->Type();
    fExtObjFunction = nullptr;
+   const ObjFunc_t &fcn = *objFunc;
    fObjFunction = std::move(objFunc);
    if (!DoInitMinimizer()) return false;
-   return DoMinimization(chi2func);
+   bool ret = DoMinimization(chi2func);
+   // do not keep the worker processes of the multi-process execution policy after the minimization
+   fcn.TerminateWorkers();
+   return ret;
 }
 template<class ObjFunc_t>
 bool Fitter::DoWeightMinimization(std::unique_ptr<ObjFunc_t> objFunc, const ROOT::Math::IMultiGenFunction * chi2func) {
@@ -849,11 +853,17 @@ bool Fitter::DoWeightMinimization(std::unique_ptr<ObjFunc_t> objFunc, const ROOT
    // and apply afterwards the correction for weights. This applyies only for logL fitting
    this->fFitType = objFunc->Type();
    fExtObjFunction = nullptr;
+   ObjFunc_t &fcn = *objFunc;
    fObjFunction = std::move(objFunc);
    if (!DoInitMinimizer()) return false;
-   if (!DoMinimization(chi2func)) return false;
-   objFunc->UseSumOfWeightSquare();
-   return ApplyWeightCorrection(*objFunc);
+   bool ret = DoMinimization(chi2func);
+   if (ret) {
+      fcn.UseSumOfWeightSquare();
+      ret = ApplyWeightCorrection(fcn);
+   }
+   // do not keep the worker processes of the multi-process execution policy after the minimization
+   fcn.TerminateWorkers();
+   return ret;
 }
 
 
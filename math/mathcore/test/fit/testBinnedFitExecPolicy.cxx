@@ -72,9 +72,10 @@ void printSpeedUps(std::vector<FitModelData> &models)
    std::cout << std::endl << "\n   ***Speedups! (normalized to the number of calls)***" << std::endl;
    std::cout << std::string(longestName.size() + 1, ' ') << "|  MT    "
              << "|  VEC   "
-             << "| MT+VEC " << std::endl;
-   // Name field + value field + three bars + 1 extra
-   std::cout << std::string(longestName.size() + 1 + 8 * 3 + 3 + 1, '-') << std::endl;
+             << "| MT+VEC "
+             << "|  MP    " << std::endl;
+   // Name field + value field + four bars + 1 extra
+   std::cout << std::string(longestName.size() + 1 + 8 * 4 + 4 + 1, '-') << std::endl;
    for (auto const &m : models) {
       std::cout << m.name << std::string(longestName.size() - m.name.size() + 1, ' ');
       for (auto su : m.speedups)
@@ -128,6 +129,12 @@ int main()
    benchmarkFit(fvecCore, h1f, "S L", fit, models[EModel::kPoisson]);
 
 #endif
+#endif
+#ifndef _WIN32
+   fit = "Multiprocess";
+   benchmarkFit(f, h1f, "S MULTIPROCESS", fit, models[EModel::kChi2]);
+   benchmarkFit(f, h1f, "S L MULTIPROCESS", fit, models[EModel::kPoisson]);
+
 #endif
    printSpeedUps(models);
    return 0;
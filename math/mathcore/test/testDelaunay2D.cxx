@@ -7,6 +7,10 @@
 
 #include "gtest/gtest.h"
 
+#include <cmath>
+#include <random>
+#include <vector>
+
 // test Delauney interpolation on edges of a triangle
 // some of these tests failed when using the older version
 // see issue #
@@ -61,4 +65,44 @@ TEST(Delaunay2D,interpolation_at_edges)
 
 }
 
-
+// test the interpolation with many triangles, for which the cell grid is finer,
+// and the interpolation of arrays of points
+TEST(Delaunay2D, interpolation_many_points)
+{
+   const int n = 20000;
+   std::mt19937 gen(42);
+   std::uniform_real_distribution<double> uniform(-1., 1.);
+   std::vector<double> x(n), y(n), z(n);
+   // a plane is exactly interpolated inside the convex hull
+   auto plane = [](double xx, double yy) { return 1. + 2. * xx - 3. * yy; };
+   for (int i = 0; i < n; ++i) {
+      x[i] = uniform(gen);
+      y[i] = uniform(gen);
+      z[i] = plane(x[i], y[i]);
+   }
+
+   ROOT::Math::Delaunay2D d(n, x.data(), y.data(), z.data());
+   d.SetZOuterValue(-999.);
+
+   const int m = 10000;
+   std::vector<double> xp(m), yp(m), zp(m);
+   for (int i = 0; i < m; ++i) {
+      // include points outside the data range
+      xp[i] = 1.2 * uniform(gen);
+      yp[i] = 1.2 * uniform(gen);
+   }
+   d.Interpolate(m, xp.data(), yp.data(), zp.data());
+
+   int nInside = 0;
+   for (int i = 0; i < m; ++i) {
+      EXPECT_DOUBLE_EQ(zp[i], d.Interpolate(xp[i], yp[i]));
+      if (std::abs(xp[i]) < 0.95 && std::abs(yp[i]) < 0.95) {
+         EXPECT_NEAR(zp[i], plane(xp[i], yp[i]), 1.E-10);
+         ++nInside;
+      }
+      if (std::abs(xp[i]) > 1. || std::abs(yp[i]) > 1.) {
+         EXPECT_EQ(zp[i], -999.);
+      }
+   }
+   EXPECT_GT(nInside, m / 2);
+}
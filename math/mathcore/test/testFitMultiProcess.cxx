@@ -0,0 +1,133 @@
+#include "Fit/BinData.h"
+#include "Fit/Chi2FCN.h"
+#include "Fit/Fitter.h"
+#include "Fit/LogLikelihoodFCN.h"
+#include "Fit/PoissonLikelihoodFCN.h"
+#include "Fit/UnBinData.h"
+#include "Math/WrappedParamFunction.h"
+#include "TRandom3.h"
+
+#include "gtest/gtest.h"
+
+#include <sys/wait.h>
+
+#include <cerrno>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace {
+
+double GausModel(const double *x, const double *p)
+{
+   const double t = (x[0] - p[1]) / p[2];
+   return p[0] * std::exp(-0.5 * t * t);
+}
+
+double GausPdf(const double *x, const double *p)
+{
+   const double t = (x[0] - p[0]) / p[1];
+   return std::exp(-0.5 * t * t) / (std::sqrt(2. * M_PI) * p[1]);
+}
+
+std::shared_ptr<ROOT::Fit::BinData> MakeBinData()
+{
+   auto data = std::make_shared<ROOT::Fit::BinData>(1000, 1);
+   TRandom3 rndm(111);
+   for (int i = 0; i < 1000; ++i) {
+      const double x = -5. + 0.01 * (i + 0.5);
+      const double p[3] = {100., 0.5, 1.2};
+      const double y = rndm.Poisson(GausModel(&x, p));
+      data->Add(x, y, y > 0 ? std::sqrt(y) : 1.);
+   }
+   return data;
+}
+
+std::shared_ptr<ROOT::Fit::UnBinData> MakeUnBinData()
+{
+   auto data = std::make_shared<ROOT::Fit::UnBinData>(10000, 1);
+   TRandom3 rndm(222);
+   for (int i = 0; i < 10000; ++i)
+      data->Add(rndm.Gaus(0.5, 1.2));
+   return data;
+}
+
+/// true if the process has no child processes left
+bool NoChildProcesses()
+{
+   return ::waitpid(-1, nullptr, WNOHANG) < 0 && errno == ECHILD;
+}
+
+std::shared_ptr<ROOT::Math::IParamMultiFunction> CloneModel(const ROOT::Math::IParamMultiFunction &func)
+{
+   return std::shared_ptr<ROOT::Math::IParamMultiFunction>(
+      dynamic_cast<ROOT::Math::IParamMultiFunction *>(func.Clone()));
+}
+
+/// compare the values of the sequential and the multi-process evaluations of an objective function,
+/// for several parameter values
+template <class FCN>
+void CompareFCN(const FCN &sequential, const FCN &multiProcess, const std::vector<std::vector<double>> &params)
+{
+   for (const auto &p : params) {
+      const double expected = sequential(p.data());
+      EXPECT_NEAR(expected, multiProcess(p.data()), 1.E-10 * std::abs(expected));
+   }
+   // the workers are started again after being terminated
+   multiProcess.TerminateWorkers();
+   EXPECT_TRUE(NoChildProcesses());
+   const double expected = sequential(params.front().data());
+   EXPECT_NEAR(expected, multiProcess(params.front().data()), 1.E-10 * std::abs(expected));
+   multiProcess.TerminateWorkers();
+}
+
+} // anonymous namespace
+
+TEST(FitMultiProcess, Chi2FCN)
+{
+   auto data = MakeBinData();
+   ROOT::Math::WrappedParamFunction<> func(&GausModel, 1, 3);
+   ROOT::Fit::Chi2Function sequential(data, CloneModel(func), ROOT::EExecutionPolicy::kSequential);
+   ROOT::Fit::Chi2Function multiProcess(data, CloneModel(func), ROOT::EExecutionPolicy::kMultiProcess);
+   CompareFCN(sequential, multiProcess, {{100., 0.5, 1.2}, {90., 0.4, 1.}, {110., 0.6, 1.5}});
+}
+
+TEST(FitMultiProcess, PoissonLikelihoodFCN)
+{
+   auto data = MakeBinData();
+   ROOT::Math::WrappedParamFunction<> func(&GausModel, 1, 3);
+   ROOT::Fit::PoissonLLFunction sequential(data, CloneModel(func), 0, true, ROOT::EExecutionPolicy::kSequential);
+   ROOT::Fit::PoissonLLFunction multiProcess(data, CloneModel(func), 0, true, ROOT::EExecutionPolicy::kMultiProcess);
+   CompareFCN(sequential, multiProcess, {{100., 0.5, 1.2}, {90., 0.4, 1.}, {110., 0.6, 1.5}});
+}
+
+TEST(FitMultiProcess, LogLikelihoodFCN)
+{
+   auto data = MakeUnBinData();
+   ROOT::Math::WrappedParamFunction<> func(&GausPdf, 1, 2);
+   ROOT::Fit::LogLikelihoodFunction sequential(data, CloneModel(func), 0, false, ROOT::EExecutionPolicy::kSequential);
+   ROOT::Fit::LogLikelihoodFunction multiProcess(data, CloneModel(func), 0, false,
+                                                 ROOT::EExecutionPolicy::kMultiProcess);
+   CompareFCN(sequential, multiProcess, {{0.5, 1.2}, {0.4, 1.}, {0.6, 1.5}});
+}
+
+// A fit with the multi-process policy gives the same result as the sequential fit and stops its workers
+TEST(FitMultiProcess, Fitter)
+{
+   auto data = MakeBinData();
+   double p0[3] = {80., 0., 1.};
+   ROOT::Math::WrappedParamFunction<> func(&GausModel, 1, 3, p0);
+
+   ROOT::Fit::Fitter sequential;
+   sequential.SetFunction(func, false);
+   ASSERT_TRUE(sequential.Fit(data, ROOT::EExecutionPolicy::kSequential));
+
+   ROOT::Fit::Fitter multiProcess;
+   multiProcess.SetFunction(func, false);
+   ASSERT_TRUE(multiProcess.Fit(data, ROOT::EExecutionPolicy::kMultiProcess));
+   EXPECT_TRUE(NoChildProcesses());
+
+   for (unsigned int i = 0; i < 3; ++i)
+      EXPECT_NEAR(sequential.Result().Parameter(i), multiProcess.Result().Parameter(i),
+                  1.E-2 * sequential.Result().ParError(i));
+}
@@ -35,6 +35,8 @@
 #include "TTimeStamp.h"
 #include "TVirtualMutex.h"
 
+#include <atomic>
+
 class TMessage;
 class THostAuth;
 
@@ -75,8 +77,8 @@ protected:
    TVirtualMutex *fLastUsageMtx;   // Protect last usage setting / reading
    TTimeStamp    fLastUsage;      // Time stamp of last usage
 
-   static ULong64_t fgBytesRecv;  // total bytes received by all socket objects
-   static ULong64_t fgBytesSent;  // total bytes sent by all socket objects
+   static std::atomic<ULong64_t> fgBytesRecv;  // total bytes received by all socket objects
+   static std::atomic<ULong64_t> fgBytesSent;  // total bytes sent by all socket objects
 
    static Int_t  fgClientProtocol; // client "protocol" version
 
@@ -26,6 +26,8 @@
 #include "TUrl.h"
 #include "TSystem.h"
 
+#include <vector>
+
 class TSocket;
 class TWebSocket;
 
@@ -39,6 +41,9 @@ private:
    TWebFile() : fSocket(nullptr) {}
 
 protected:
+   /// Outcome of RecvRanges10()
+   enum ERangesStatus { kRangesNotSent, kRangesRead, kRangesFullContent, kRangesFailed };
+
    mutable Long64_t  fSize;             // file size
    TSocket          *fSocket;           // socket for HTTP/1.1 (stays alive between calls)
    TUrl              fProxy;            // proxy URL
@@ -53,9 +58,14 @@ protected:
    TString           fBasicUrlOrg;      // save original url in case of temp redirection
    void             *fFullCache;        //! complete content of the file, some http server may return complete content
    Long64_t          fFullCacheSize;    //! size of the cached content
+   std::vector<TWebFile*> fConnections; //! additional connections to send range requests concurrently
+   Double_t          fLatency = 0;      //! estimated round-trip time of a request, in seconds
+   Double_t          fThroughput = 0;   //! estimated transfer rate of a connection, in bytes per second
+   Bool_t            fPartialContent = kFALSE; //! the server answered the last range request with partial content
 
    static TUrl       fgProxy;           // globally set proxy URL
    static Long64_t   fgMaxFullCacheSize; // maximal size of full-cached content, 500 MB by default
+   static Int_t      fgMaxConnections;  // maximal number of concurrent connections used by ReadBuffers(), 4 by default
 
            void        Init(Bool_t readHeadOnly) override;
    virtual void        CheckProxy();
@@ -71,6 +81,13 @@ protected:
    virtual Bool_t      ReadBuffers10(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf);
    virtual void        SetMsgReadBuffer10(const char *redirectLocation = nullptr, Bool_t tempRedirect = kFALSE);
    virtual void        ProcessHttpHeader(const TString& headerLine);
+           Bool_t      ReadRanges10(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf);
+           Bool_t      OpenSocket10();
+           Int_t       RecvRanges10(char *buf, Int_t len, const TString &msg, Long64_t &fullsize);
+           TWebFile   *GetConnection(Int_t i);
+           void        CloseConnections();
+           Long64_t    GetCoalesceGap() const;
+           void        UpdateLatency(Double_t seconds, Long64_t bytes);
 
 public:
    TWebFile(const char *url, Option_t *opt="");
@@ -92,6 +109,9 @@ public:
    static Long64_t    GetMaxFullCacheSize();
    static void        SetMaxFullCacheSize(Long64_t sz);
 
+   static Int_t       GetMaxConnections();
+   static void        SetMaxConnections(Int_t n);
+
    ClassDefOverride(TWebFile,2)  //A ROOT file that reads via a http server
 };
 
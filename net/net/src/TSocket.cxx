@@ -37,8 +37,8 @@
 #include "TProcessID.h"
 
 
-ULong64_t TSocket::fgBytesSent = 0;
-ULong64_t TSocket::fgBytesRecv = 0;
+std::atomic<ULong64_t> TSocket::fgBytesSent{0};
+std::atomic<ULong64_t> TSocket::fgBytesRecv{0};
 
 //
 // Client "protocol changes"
@@ -34,6 +34,11 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 #ifdef WIN32
 # ifndef EADDRINUSE
 #  define EADDRINUSE  10048
@@ -49,6 +54,15 @@ TUrl TWebFile::fgProxy;
 
 Long64_t TWebFile::fgMaxFullCacheSize = 500000000;
 
+Int_t TWebFile::fgMaxConnections = 4;
+
+namespace {
+/// Ranges are not coalesced across gaps larger than this, whatever the measured latency.
+constexpr Long64_t kMaxCoalesceGap = 4 * 1024 * 1024;
+/// Coalesced ranges are not made longer than this.
+constexpr Long64_t kMaxCoalescedRange = 64 * 1024 * 1024;
+}
+
 
 // Internal class used to manage the socket that may stay open between
 // calls when HTTP/1.1 protocol is used
@@ -198,6 +212,7 @@ TWebFile::TWebFile(TUrl url, Option_t *opt) : TFile(url.GetUrl(), "WEB"), fSocke
 
 TWebFile::~TWebFile()
 {
+   CloseConnections();
    delete fSocket;
    if (fFullCache) {
       free(fFullCache);
@@ -411,6 +426,7 @@ Int_t TWebFile::ReOpen(Option_t *mode)
 
 void TWebFile::Close(Option_t *option)
 {
+   CloseConnections();
    delete fSocket;
    fSocket = nullptr;
    if (fFullCache) {
@@ -567,9 +583,76 @@ Bool_t TWebFile::ReadBuffers10(char *buf,  Long64_t *pos, Int_t *len, Int_t nbuf
 {
    SetMsgReadBuffer10();
 
-   TString msg = fMsgReadBuffer10;
+   // Coalesce the ranges separated by less than what a connection transfers during one round trip:
+   // reading such a gap costs less than the latency of an additional range.
+   const Long64_t maxGap = GetCoalesceGap();
+   std::vector<Long64_t> rpos;
+   std::vector<Int_t> rlen;
+   if (maxGap > 0) {
+      for (Int_t i = 0; i < nbuf; i++) {
+         if (!rpos.empty()) {
+            const Long64_t end = rpos.back() + rlen.back();
+            if (pos[i] >= end && pos[i] - end <= maxGap && pos[i] + len[i] - rpos.back() <= kMaxCoalescedRange) {
+               rlen.back() = Int_t(pos[i] + len[i] - rpos.back());
+               continue;
+            }
+         }
+         rpos.push_back(pos[i]);
+         rlen.push_back(len[i]);
+      }
+   }
+   if (rpos.empty() || Int_t(rpos.size()) == nbuf)
+      return ReadRanges10(buf, pos, len, nbuf);
+
+   Long64_t total = 0;
+   for (auto l : rlen)
+      total += l;
+   std::vector<char> rbuf(total);
+   if (ReadRanges10(rbuf.data(), rpos.data(), rlen.data(), rpos.size()))
+      return kTRUE;
 
-   Int_t k = 0, n = 0, r, cnt = 0;
+   // Copy the requested ranges out of the coalesced ones, which hold them in the same order.
+   Long64_t k = 0, rstart = 0;
+   size_t r = 0;
+   for (Int_t i = 0; i < nbuf; i++) {
+      while (pos[i] < rpos[r] || pos[i] + len[i] > rpos[r] + rlen[r])
+         rstart += rlen[r++];
+      memcpy(&buf[k], &rbuf[rstart + pos[i] - rpos[r]], len[i]);
+      k += len[i];
+   }
+   return kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the nbuf byte ranges described by pos and len via HTTP 1.0 daemon, with
+/// at most 200 ranges per request. Once the server has answered a range request
+/// with partial content and keeps its connections open, the requests are spread
+/// over up to GetMaxConnections() connections to the server and sent
+/// concurrently, so that reading many ranges from a high-latency server is not
+/// bound by its round trip.
+/// Returns kTRUE in case of failure.
+
+Bool_t TWebFile::ReadRanges10(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
+{
+   struct RRequest {
+      Int_t fFirst;       // index of the first range
+      Int_t fCount;       // number of ranges
+      Long64_t fOffset;   // offset of the first range in buf
+      Int_t fLen;         // total length of the ranges
+      TString fMsg;       // HTTP request
+      Int_t fStatus = kRangesNotSent;
+      Double_t fStart = 0;    // start time, for gPerfStats
+      Double_t fSeconds = 0;
+   };
+
+   // With several connections, split the ranges over at least as many requests.
+   Int_t nconn = (fFullCache || !fPartialContent || !fHTTP11) ? 1 : std::max(1, fgMaxConnections);
+   const Int_t maxCount = std::min(200, std::max(1, (nbuf + nconn - 1) / nconn));
+
+   std::vector<RRequest> requests;
+   TString msg = fMsgReadBuffer10;
+   Int_t n = 0, cnt = 0;
+   Long64_t k = 0;
    for (Int_t i = 0; i < nbuf; i++) {
       if (n) msg += ",";
       msg += pos[i] + fArchiveOffset;
@@ -577,11 +660,9 @@ Bool_t TWebFile::ReadBuffers10(char *buf,  Long64_t *pos, Int_t *len, Int_t nbuf
       msg += pos[i] + fArchiveOffset + len[i] - 1;
       n   += len[i];
       cnt++;
-      if ((msg.Length() > 8000) || (cnt >= 200) || (i+1 == nbuf)) {
+      if ((msg.Length() > 8000) || (cnt >= maxCount) || (i+1 == nbuf)) {
          msg += "\r\n\r\n";
-         r = GetFromWeb10(&buf[k], n, msg, cnt, pos + (i+1-cnt), len + (i+1-cnt));
-         if (r == -1)
-            return kTRUE;
+         requests.push_back({i + 1 - cnt, cnt, k, n, msg});
          msg = fMsgReadBuffer10;
          k += n;
          n = 0;
@@ -589,9 +670,290 @@ Bool_t TWebFile::ReadBuffers10(char *buf,  Long64_t *pos, Int_t *len, Int_t nbuf
       }
    }
 
+   // The sockets of all the connections are opened here: the worker threads only send and receive over them, and
+   // leave reporting and statistics to this thread.
+   nconn = std::min<Int_t>(nconn, requests.size());
+   std::vector<TWebFile *> conns;
+   for (Int_t c = 0; c < nconn && nconn > 1; c++) {
+      TWebFile *conn = c == 0 ? this : GetConnection(c);
+      if (!conn || !conn->OpenSocket10())
+         break;
+      conns.push_back(conn);
+   }
+   nconn = conns.size();
+
+   if (nconn > 1) {
+      // Connection c sends the requests c, c + nconn, c + 2 * nconn, ... A server that answers with the complete
+      // file cancels the requests not sent yet: it would send the complete file for each of them. The first
+      // complete file received is kept as the full cache, from which all the remaining ranges are then read.
+      std::atomic<bool> cancel{false};
+      void *fullCache = nullptr;
+      Long64_t fullCacheSize = 0;
+      auto sendRequests = [&](Int_t c) {
+         for (size_t j = c; j < requests.size() && !cancel; j += nconn) {
+            RRequest &req = requests[j];
+            if (gPerfStats)
+               req.fStart = TTimeStamp();
+            const auto start = std::chrono::steady_clock::now();
+            Long64_t fullsize = 0;
+            req.fStatus = conns[c]->RecvRanges10(&buf[req.fOffset], req.fLen, req.fMsg, fullsize);
+            req.fSeconds = std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count();
+            if (req.fStatus == kRangesFullContent && !cancel.exchange(true) && fullsize > 0 &&
+                fullsize <= std::min<Long64_t>(GetMaxFullCacheSize(), kMaxInt)) {
+               fullCache = malloc(fullsize);
+               if (fullCache && conns[c]->fSocket->RecvRaw(fullCache, Int_t(fullsize)) == fullsize) {
+                  fullCacheSize = fullsize;
+               } else {
+                  free(fullCache);
+                  fullCache = nullptr;
+               }
+            }
+            if (req.fStatus != kRangesRead)
+               break;
+         }
+      };
+
+      std::vector<std::thread> threads;
+      for (Int_t c = 1; c < nconn; c++)
+         threads.emplace_back(sendRequests, c);
+      sendRequests(0);
+      for (auto &t : threads)
+         t.join();
+
+      for (size_t j = 0; j < requests.size(); j++) {
+         const RRequest &req = requests[j];
+         if (req.fStatus == kRangesRead) {
+            UpdateLatency(req.fSeconds, req.fLen);
+            fBytesRead += req.fLen;
+            fReadCalls++;
+#ifdef R__WIN32
+            SetFileBytesRead(GetFileBytesRead() + req.fLen);
+            SetFileReadCalls(GetFileReadCalls() + 1);
+#else
+            fgBytesRead += req.fLen;
+            fgReadCalls++;
+#endif
+            if (gPerfStats)
+               gPerfStats->FileReadEvent(this, req.fLen, req.fStart);
+         } else if (req.fStatus != kRangesNotSent) {
+            // The answer may not have been fully read: the connection cannot be reused
+            TWebFile *conn = conns[j % nconn];
+            delete conn->fSocket;
+            conn->fSocket = nullptr;
+            if (req.fStatus == kRangesFullContent)
+               fPartialContent = kFALSE;
+         }
+      }
+      if (!fPartialContent)
+         Warning("ReadBuffers", "server %s responded with the complete file to a range request", fUrl.GetHost());
+      if (fullCache && !fFullCache) {
+         fFullCache = fullCache;
+         fFullCacheSize = fullCacheSize;
+      } else {
+         free(fullCache);
+      }
+   }
+
+   // Requests not sent or not answered as expected are sent (again) from this thread, which handles redirections,
+   // complete-file answers and errors.
+   for (auto &req : requests) {
+      if (req.fStatus == kRangesRead)
+         continue;
+      const auto start = std::chrono::steady_clock::now();
+      if (GetFromWeb10(&buf[req.fOffset], req.fLen, req.fMsg, req.fCount, pos + req.fFirst, len + req.fFirst) ==
+          -1)
+         return kTRUE;
+      const Double_t seconds = std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count();
+      if (!fFullCache)
+         UpdateLatency(seconds, req.fLen);
+   }
    return kFALSE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Open the socket to the server, if needed, for use by a worker thread of
+/// ReadRanges10(). Returns kFALSE if it cannot be opened, or if the server
+/// does not keep connections open between requests.
+
+Bool_t TWebFile::OpenSocket10()
+{
+   if (!fHTTP11)
+      return kFALSE;
+   TWebSocket ws(this);
+   if (fSocket && !fSocket->IsValid())
+      ws.ReOpen();
+   return fSocket && fSocket->IsValid();
+}
+
+namespace {
+////////////////////////////////////////////////////////////////////////////////
+/// Receive a line from s into line, without its terminator. Returns the length
+/// of the line, or -1 in case of error or if it is longer than maxsize - 1.
+
+Int_t RecvLine(TSocket *s, char *line, Int_t maxsize)
+{
+   Int_t tail = 0;
+   while (tail < maxsize - 1) {
+      const Int_t pklen = s->RecvRaw(line + tail, maxsize - 1 - tail, kPeek);
+      if (pklen <= 0)
+         return -1;
+      const char *nl = (const char *)memchr(line + tail, '\n', pklen);
+      const Int_t remain = nl ? Int_t(nl - (line + tail)) + 1 : pklen;
+      if (s->RecvRaw(line + tail, remain) != remain)
+         return -1;
+      tail += remain;
+      if (nl) {
+         Int_t n = tail - 1;
+         if (n > 0 && line[n-1] == '\r')
+            n--;
+         line[n] = '\0';
+         return n;
+      }
+   }
+   return -1;
+}
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Send the range request msg over the open socket and receive the len bytes
+/// of the ranges into buf. Used by the worker threads of ReadRanges10(): it
+/// neither opens nor closes the socket, reports nothing and collects no
+/// statistics. Returns kRangesRead on success, kRangesFullContent if the server
+/// answered with the complete file, of which fullsize is set to the length,
+/// and kRangesFailed for any other answer, which GetFromWeb10() then has to
+/// handle. In these two cases the body of the answer is not read.
+
+Int_t TWebFile::RecvRanges10(char *buf, Int_t len, const TString &msg, Long64_t &fullsize)
+{
+   if (fSocket->SendRaw(msg.Data(), msg.Length()) != msg.Length())
+      return kRangesFailed;
+
+   char line[8192];
+   Int_t n, ltot = 0;
+   Bool_t partial = kFALSE, full = kFALSE;
+   TString boundary, boundaryEnd;
+   Long64_t first = -1, last = -1, tot;
+
+   while ((n = RecvLine(fSocket, line, sizeof(line))) >= 0) {
+      if (n == 0) {
+         if (full)
+            return kRangesFullContent;
+         if (!partial)
+            return kRangesFailed;
+         if (first >= 0) {
+            const Long64_t ll = last - first + 1;
+            if (ll <= 0 || ltot + ll > len || fSocket->RecvRaw(&buf[ltot], Int_t(ll)) != ll)
+               return kRangesFailed;
+            ltot += Int_t(ll);
+            first = -1;
+            if (boundary == "")
+               break;  // not a multipart response
+         }
+         continue;
+      }
+
+      if (boundaryEnd == line)
+         break;
+
+      TString res = line;
+      if (res.BeginsWith("HTTP/1.")) {
+         TString scode = res(9, 3);
+         const Int_t code = scode.Atoi();
+         if (code == 200)
+            full = kTRUE;
+         else if (code == 206)
+            partial = kTRUE;
+         else
+            return kRangesFailed;
+      } else if (full && res.BeginsWith("Content-Length:", TString::kIgnoreCase)) {
+#ifdef R__WIN32
+         sscanf(res.Data() + 15, "%I64d", &fullsize);
+#else
+         sscanf(res.Data() + 15, "%lld", &fullsize);
+#endif
+      } else if (res.BeginsWith("Content-Type: multipart")) {
+         boundary = res(res.Index("boundary=")+9, 1000);
+         if (boundary[0]=='"' && boundary[boundary.Length()-1]=='"') {
+            boundary = boundary(1,boundary.Length()-2);
+         }
+         boundary = "--" + boundary;
+         boundaryEnd = boundary + "--";
+      } else if (res.BeginsWith("Content-Range:", TString::kIgnoreCase)) {
+#ifdef R__WIN32
+         if (sscanf(res.Data() + 14, " bytes %I64d-%I64d/%I64d", &first, &last, &tot) != 3)
+#else
+         if (sscanf(res.Data() + 14, " bytes %lld-%lld/%lld", &first, &last, &tot) != 3)
+#endif
+            return kRangesFailed;
+      }
+   }
+
+   return ltot == len ? kRangesRead : kRangesFailed;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the i-th additional connection to the server (starting at 1), opening
+/// it if needed. Returns nullptr if the connection cannot be opened.
+
+TWebFile *TWebFile::GetConnection(Int_t i)
+{
+   while ((Int_t)fConnections.size() < i) {
+      TString opt = "HEADONLY_WITHOUT_GLOBALREGISTRATION";
+      if (fNoProxy)
+         opt += " NOPROXY";
+      TWebFile *conn = new TWebFile(fUrl.GetUrl(), opt);
+      if (conn->IsZombie() || conn->fWritten < 0) {
+         delete conn;
+         return nullptr;
+      }
+      conn->fArchiveOffset = fArchiveOffset;
+      fConnections.push_back(conn);
+   }
+   return fConnections[i - 1];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Close the additional connections to the server.
+
+void TWebFile::CloseConnections()
+{
+   for (auto conn : fConnections)
+      delete conn;
+   fConnections.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the largest gap between two ranges for which it is faster to read
+/// the gap than to request the ranges separately, i.e. the number of bytes a
+/// connection transfers during one round trip. Returns 0 until the latency and
+/// throughput of the server have been measured.
+
+Long64_t TWebFile::GetCoalesceGap() const
+{
+   if (fLatency <= 0 || fThroughput <= 0)
+      return 0;
+   return std::min(kMaxCoalesceGap, Long64_t(fLatency * fThroughput));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Update the estimates of the latency and throughput of the server with a
+/// request of `bytes` bytes that took `seconds`. The latency follows the
+/// fastest requests, the throughput is measured on the time the requests take
+/// beyond the latency.
+
+void TWebFile::UpdateLatency(Double_t seconds, Long64_t bytes)
+{
+   if (fLatency <= 0)
+      fLatency = seconds;
+   else
+      fLatency = std::min(seconds, 0.9 * fLatency + 0.1 * seconds);
+
+   if (seconds > 2 * fLatency) {
+      const Double_t rate = bytes / (seconds - fLatency);
+      fThroughput = fThroughput <= 0 ? rate : 0.8 * fThroughput + 0.2 * rate;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Extract requested segments from the cached content.
 /// Such cache can be produced when server suddenly returns full data instead of segments
@@ -900,8 +1262,11 @@ Int_t TWebFile::GetFromWeb10(char *buf, Int_t len, const TString &msg, Int_t nse
                ret = -1;
                TString mess = res(13, 1000);
                Error("GetFromWeb10", "%s: %s (%d)", fBasicUrl.Data(), mess.Data(), code);
+            } else {
+               fPartialContent = kTRUE;
             }
          } else if (code == 200) {
+            fPartialContent = kFALSE;
             fullsize = -200; // make indication of code 200
             Warning("GetFromWeb10",
                     "Server %s response with complete file, but only part of it was requested.\n"
@@ -1451,6 +1816,25 @@ void TWebFile::SetMaxFullCacheSize(Long64_t sz)
    fgMaxFullCacheSize = sz;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Static method returning the maximal number of connections a TWebFile opens
+/// to the server to send the range requests of ReadBuffers() concurrently.
+
+Int_t TWebFile::GetMaxConnections()
+{
+   return fgMaxConnections;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Static method, set the maximal number of connections a TWebFile opens to
+/// the server to send the range requests of ReadBuffers() concurrently.
+/// 1 sends all the requests one after the other over a single connection.
+
+void TWebFile::SetMaxConnections(Int_t n)
+{
+   fgMaxConnections = n;
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Create helper class that allows directory access via httpd.
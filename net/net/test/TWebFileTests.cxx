@@ -0,0 +1,259 @@
+#include "TFile.h"
+#include "TNamed.h"
+#include "TWebFile.h"
+
+#include "gtest/gtest.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// A minimal HTTP/1.1 server on localhost, serving one file with keep-alive connections. It answers range requests
+/// with partial content, or with the complete file if told to ignore ranges.
+class RRangeServer {
+   std::string fContent;
+   int fListenFd = -1;
+   int fPort = 0;
+   std::thread fAcceptThread;
+   std::mutex fMutex;
+   std::vector<std::thread> fThreads;
+   std::vector<int> fFds;
+   std::atomic<bool> fIgnoreRanges{false};
+   std::atomic<int> fNFullAnswers{0};
+   std::atomic<int> fNRangeConnections{0};
+
+   static bool SendAll(int fd, const std::string &data)
+   {
+      for (std::size_t sent = 0; sent < data.size();) {
+         const auto n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+         if (n <= 0)
+            return false;
+         sent += n;
+      }
+      return true;
+   }
+
+   std::string ContentRange(long long first, long long last) const
+   {
+      return "Content-Range: bytes " + std::to_string(first) + "-" + std::to_string(last) + "/" +
+             std::to_string(fContent.size()) + "\r\n";
+   }
+
+   std::string Answer(const std::string &head, bool &rangeConnection)
+   {
+      const std::string full = "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(fContent.size()) + "\r\n\r\n";
+      if (head.compare(0, 4, "HEAD") == 0)
+         return full;
+
+      const auto rangePos = head.find("Range: bytes=");
+      if (rangePos == std::string::npos || fIgnoreRanges) {
+         ++fNFullAnswers;
+         return full + fContent;
+      }
+      if (!rangeConnection) {
+         rangeConnection = true;
+         ++fNRangeConnections;
+      }
+
+      std::vector<std::pair<long long, long long>> ranges;
+      std::istringstream spec(head.substr(rangePos + 13, head.find("\r\n", rangePos) - rangePos - 13));
+      long long first, last;
+      char dash, comma;
+      while (spec >> first >> dash >> last) {
+         ranges.emplace_back(first, last);
+         spec >> comma;
+      }
+
+      if (ranges.size() == 1) {
+         return "HTTP/1.1 206 Partial Content\r\n" + ContentRange(first, last) +
+                "Content-Length: " + std::to_string(last - first + 1) + "\r\n\r\n" +
+                fContent.substr(first, last - first + 1);
+      }
+      std::string body;
+      for (const auto &r : ranges) {
+         body += "\r\n--RANGESEPARATOR\r\nContent-Type: application/octet-stream\r\n" +
+                 ContentRange(r.first, r.second) + "\r\n" + fContent.substr(r.first, r.second - r.first + 1);
+      }
+      body += "\r\n--RANGESEPARATOR--\r\n";
+      return "HTTP/1.1 206 Partial Content\r\nContent-Type: multipart/byteranges; boundary=RANGESEPARATOR\r\n"
+             "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+   }
+
+   void Serve(int fd)
+   {
+      std::string received;
+      bool rangeConnection = false;
+      while (true) {
+         std::size_t end;
+         while ((end = received.find("\r\n\r\n")) == std::string::npos) {
+            char buf[4096];
+            const auto n = recv(fd, buf, sizeof(buf), 0);
+            if (n <= 0)
+               return;
+            received.append(buf, n);
+         }
+         const std::string head = received.substr(0, end);
+         received.erase(0, end + 4);
+         if (!SendAll(fd, Answer(head, rangeConnection)))
+            return;
+      }
+   }
+
+public:
+   explicit RRangeServer(std::string content) : fContent(std::move(content))
+   {
+      fListenFd = socket(AF_INET, SOCK_STREAM, 0);
+      sockaddr_in addr{};
+      addr.sin_family = AF_INET;
+      addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      addr.sin_port = 0;
+      socklen_t addrlen = sizeof(addr);
+      if (bind(fListenFd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 || listen(fListenFd, 16) != 0 ||
+          getsockname(fListenFd, reinterpret_cast<sockaddr *>(&addr), &addrlen) != 0)
+         return;
+      fPort = ntohs(addr.sin_port);
+      fAcceptThread = std::thread([this] {
+         int fd;
+         while ((fd = accept(fListenFd, nullptr, nullptr)) >= 0) {
+            std::lock_guard<std::mutex> lock(fMutex);
+            fFds.push_back(fd);
+            fThreads.emplace_back(&RRangeServer::Serve, this, fd);
+         }
+      });
+   }
+
+   ~RRangeServer()
+   {
+      shutdown(fListenFd, SHUT_RDWR);
+      close(fListenFd);
+      if (fAcceptThread.joinable())
+         fAcceptThread.join();
+      for (auto fd : fFds)
+         shutdown(fd, SHUT_RDWR);
+      for (auto &t : fThreads)
+         t.join();
+      for (auto fd : fFds)
+         close(fd);
+   }
+
+   std::string GetUrl(const char *file) const { return "http://127.0.0.1:" + std::to_string(fPort) + "/" + file; }
+   void SetIgnoreRanges(bool ignore) { fIgnoreRanges = ignore; }
+   int GetNFullAnswers() const { return fNFullAnswers; }
+   int GetNRangeConnections() const { return fNRangeConnections; }
+};
+
+/// Write a small ROOT file and return its content
+std::string MakeRootFile(const char *filename)
+{
+   {
+      TFile f(filename, "RECREATE");
+      unsigned int seed = 1;
+      for (int i = 0; i < 100; ++i) {
+         // titles that do not compress much
+         std::string title(300, ' ');
+         for (auto &c : title) {
+            seed = seed * 1103515245 + 12345;
+            c = 'a' + (seed >> 16) % 26;
+         }
+         TNamed named(("named" + std::to_string(i)).c_str(), title.c_str());
+         named.Write();
+      }
+   }
+   std::ifstream in(filename, std::ios::binary);
+   std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+   std::remove(filename);
+   return content;
+}
+
+/// nbuf ranges of 2 bytes spread through the content
+void MakeRanges(const std::string &content, int nbuf, std::vector<Long64_t> &pos, std::vector<Int_t> &len)
+{
+   const Long64_t stride = content.size() / nbuf;
+   ASSERT_GE(stride, 4);
+   for (int i = 0; i < nbuf; ++i) {
+      pos.push_back(i * stride);
+      len.push_back(2);
+   }
+}
+
+void CheckRanges(const std::string &content, const std::vector<char> &buf, const std::vector<Long64_t> &pos,
+                 const std::vector<Int_t> &len)
+{
+   std::size_t k = 0;
+   for (std::size_t i = 0; i < pos.size(); ++i) {
+      EXPECT_EQ(content.substr(pos[i], len[i]), std::string(&buf[k], len[i])) << "range " << i;
+      k += len[i];
+   }
+}
+
+struct MaxConnectionsRAII {
+   Int_t fOld = TWebFile::GetMaxConnections();
+   explicit MaxConnectionsRAII(Int_t n) { TWebFile::SetMaxConnections(n); }
+   ~MaxConnectionsRAII() { TWebFile::SetMaxConnections(fOld); }
+};
+
+} // anonymous namespace
+
+TEST(TWebFile, ConcurrentRanges)
+{
+   const std::string content = MakeRootFile("twebfile_concurrent.root");
+   RRangeServer server(content);
+   MaxConnectionsRAII maxConnections(4);
+
+   TWebFile f(server.GetUrl("twebfile_concurrent.root").c_str(), "NOPROXY");
+   ASSERT_FALSE(f.IsZombie());
+
+   std::vector<Long64_t> pos;
+   std::vector<Int_t> len;
+   MakeRanges(content, 1000, pos, len);
+   std::vector<char> buf(2 * pos.size());
+   ASSERT_FALSE(f.ReadBuffers(buf.data(), pos.data(), len.data(), pos.size()));
+   CheckRanges(content, buf, pos, len);
+
+   EXPECT_GT(server.GetNRangeConnections(), 1);
+   EXPECT_EQ(0, server.GetNFullAnswers());
+}
+
+TEST(TWebFile, ConcurrentRangesIgnored)
+{
+   const std::string content = MakeRootFile("twebfile_ignored.root");
+   RRangeServer server(content);
+   MaxConnectionsRAII maxConnections(4);
+
+   TWebFile f(server.GetUrl("twebfile_ignored.root").c_str(), "NOPROXY");
+   ASSERT_FALSE(f.IsZombie());
+
+   // From now on, the server sends the complete file: more than one request per connection
+   std::vector<Long64_t> pos;
+   std::vector<Int_t> len;
+   MakeRanges(content, 2000, pos, len);
+   std::vector<char> buf(2 * pos.size());
+   server.SetIgnoreRanges(true);
+   ASSERT_FALSE(f.ReadBuffers(buf.data(), pos.data(), len.data(), pos.size()));
+   CheckRanges(content, buf, pos, len);
+
+   // At most the requests sent concurrently got the complete file, the others were not sent
+   EXPECT_GE(server.GetNFullAnswers(), 1);
+   EXPECT_LE(server.GetNFullAnswers(), TWebFile::GetMaxConnections());
+
+   // The complete file is cached: nothing more is requested
+   const int nFullAnswers = server.GetNFullAnswers();
+   std::fill(buf.begin(), buf.end(), 0);
+   ASSERT_FALSE(f.ReadBuffers(buf.data(), pos.data(), len.data(), pos.size()));
+   CheckRanges(content, buf, pos, len);
+   EXPECT_EQ(nFullAnswers, server.GetNFullAnswers());
+}
@@ -57,8 +57,8 @@ static XrdSysLogger eLogger;
 static XrdSysError eDest(0, "Proofx");
 
 #ifdef WIN32
-ULong64_t TSocket::fgBytesSent;
-ULong64_t TSocket::fgBytesRecv;
+std::atomic<ULong64_t> TSocket::fgBytesSent;
+std::atomic<ULong64_t> TSocket::fgBytesRecv;
 #endif
 
 //______________________________________________________________________________
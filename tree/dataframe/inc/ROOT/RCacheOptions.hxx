@@ -0,0 +1,35 @@
+/*************************************************************************
+ * Copyright (C) 1995-2023, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RCACHEOPTIONS
+#define ROOT_RCACHEOPTIONS
+
+#include <Compression.h>
+#include <RtypesCore.h> // ULong64_t
+
+#include <string>
+
+namespace ROOT {
+
+namespace RDF {
+/// A collection of options to steer the behaviour of Cache
+struct RCacheOptions {
+   using ECAlgo = ROOT::ECompressionAlgorithm;
+   /// Maximum number of bytes the cached columns are allowed to occupy in memory. If the estimated size of the
+   /// cached dataset exceeds this value, the columns are spilled to a temporary file on local disk instead.
+   /// A value of 0 means no limit, i.e. the dataset is always cached in memory.
+   ULong64_t fMemoryBudget = 0;
+   /// Directory in which the spill file is created. If empty, the system's temporary directory is used.
+   std::string fSpillDirectory;
+   ECAlgo fCompressionAlgorithm = ROOT::kLZ4; ///< Compression algorithm of the spill file
+   int fCompressionLevel = 1;                 ///< Compression level of the spill file
+};
+} // ns RDF
+} // ns ROOT
+
+#endif
@@ -16,7 +16,6 @@
 
 #include <cstdint>
 #include <deque>
-#include <list>
 #include <unordered_map>
 #include <set>
 #include <memory>
@@ -48,14 +47,21 @@ private:
    std::unique_ptr<ROOT::Internal::RRawFile> fCsvFile;
    const char fDelimiter;
    const Long64_t fLinesChunkSize;
-   ULong64_t fEntryRangesRequested = 0ULL;
    ULong64_t fProcessedLines = 0ULL; // marks the progress of the consumption of the csv lines
+   ULong64_t fChunkFirstEntry = 0ULL; // entry number of the first record held in the column buffers
+   ULong64_t fNRecords = 0ULL;        // number of records held in the column buffers
    std::vector<std::string> fHeaders; // the column names
    std::unordered_map<std::string, ColType_t> fColTypes;
    std::set<std::string> fColContainingEmpty; // store columns which had empty entry
-   std::list<ColType_t> fColTypesList; // column types, order is the same as fHeaders, values the same as fColTypes
+   std::vector<ColType_t> fColTypesList; // column types, order is the same as fHeaders, values the same as fColTypes
    std::vector<std::vector<void *>> fColAddresses;         // fColAddresses[column][slot] (same ordering as fHeaders)
-   std::vector<Record_t> fRecords;                         // fRecords[entry][column] (same ordering as fHeaders)
+   // Columnar buffers for the records of the current chunk: fXColumns[column][record] (same ordering as fHeaders).
+   // Only the buffer matching the type of the column is filled.
+   std::vector<std::vector<double>> fDoubleColumns;
+   std::vector<std::vector<Long64_t>> fLong64Columns;
+   std::vector<std::vector<std::string>> fStringColumns;
+   // Not vector<bool>: different records are filled concurrently by different threads
+   std::vector<std::vector<std::uint8_t>> fBoolColumns;
    std::vector<std::vector<double>> fDoubleEvtValues;      // one per column per slot
    std::vector<std::vector<Long64_t>> fLong64EvtValues;    // one per column per slot
    std::vector<std::vector<std::string>> fStringEvtValues; // one per column per slot
@@ -64,7 +70,9 @@ private:
    std::vector<std::deque<bool>> fBoolEvtValues; // one per column per slot
 
    void FillHeaders(const std::string &);
-   void FillRecord(const std::string &, Record_t &);
+   void FillRecord(const std::string &, std::size_t, std::set<std::string> &);
+   void ReadChunk(std::string &);
+   void ParseChunk(const std::string &, std::size_t, std::size_t, std::size_t, std::set<std::string> &);
    void GenerateHeaders(size_t);
    std::vector<void *> GetColumnReadersImpl(std::string_view, const std::type_info &) final;
    void ValidateColTypes(std::vector<std::string> &) const;
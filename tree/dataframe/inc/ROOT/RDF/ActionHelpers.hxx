@@ -37,6 +37,7 @@
 #include "TError.h" // for R__ASSERT, Warning
 #include "TFile.h" // for SnapshotHelper
 #include "TH1.h"
+#include "TH1ConcurrentFill.h"
 #include "TGraph.h"
 #include "TGraphAsymmErrors.h"
 #include "TLeaf.h"
@@ -59,6 +60,13 @@
 #include <iomanip>
 #include <numeric> // std::accumulate in MeanHelper
 
+class TH2;
+class TH2Poly;
+class TH3;
+class TProfile;
+class TProfile2D;
+class TProfile3D;
+
 /// \cond HIDDEN_SYMBOLS
 
 namespace ROOT {
@@ -339,11 +347,53 @@ public:
    }
 };
 
+/// Return the number of histogram cells times the number of processing slots above which FillHelper fills a single
+/// histogram shared by all slots rather than one clone per slot. Set via the `RDataFrame.SharedFillThreshold` rootrc
+/// entry; a non-positive value disables shared filling.
+double GetSharedFillThreshold();
+
 /// The generic Fill helper: it calls Fill on per-thread objects and then Merge to produce a final result.
 /// For one-dimensional histograms, if no axes are specified, RDataFrame uses BufferedFillHelper instead.
+///
+/// For histograms so large that one clone per slot would be too expensive (see GetSharedFillThreshold()), all slots
+/// fill the same histogram through a TH1ConcurrentFillManager instead, so that no clones and no final merge are needed.
+/// This requires a TH1, TH2 or TH3 (not a profile) filled with numerical values, see CanFillShared().
 template <typename HIST = Hist_t>
 class R__CLING_PTRCHECK(off) FillHelper : public RActionImpl<FillHelper<HIST>> {
    std::vector<HIST *> fObjects;
+   bool fCanFillShared = false; ///< Whether the filled columns allow all slots to fill fObjects[0]
+   std::unique_ptr<TH1ConcurrentFillManager> fFillManager; ///< Manager of fObjects[0] if shared by all slots
+   std::vector<TH1ConcurrentFiller> fFillers;              ///< Per-slot fillers of fObjects[0] if shared by all slots
+
+   /// Return the number of axes of HIST if it can be filled through TH1ConcurrentFillManager, 0 otherwise.
+   static constexpr int GetSharedFillDim()
+   {
+      if constexpr (std::is_base_of<TH2Poly, HIST>::value)
+         return 0;
+      else
+         return GetFillNDim();
+   }
+
+   template <typename T, bool = IsDataContainer<T>::value>
+   struct IsNumericFillArg : std::is_arithmetic<T> {
+   };
+
+   template <typename T>
+   struct IsNumericFillArg<T, true> : std::is_arithmetic<typename T::value_type> {
+   };
+
+   template <typename... Vals>
+   void DoFill(unsigned int slot, const Vals &...vals)
+   {
+      if constexpr (CanFillShared<Vals...>()) {
+         if (fFillManager) {
+            const double args[] = {static_cast<double>(vals)...};
+            fFillers[slot].Fill(args, sizeof...(Vals) > GetSharedFillDim() ? args[sizeof...(Vals) - 1] : 1.);
+            return;
+         }
+      }
+      fObjects[slot]->Fill(vals...);
+   }
 
    template <typename H = HIST, typename = decltype(std::declval<H>().Reset())>
    void ResetIfPossible(H *h)
@@ -441,25 +491,99 @@ class R__CLING_PTRCHECK(off) FillHelper : public RActionImpl<FillHelper<HIST>> {
 #endif
    }
 
+   /// Return the number of axes of HIST if it can be filled through the bulk TH1/TH2/TH3::FillN methods, 0 otherwise.
+   /// Profiles are excluded, as their FillN methods (if any) take the profiled values rather than the weights.
+   static constexpr int GetFillNDim()
+   {
+      if constexpr (std::is_base_of<TProfile, HIST>::value || std::is_base_of<TProfile2D, HIST>::value ||
+                    std::is_base_of<TProfile3D, HIST>::value)
+         return 0;
+      else if constexpr (std::is_base_of<TH3, HIST>::value)
+         return 3;
+      else if constexpr (std::is_base_of<TH2, HIST>::value)
+         return 2;
+      else if constexpr (std::is_base_of<TH1, HIST>::value)
+         return 1;
+      else
+         return 0;
+   }
+
+   template <typename T>
+   using IsDoubleArray = std::disjunction<std::is_same<T, RVec<double>>, std::is_same<T, std::vector<double>>>;
+
+   /// Whether Fill arguments of types Xs can be passed to a single FillN call: one array of doubles per axis,
+   /// optionally followed by an array of weights
+   template <typename... Xs>
+   static constexpr bool CanFillN()
+   {
+      constexpr int dim = GetFillNDim();
+      return dim > 0 && (sizeof...(Xs) == dim || sizeof...(Xs) == dim + 1) &&
+             std::conjunction<IsDoubleArray<Xs>...>::value;
+   }
+
+   template <typename... Xs>
+   void ExecFillN(unsigned int slot, std::size_t n, const Xs &...xs)
+   {
+      constexpr int dim = GetFillNDim();
+      const double *vals[] = {xs.data()...};
+      const double *w = nullptr;
+      if constexpr (sizeof...(Xs) > dim)
+         w = vals[dim];
+
+      HIST *h = fObjects[slot];
+      if constexpr (dim == 1)
+         h->FillN(n, vals[0], w);
+      else if constexpr (dim == 2)
+         h->FillN(n, vals[0], vals[1], w);
+      else
+         h->FillN(n, vals[0], vals[1], vals[2], w);
+   }
+
    template <std::size_t ColIdx, typename End_t, typename... Its>
    void ExecLoop(unsigned int slot, End_t end, Its... its)
    {
-      auto *thisSlotH = fObjects[slot];
       // loop increments all of the iterators while leaving scalars unmodified
       // TODO this could be simplified with fold expressions or std::apply in C++17
       auto nop = [](auto &&...) {};
       for (; GetNthElement<ColIdx>(its...) != end; nop(++its...)) {
-         thisSlotH->Fill(*its...);
+         DoFill(slot, *its...);
       }
    }
 
 public:
+   /// Whether the histogram can be shared by all slots when filled from columns of types ColTypes: each Fill call
+   /// must take one number per axis, optionally followed by a weight (filling by bin label is not supported by
+   /// TH1ConcurrentFillManager). Columns holding collections are filled element by element.
+   template <typename... ColTypes>
+   static constexpr bool CanFillShared()
+   {
+      constexpr int dim = GetSharedFillDim();
+      return dim > 0 && (sizeof...(ColTypes) == dim || sizeof...(ColTypes) == dim + 1) &&
+             std::conjunction<IsNumericFillArg<ColTypes>...>::value;
+   }
+
    FillHelper(FillHelper &&) = default;
    FillHelper(const FillHelper &) = delete;
 
-   FillHelper(const std::shared_ptr<HIST> &h, const unsigned int nSlots) : fObjects(nSlots, nullptr)
+   /// If canFillShared is true (see CanFillShared()) and the histogram is large enough, the slots fill it concurrently
+   /// instead of filling one clone each.
+   FillHelper(const std::shared_ptr<HIST> &h, const unsigned int nSlots, bool canFillShared = false)
+      : fObjects(nSlots, nullptr), fCanFillShared(canFillShared)
    {
       fObjects[0] = h.get();
+
+      if constexpr (GetSharedFillDim() > 0) {
+         const auto threshold = GetSharedFillThreshold();
+         if (canFillShared && nSlots > 1 && threshold > 0. && double(h->GetNcells()) * nSlots > threshold) {
+            fFillManager = std::make_unique<TH1ConcurrentFillManager>(*h);
+            fFillers.reserve(nSlots);
+            for (unsigned int i = 0; i < nSlots; ++i)
+               fFillers.emplace_back(fFillManager->MakeFiller());
+            std::fill(fObjects.begin(), fObjects.end(), fObjects[0]);
+            return;
+         }
+      }
+
       // Initialize all other slots
       for (unsigned int i = 1; i < nSlots; ++i) {
          fObjects[i] = new HIST(*fObjects[0]);
@@ -473,7 +597,7 @@ public:
    template <typename... ValTypes, std::enable_if_t<!Disjunction<IsDataContainer<ValTypes>...>::value, int> = 0>
    auto Exec(unsigned int slot, const ValTypes &...x) -> decltype(fObjects[slot]->Fill(x...), void())
    {
-      fObjects[slot]->Fill(x...);
+      DoFill(slot, x...);
    }
 
    // at least one container argument
@@ -500,6 +624,14 @@ public:
          }
       }
 
+      // arrays of doubles are handed to the histogram at once, which looks up the bins of the whole array in bulk
+      if constexpr (CanFillN<Xs...>()) {
+         if (!fFillManager) {
+            ExecFillN(slot, sizes[colidx], xs...);
+            return;
+         }
+      }
+
       ExecLoop<colidx>(slot, xrefend, MakeBegin(xs)...);
    }
 
@@ -513,8 +645,20 @@ public:
 
    void Initialize() { /* noop */}
 
+   void FinalizeTask(unsigned int slot)
+   {
+      if (fFillManager)
+         fFillers[slot].Flush();
+   }
+
    void Finalize()
    {
+      if (fFillManager) {
+         for (auto &filler : fFillers)
+            filler.Flush();
+         return;
+      }
+
       if (fObjects.size() == 1)
          return;
 
@@ -525,7 +669,13 @@ public:
          delete *it;
    }
 
-   HIST &PartialUpdate(unsigned int slot) { return *fObjects[slot]; }
+   /// If the histogram is shared by all slots, the other slots keep filling it while the partial result is used.
+   HIST &PartialUpdate(unsigned int slot)
+   {
+      if (fFillManager)
+         fFillers[slot].Flush();
+      return *fObjects[slot];
+   }
 
    // Helper functions for RMergeableValue
    std::unique_ptr<RMergeableValueBase> GetMergeableValue() const final
@@ -553,7 +703,7 @@ public:
       auto &result = *static_cast<std::shared_ptr<H> *>(newResult);
       ResetIfPossible(result.get());
       UnsetDirectoryIfPossible(result.get());
-      return FillHelper(result, fObjects.size());
+      return FillHelper(result, fObjects.size(), fCanFillShared);
    }
 };
 
@@ -133,7 +133,8 @@ BuildAction(const ColumnNames_t &bl, const std::shared_ptr<ActionResultType> &h,
 {
    using Helper_t = FillHelper<ActionResultType>;
    using Action_t = RAction<Helper_t, PrevNodeType, TTraits::TypeList<ColTypes...>>;
-   return std::make_unique<Action_t>(Helper_t(h, nSlots), bl, std::move(prevNode), colRegister);
+   constexpr bool canFillShared = Helper_t::template CanFillShared<ColTypes...>();
+   return std::make_unique<Action_t>(Helper_t(h, nSlots, canFillShared), bl, std::move(prevNode), colRegister);
 }
 
 // Histo1D filling (must handle the special case of distinguishing FillHelper and BufferedFillHelper
@@ -147,7 +148,8 @@ BuildAction(const ColumnNames_t &bl, const std::shared_ptr<::TH1D> &h, const uns
    if (hasAxisLimits || !IsImplicitMTEnabled()) {
       using Helper_t = FillHelper<::TH1D>;
       using Action_t = RAction<Helper_t, PrevNodeType, TTraits::TypeList<ColTypes...>>;
-      return std::make_unique<Action_t>(Helper_t(h, nSlots), bl, std::move(prevNode), colRegister);
+      constexpr bool canFillShared = Helper_t::CanFillShared<ColTypes...>();
+      return std::make_unique<Action_t>(Helper_t(h, nSlots, canFillShared), bl, std::move(prevNode), colRegister);
    } else {
       using Helper_t = BufferedFillHelper;
       using Action_t = RAction<Helper_t, PrevNodeType, TTraits::TypeList<ColTypes...>>;
@@ -781,6 +783,19 @@ AddSizeBranches(const std::vector<std::string> &branches, TTree *tree, std::vect
 
 void RemoveDuplicates(ColumnNames_t &columnNames);
 
+/// Return an upper bound on the number of entries the event loop of lm will process, or the largest ULong64_t if it
+/// cannot be known without running the event loop (e.g. when reading from a data source).
+ULong64_t GetNEntriesUpperBound(RLoopManager &lm);
+
+/// Create an empty, uniquely named file in directory dir (or in the system's temporary directory if dir is empty) and
+/// return its path. Used by Cache to spill cached columns to disk.
+std::string MakeCacheSpillFileName(const std::string &dir);
+
+/// Return a loop manager that reads tree treeName from the Cache spill file fileName.
+/// The file is removed from disk when the loop manager is destroyed.
+std::shared_ptr<RLoopManager>
+MakeCacheSpillLoopManager(const std::string &treeName, const std::string &fileName, const ColumnNames_t &defaultColumns);
+
 } // namespace RDF
 } // namespace Internal
 
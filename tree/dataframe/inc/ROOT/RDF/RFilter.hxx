@@ -133,8 +133,7 @@ public:
 
    void StopProcessing() final
    {
-      ++fNStopsReceived;
-      if (fNStopsReceived == fNChildren)
+      if (++fNStopsReceived == fNChildren)
          fPrevNode.StopProcessing();
    }
 
@@ -11,6 +11,7 @@
 #ifndef ROOT_RDF_TINTERFACE
 #define ROOT_RDF_TINTERFACE
 
+#include "ROOT/RCacheOptions.hxx"
 #include "ROOT/RDataSource.hxx"
 #include "ROOT/RDF/ActionHelpers.hxx"
 #include "ROOT/RDF/HistoModels.hxx"
@@ -1107,7 +1108,8 @@ public:
    /// columns and stores their content in memory for fast, zero-copy subsequent access.
    ///
    /// Use `Cache` if you know you will only need a subset of the (`Filter`ed) data that
-   /// fits in memory and that will be accessed many times.
+   /// fits in memory and that will be accessed many times. If the data might not fit in memory,
+   /// see the overloads that take a RCacheOptions argument.
    ///
    /// \note Cache will refuse to process columns with names of the form `#columnname`. These are special columns
    /// made available by some data sources (e.g. RNTupleDS) that represent the size of column `columnname`, and are
@@ -1137,13 +1139,53 @@ public:
       return CacheImpl<ColumnTypes...>(columnList, staticSeq);
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Save selected columns in memory or, if they do not fit, in a temporary file on local disk.
+   /// \tparam ColumnTypes variadic list of branch/column types.
+   /// \param[in] columnList columns to be cached.
+   /// \param[in] options RCacheOptions struct with the memory budget and the location of the spill file.
+   /// \return a `RDataFrame` that wraps the cached dataset.
+   ///
+   /// The size of the cached dataset is estimated as the number of input entries (before any `Filter`) times the
+   /// size of the column types. If the estimate exceeds `options.fMemoryBudget`, the columns are not kept in memory:
+   /// they are written to a TTree in a temporary file in `options.fSpillDirectory`, which the returned dataframe then
+   /// reads back. In this case the event loop runs immediately. The file is removed from disk as soon as the returned
+   /// dataframe and all nodes attached to it go out of scope. When the number of input entries is unknown (e.g. for
+   /// data sources), the columns are always spilled to disk if a memory budget is set.
+   ///
+   /// Note that the estimate only takes into account the `sizeof` of the column types: for columns holding
+   /// collections, the budget should be set with the typical collection size in mind.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// ROOT::RDF::RCacheOptions opts;
+   /// opts.fMemoryBudget = 8ull * 1024 * 1024 * 1024; // 8 GB
+   /// opts.fSpillDirectory = "/scratch";
+   /// auto cached = df.Filter("pt > 20").Cache<float, float>({"pt", "eta"}, opts);
+   /// ~~~
+   template <typename... ColumnTypes>
+   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList, const RCacheOptions &options)
+   {
+      auto staticSeq = std::make_index_sequence<sizeof...(ColumnTypes)>();
+      return CacheImpl<ColumnTypes...>(columnList, options, staticSeq);
+   }
+
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Save selected columns in memory.
    /// \param[in] columnList columns to be cached in memory
    /// \return a `RDataFrame` that wraps the cached dataset.
    ///
    /// See the previous overloads for more information.
-   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList)
+   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList) { return Cache(columnList, RCacheOptions()); }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Save selected columns in memory or, if they do not fit, in a temporary file on local disk.
+   /// \param[in] columnList columns to be cached.
+   /// \param[in] options RCacheOptions struct with the memory budget and the location of the spill file.
+   /// \return a `RDataFrame` that wraps the cached dataset.
+   ///
+   /// See the previous overloads for more information.
+   RInterface<RLoopManager> Cache(const ColumnNames_t &columnList, const RCacheOptions &options)
    {
       // Early return: if the list of columns is empty, just return an empty RDF
       // If we proceed, the jitted call will not compile!
@@ -1158,7 +1200,7 @@ public:
       RInterface<TTraits::TakeFirstParameter_t<decltype(upcastNode)>> upcastInterface(fProxiedPtr, *fLoopManager,
                                                                                       fColRegister);
       // build a string equivalent to
-      // "(RInterface<nodetype*>*)(this)->Cache<Ts...>(*(ColumnNames_t*)(&columnList))"
+      // "(RInterface<nodetype*>*)(this)->Cache<Ts...>(*(ColumnNames_t*)(&columnList), *(RCacheOptions*)(&options))"
       RInterface<RLoopManager> resRDF(std::make_shared<ROOT::Detail::RDF::RLoopManager>(0));
       cacheCall << "*reinterpret_cast<ROOT::RDF::RInterface<ROOT::Detail::RDF::RLoopManager>*>("
                 << RDFInternal::PrettyPrintAddr(&resRDF)
@@ -1176,7 +1218,9 @@ public:
       if (!columnListWithoutSizeColumns.empty())
          cacheCall.seekp(-2, cacheCall.cur);                         // remove the last ",
       cacheCall << ">(*reinterpret_cast<std::vector<std::string>*>(" // vector<string> should be ColumnNames_t
-                << RDFInternal::PrettyPrintAddr(&columnListWithoutSizeColumns) << "));";
+                << RDFInternal::PrettyPrintAddr(&columnListWithoutSizeColumns)
+                << "), *reinterpret_cast<ROOT::RDF::RCacheOptions*>(" << RDFInternal::PrettyPrintAddr(&options)
+                << "));";
 
       // book the code to jit with the RLoopManager and trigger the event loop
       fLoopManager->ToJitExec(cacheCall.str());
@@ -1233,7 +1277,12 @@ public:
    /// \return the first node of the computation graph for which the event loop is limited to a certain range of entries.
    ///
    /// Note that in case of previous Ranges and Filters the selected range refers to the transformed dataset.
-   /// Ranges are only available if EnableImplicitMT has _not_ been called. Multi-thread ranges are not supported.
+   ///
+   /// Ranges can be used in multi-thread event loops: the count of entries is shared by all threads, and the event
+   /// loop stops early, not scheduling further tasks, once all ranges in the computation graph have reached their end.
+   /// Note however that in this case which entries are selected depends on the order in which the threads process
+   /// them, i.e. `Range(10)` selects 10 entries, but not necessarily the first 10 of the dataset. If the exact
+   /// entries matter (and not just their number), run single-thread.
    ///
    /// ### Example usage:
    /// ~~~{.cpp}
@@ -1247,7 +1296,6 @@ public:
       // check invariants
       if (stride == 0 || (end != 0 && end < begin))
          throw std::runtime_error("Range: stride must be strictly greater than 0 and end must be greater than begin.");
-      CheckIMTDisabled("Range");
 
       using Range_t = RDFDetail::RRange<Proxied>;
       auto rangePtr = std::make_shared<Range_t>(begin, end, stride, fProxiedPtr);
@@ -2886,6 +2934,34 @@ private:
       return cachedRDF;
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Implementation of cache with a memory budget.
+   template <typename... ColTypes, std::size_t... S>
+   RInterface<RLoopManager>
+   CacheImpl(const ColumnNames_t &columnList, const RCacheOptions &options, std::index_sequence<S...> staticSeq)
+   {
+      constexpr ULong64_t entrySize = (0ull + ... + sizeof(ColTypes));
+      if (options.fMemoryBudget == 0 || entrySize == 0 ||
+          RDFInternal::GetNEntriesUpperBound(*fLoopManager) <= options.fMemoryBudget / entrySize)
+         return CacheImpl<ColTypes...>(columnList, staticSeq);
+
+      const auto columnListWithoutSizeColumns = RDFInternal::FilterArraySizeColNames(columnList, "Cache");
+      RDFInternal::CheckTypesAndPars(sizeof...(ColTypes), columnListWithoutSizeColumns.size());
+
+      const std::string treeName = "rdfcache";
+      const auto fileName = RDFInternal::MakeCacheSpillFileName(options.fSpillDirectory);
+      // Created before the spill file is written so that the file is cleaned up also if writing fails
+      auto spillLoopManager =
+         RDFInternal::MakeCacheSpillLoopManager(treeName, fileName, columnListWithoutSizeColumns);
+
+      RSnapshotOptions snapshotOptions;
+      snapshotOptions.fCompressionAlgorithm = options.fCompressionAlgorithm;
+      snapshotOptions.fCompressionLevel = options.fCompressionLevel;
+      Snapshot<ColTypes...>(treeName, fileName, columnListWithoutSizeColumns, snapshotOptions);
+
+      return RInterface<RLoopManager>(std::move(spillLoopManager));
+   }
+
    template <bool IsSingleColumn, typename F>
    RInterface<Proxied, DS_t>
    VaryImpl(const std::vector<std::string> &colNames, F &&expression, const ColumnNames_t &inputColumns,
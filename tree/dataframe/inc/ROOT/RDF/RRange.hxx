@@ -60,31 +60,34 @@ public:
    // otherwise if fPrevNode is fLoopManager we get a use after delete
    ~RRange() { fLoopManager->Deregister(this); }
 
-   /// Ranges act as filters when it comes to selecting entries that downstream nodes should process
+   /// Ranges act as filters when it comes to selecting entries that downstream nodes should process.
+   /// The count of entries that passed the upstream filters is shared by all slots: in multi-thread event loops,
+   /// which entries end up in the range depends on the order in which the threads process them.
    bool CheckFilters(unsigned int slot, Long64_t entry) final
    {
-      if (entry != fLastCheckedEntry) {
+      auto &lastCheckedEntry = fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()];
+      auto &lastResult = fLastResult[slot * RDFInternal::CacheLineStep<int>()];
+      if (entry != lastCheckedEntry) {
          if (fHasStopped)
             return false;
          if (!fPrevNode.CheckFilters(slot, entry)) {
             // a filter upstream returned false, cache the result
-            fLastResult = false;
+            lastResult = false;
          } else {
             // apply range filter logic, cache the result
-            if (fNProcessedEntries < fStart || (fStop > 0 && fNProcessedEntries >= fStop) ||
-                (fStride != 1 && (fNProcessedEntries - fStart) % fStride != 0))
-               fLastResult = false;
+            const ULong64_t nProcessed = fNProcessedEntries++;
+            if (nProcessed < fStart || (fStop > 0 && nProcessed >= fStop) ||
+                (fStride != 1 && (nProcessed - fStart) % fStride != 0))
+               lastResult = false;
             else
-               fLastResult = true;
-            ++fNProcessedEntries;
-            if (fNProcessedEntries == fStop) {
-               fHasStopped = true;
+               lastResult = true;
+            // exactly one slot sees the last entry of the range and signals upstream that we are done
+            if (nProcessed + 1 == fStop && !fHasStopped.exchange(true))
                fPrevNode.StopProcessing();
-            }
          }
-         fLastCheckedEntry = entry;
+         lastCheckedEntry = entry;
       }
-      return fLastResult;
+      return lastResult;
    }
 
    // recursive chain of `Report`s
@@ -95,8 +98,9 @@ public:
 
    void StopProcessing() final
    {
-      ++fNStopsReceived;
-      if (fNStopsReceived == fNChildren && !fHasStopped)
+      // in multi-thread runs, children might signal concurrently: only the last one propagates the signal, and only
+      // if the end of the range has not already been signaled
+      if (++fNStopsReceived == fNChildren && !fHasStopped.exchange(true))
          fPrevNode.StopProcessing();
    }
 
@@ -14,7 +14,9 @@
 #include "ROOT/RDF/RNodeBase.hxx"
 #include "RtypesCore.h"
 
+#include <atomic>
 #include <unordered_map>
+#include <vector>
 
 namespace ROOT {
 namespace Internal {
@@ -35,10 +37,11 @@ protected:
    unsigned int fStart;
    unsigned int fStop;
    unsigned int fStride;
-   Long64_t fLastCheckedEntry{-1};
-   bool fLastResult{true};
-   ULong64_t fNProcessedEntries{0};
-   bool fHasStopped{false};    ///< True if the end of the range has been reached
+   std::vector<Long64_t> fLastCheckedEntry; ///< Per-slot, spaced by CacheLineStep to avoid false sharing
+   std::vector<int> fLastResult; // std::vector<bool> cannot be used in a MT context safely
+   /// Number of entries that passed the upstream filters so far, shared by all slots.
+   std::atomic<ULong64_t> fNProcessedEntries{0};
+   std::atomic<bool> fHasStopped{false}; ///< True if the end of the range has been reached
    const unsigned int fNSlots; ///< Number of thread slots used by this node, inherited from parent node.
    std::unordered_map<std::string, std::shared_ptr<RRangeBase>> fVariedRanges;
 
@@ -36,6 +36,10 @@ namespace RDF {
 namespace RDFGraphDrawing = ROOT::Internal::RDF::GraphDrawing;
 
 /// Just like an RAction, but it has N action helpers and N previous nodes (N is the number of variations).
+///
+/// Each variation is processed by its own helper, which produces an independent result (e.g. one histogram per
+/// variation, with its own statistics). Variations that do not affect the upstream filters share the nominal previous
+/// node, whose result is cached per slot and entry, so these filters are evaluated once per entry.
 template <typename Helper, typename PrevNode, typename ColumnTypes_t>
 class R__CLING_PTRCHECK(off) RVariedAction final : public RActionBase {
    using TypeInd_t = std::make_index_sequence<ColumnTypes_t::list_size>;
@@ -68,9 +68,12 @@ double-quote characters must be represented by a pair of double-quote characters
     2000,Mercury,Cougar
 ~~~
 
-The current implementation of RCsvDS reads the entire CSV file content into memory before
-RDataFrame starts processing it. Therefore, before creating a CSV RDataFrame, it is
-important to check both how much memory is available and the size of the CSV file.
+By default, RCsvDS reads the entire CSV file content into memory before RDataFrame starts
+processing it. Therefore, before creating a CSV RDataFrame, it is important to check both how
+much memory is available and the size of the CSV file. For large files, a chunk size should be
+passed to FromCSV: then only that many lines are held in memory at any given time.
+The values are parsed into typed columnar buffers, one per column. If implicit multi-threading is
+enabled, each chunk of lines is split into byte ranges at line boundaries which are parsed in parallel.
 
 RCsvDS can handle empty cells and also allows the usage of the special keywords "NaN" and "nan" to
 indicate `nan` values. If the column is of type double, these cells are stored internally as `nan`.
@@ -82,12 +85,68 @@ Empty cells and explicit `nan`-s inside columns of type Long64_t/bool are stored
 #include <ROOT/RCsvDS.hxx>
 #include <ROOT/RRawFile.hxx>
 #include <TError.h>
+#include <TROOT.h> // IsImplicitMTEnabled
+#ifdef R__USE_IMT
+#include <ROOT/TThreadExecutor.hxx>
+#endif
 
 #include <algorithm>
+#include <cstring>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <sstream>
 #include <string>
 
+namespace {
+/// Size of the blocks in which the CSV file is read
+constexpr std::size_t kReadBlockSize = 4 * 1024 * 1024;
+/// Minimum number of bytes of a chunk for it to be parsed by several threads
+constexpr std::size_t kMinParallelChunkSize = 64 * 1024;
+
+/// Return the end of the line starting at `begin`, i.e. the position of the next line break or `end`
+std::size_t FindLineEnd(const std::string &buffer, std::size_t begin, std::size_t end)
+{
+   const auto lineBreak = static_cast<const char *>(std::memchr(buffer.data() + begin, '\n', end - begin));
+   return lineBreak ? lineBreak - buffer.data() : end;
+}
+
+/// Empty lines, including lines only containing the carriage return of a Windows line break, are skipped
+bool IsEmptyLine(const std::string &buffer, std::size_t begin, std::size_t end)
+{
+   return begin == end || (end - begin == 1 && buffer[begin] == '\r');
+}
+
+/// Split [0, buffer.size()) into at most nRanges byte ranges that start at the beginning of a line
+std::vector<std::size_t> SplitAtLineBreaks(const std::string &buffer, unsigned int nRanges)
+{
+   std::vector<std::size_t> boundaries{0};
+   for (auto i = 1u; i < nRanges; ++i) {
+      const auto approxPos = std::max(boundaries.back(), buffer.size() / nRanges * i);
+      const auto lineEnd = FindLineEnd(buffer, approxPos, buffer.size());
+      if (lineEnd >= buffer.size())
+         break;
+      if (lineEnd + 1 > boundaries.back())
+         boundaries.push_back(lineEnd + 1);
+   }
+   if (boundaries.back() != buffer.size())
+      boundaries.push_back(buffer.size());
+   return boundaries;
+}
+
+std::size_t CountRecords(const std::string &buffer, std::size_t begin, std::size_t end)
+{
+   std::size_t nRecords = 0;
+   for (auto lineBegin = begin; lineBegin < end;) {
+      const auto lineEnd = FindLineEnd(buffer, lineBegin, end);
+      if (!IsEmptyLine(buffer, lineBegin, lineEnd))
+         ++nRecords;
+      lineBegin = lineEnd + 1;
+   }
+   return nRecords;
+}
+} // anonymous namespace
+
 namespace ROOT {
 
 namespace RDF {
@@ -117,46 +176,96 @@ void RCsvDS::FillHeaders(const std::string &line)
    }
 }
 
-void RCsvDS::FillRecord(const std::string &line, Record_t &record)
+void RCsvDS::FillRecord(const std::string &line, std::size_t record, std::set<std::string> &colContainingEmpty)
 {
-   auto i = 0U;
-
-   auto columns = ParseColumns(line);
+   const auto columns = ParseColumns(line);
+   const auto nColumns = std::min(columns.size(), fColTypesList.size());
 
-   for (auto &col : columns) {
-      auto colType = fColTypes[fHeaders[i]];
+   for (auto i = 0U; i < nColumns; ++i) {
+      const auto &col = columns[i];
 
-      switch (colType) {
+      switch (fColTypesList[i]) {
       case 'D': {
-         record.emplace_back(new double((col != "nan") ? std::stod(col) : std::numeric_limits<double>::quiet_NaN()));
+         fDoubleColumns[i][record] = (col != "nan") ? std::stod(col) : std::numeric_limits<double>::quiet_NaN();
          break;
       }
       case 'L': {
          if (col != "nan") {
-            record.emplace_back(new Long64_t(std::stoll(col)));
+            fLong64Columns[i][record] = std::stoll(col);
          } else {
-            fColContainingEmpty.insert(fHeaders[i]);
-            record.emplace_back(new Long64_t(0));
+            colContainingEmpty.insert(fHeaders[i]);
+            fLong64Columns[i][record] = 0;
          }
          break;
       }
       case 'O': {
-         auto b = new bool();
-         record.emplace_back(b);
+         bool b = false;
          if (col != "nan") {
-            std::istringstream(col) >> std::boolalpha >> *b;
+            std::istringstream(col) >> std::boolalpha >> b;
          } else {
-            fColContainingEmpty.insert(fHeaders[i]);
-            *b = false;
+            colContainingEmpty.insert(fHeaders[i]);
          }
+         fBoolColumns[i][record] = b;
          break;
       }
       case 'T': {
-         record.emplace_back(new std::string(col));
+         fStringColumns[i][record] = col;
          break;
       }
       }
-      ++i;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Parse the lines in the byte range [begin, end) of buffer into the column buffers, starting at record firstRecord.
+/// Different byte ranges of the same chunk can be parsed concurrently.
+void RCsvDS::ParseChunk(const std::string &buffer, std::size_t begin, std::size_t end, std::size_t firstRecord,
+                        std::set<std::string> &colContainingEmpty)
+{
+   std::string line;
+   auto record = firstRecord;
+   for (auto lineBegin = begin; lineBegin < end;) {
+      auto lineEnd = FindLineEnd(buffer, lineBegin, end);
+      if (!IsEmptyLine(buffer, lineBegin, lineEnd)) {
+         const auto hasCarriageReturn = buffer[lineEnd - 1] == '\r';
+         line.assign(buffer, lineBegin, lineEnd - lineBegin - hasCarriageReturn);
+         FillRecord(line, record++, colContainingEmpty);
+      }
+      lineBegin = lineEnd + 1;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Read the next fLinesChunkSize non-empty lines of the file, or all remaining lines if fLinesChunkSize is -1, into
+/// buffer. The file position is left at the beginning of the first line that has not been read.
+void RCsvDS::ReadChunk(std::string &buffer)
+{
+   buffer.clear();
+   const auto chunkPos = fCsvFile->GetFilePos();
+   auto linesToRead = fLinesChunkSize;
+   std::size_t lineBegin = 0;
+
+   while (true) {
+      const auto blockBegin = buffer.size();
+      buffer.resize(blockBegin + kReadBlockSize);
+      const auto nBytes = fCsvFile->Read(&buffer[blockBegin], kReadBlockSize);
+      buffer.resize(blockBegin + nBytes);
+      if (nBytes == 0)
+         return; // EOF: the last line may not be terminated by a line break
+      if (-1LL == fLinesChunkSize)
+         continue; // read all remaining lines, no need to count them
+
+      while (lineBegin < buffer.size()) {
+         const auto lineEnd = FindLineEnd(buffer, lineBegin, buffer.size());
+         if (lineEnd == buffer.size())
+            break; // incomplete line, read the next block
+         if (!IsEmptyLine(buffer, lineBegin, lineEnd) && 0 == --linesToRead) {
+            buffer.resize(lineEnd + 1);
+            fCsvFile->Seek(chunkPos + buffer.size());
+            return;
+         }
+         lineBegin = lineEnd + 1;
+      }
    }
 }
 
@@ -376,31 +485,11 @@ RCsvDS::RCsvDS(std::string_view fileName, bool readHeaders, char delimiter, Long
 
 void RCsvDS::FreeRecords()
 {
-   for (auto &record : fRecords) {
-      for (size_t i = 0; i < record.size(); ++i) {
-         void *p = record[i];
-         const auto colType = fColTypes[fHeaders[i]];
-         switch (colType) {
-         case 'D': {
-            delete static_cast<double *>(p);
-            break;
-         }
-         case 'L': {
-            delete static_cast<Long64_t *>(p);
-            break;
-         }
-         case 'O': {
-            delete static_cast<bool *>(p);
-            break;
-         }
-         case 'T': {
-            delete static_cast<std::string *>(p);
-            break;
-         }
-         }
-      }
-   }
-   fRecords.clear();
+   fDoubleColumns.clear();
+   fLong64Columns.clear();
+   fStringColumns.clear();
+   fBoolColumns.clear();
+   fNRecords = 0ULL;
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -414,7 +503,7 @@ void RCsvDS::Finalize()
 {
    fCsvFile->Seek(fDataPos);
    fProcessedLines = 0ULL;
-   fEntryRangesRequested = 0ULL;
+   fChunkFirstEntry = 0ULL;
    FreeRecords();
 }
 
@@ -426,17 +515,63 @@ const std::vector<std::string> &RCsvDS::GetColumnNames() const
 std::vector<std::pair<ULong64_t, ULong64_t>> RCsvDS::GetEntryRanges()
 {
    // Read records and store them in memory
-   auto linesToRead = fLinesChunkSize;
    FreeRecords();
 
-   std::string line;
-   while ((-1LL == fLinesChunkSize || 0 != linesToRead) && fCsvFile->Readln(line)) {
-      if (line.empty()) continue; // skip empty lines
-      fRecords.emplace_back();
-      FillRecord(line, fRecords.back());
-      --linesToRead;
+   std::string buffer;
+   ReadChunk(buffer);
+
+   // Split the chunk in byte ranges at line boundaries, which are parsed in parallel if IMT is on
+   const auto nRanges =
+      (ROOT::IsImplicitMTEnabled() && fNSlots > 1 && buffer.size() >= kMinParallelChunkSize) ? fNSlots : 1u;
+   const auto boundaries = SplitAtLineBreaks(buffer, nRanges);
+   const auto nActualRanges = boundaries.size() - 1;
+   // firstRecords[i] is the index of the first record of the i-th range, firstRecords.back() the total
+   std::vector<std::size_t> firstRecords(nActualRanges + 1, 0);
+   std::vector<std::set<std::string>> colContainingEmpty(nActualRanges);
+   auto countRecords = [&](unsigned int i) {
+      firstRecords[i + 1] = CountRecords(buffer, boundaries[i], boundaries[i + 1]);
+   };
+   auto parseRange = [&](unsigned int i) {
+      ParseChunk(buffer, boundaries[i], boundaries[i + 1], firstRecords[i], colContainingEmpty[i]);
+   };
+
+#ifdef R__USE_IMT
+   std::unique_ptr<ROOT::TThreadExecutor> pool;
+   if (nActualRanges > 1) {
+      pool = std::make_unique<ROOT::TThreadExecutor>();
+      pool->Foreach(countRecords, ROOT::TSeqU(nActualRanges));
+   } else
+#endif
+      for (auto i : ROOT::TSeqU(nActualRanges))
+         countRecords(i);
+   std::partial_sum(firstRecords.begin(), firstRecords.end(), firstRecords.begin());
+
+   fNRecords = firstRecords.back();
+   const auto nColumns = fColTypesList.size();
+   fDoubleColumns.resize(nColumns);
+   fLong64Columns.resize(nColumns);
+   fStringColumns.resize(nColumns);
+   fBoolColumns.resize(nColumns);
+   for (auto i : ROOT::TSeqU(nColumns)) {
+      switch (fColTypesList[i]) {
+      case 'D': fDoubleColumns[i].resize(fNRecords); break;
+      case 'L': fLong64Columns[i].resize(fNRecords); break;
+      case 'O': fBoolColumns[i].resize(fNRecords); break;
+      case 'T': fStringColumns[i].resize(fNRecords); break;
+      }
    }
 
+#ifdef R__USE_IMT
+   if (pool)
+      pool->Foreach(parseRange, ROOT::TSeqU(nActualRanges));
+   else
+#endif
+      for (auto i : ROOT::TSeqU(nActualRanges))
+         parseRange(i);
+
+   for (const auto &cols : colContainingEmpty)
+      fColContainingEmpty.insert(cols.begin(), cols.end());
+
    if (!fColContainingEmpty.empty()) {
       std::string msg = "";
       for (const auto &col : fColContainingEmpty) {
@@ -451,14 +586,15 @@ std::vector<std::pair<ULong64_t, ULong64_t>> RCsvDS::GetEntryRanges()
 
    if (gDebug > 0) {
       if (fLinesChunkSize == -1LL) {
-         Info("GetEntryRanges", "Attempted to read entire CSV file into memory, %zu lines read", fRecords.size());
+         Info("GetEntryRanges", "Attempted to read entire CSV file into memory, %llu lines read", fNRecords);
       } else {
-         Info("GetEntryRanges", "Attempted to read chunk of %lld lines of CSV file into memory, %zu lines read", fLinesChunkSize, fRecords.size());
+         Info("GetEntryRanges", "Attempted to read chunk of %lld lines of CSV file into memory, %llu lines read",
+              fLinesChunkSize, fNRecords);
       }
    }
 
    std::vector<std::pair<ULong64_t, ULong64_t>> entryRanges;
-   const auto nRecords = fRecords.size();
+   const auto nRecords = fNRecords;
    if (0 == nRecords)
       return entryRanges;
 
@@ -475,8 +611,8 @@ std::vector<std::pair<ULong64_t, ULong64_t>> RCsvDS::GetEntryRanges()
    }
    entryRanges.back().second += remainder;
 
+   fChunkFirstEntry = fProcessedLines;
    fProcessedLines += nRecords;
-   fEntryRangesRequested++;
 
    return entryRanges;
 }
@@ -505,30 +641,26 @@ bool RCsvDS::HasColumn(std::string_view colName) const
 bool RCsvDS::SetEntry(unsigned int slot, ULong64_t entry)
 {
    // Here we need to normalise the entry to the number of lines we already processed.
-   const auto offset = (fEntryRangesRequested - 1) * fLinesChunkSize;
-   const auto recordPos = entry - offset;
-   int colIndex = 0;
-   for (auto &colType : fColTypesList) {
-      auto dataPtr = fRecords[recordPos][colIndex];
-      switch (colType) {
+   const auto recordPos = entry - fChunkFirstEntry;
+   for (auto colIndex : ROOT::TSeqU(fColTypesList.size())) {
+      switch (fColTypesList[colIndex]) {
       case 'D': {
-         fDoubleEvtValues[colIndex][slot] = *static_cast<double *>(dataPtr);
+         fDoubleEvtValues[colIndex][slot] = fDoubleColumns[colIndex][recordPos];
          break;
       }
       case 'L': {
-         fLong64EvtValues[colIndex][slot] = *static_cast<Long64_t *>(dataPtr);
+         fLong64EvtValues[colIndex][slot] = fLong64Columns[colIndex][recordPos];
          break;
       }
       case 'O': {
-         fBoolEvtValues[colIndex][slot] = *static_cast<bool *>(dataPtr);
+         fBoolEvtValues[colIndex][slot] = fBoolColumns[colIndex][recordPos];
          break;
       }
       case 'T': {
-         fStringEvtValues[colIndex][slot] = *static_cast<std::string *>(dataPtr);
+         fStringEvtValues[colIndex][slot] = fStringColumns[colIndex][recordPos];
          break;
       }
       }
-      colIndex++;
    }
    return true;
 }
@@ -10,6 +10,7 @@
 
 #include "ROOT/RDF/ActionHelpers.hxx"
 #include "ROOT/RDF/Utils.hxx" // CacheLineStep
+#include "TEnv.h"
 
 namespace ROOT {
 namespace Internal {
@@ -38,6 +39,12 @@ ULong64_t &CountHelper::PartialUpdate(unsigned int slot)
    return fCounts[slot];
 }
 
+double GetSharedFillThreshold()
+{
+   // by default, switch to a shared histogram when the per-slot clones would hold more than 1e8 cells in total
+   return gEnv->GetValue("RDataFrame.SharedFillThreshold", 1e8);
+}
+
 void BufferedFillHelper::UpdateMinMax(unsigned int slot, double v)
 {
    auto &thisMin = fMin[slot * CacheLineStep<BufEl_t>()];
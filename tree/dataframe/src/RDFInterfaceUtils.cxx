@@ -8,6 +8,7 @@
  * For the list of contributors see $ROOTSYS/README/CREDITS.             *
  *************************************************************************/
 
+#include <ROOT/InternalTreeUtils.hxx> // MakeChainForMT
 #include <ROOT/RDataSource.hxx>
 #include <ROOT/RDF/InterfaceUtils.hxx>
 #include <ROOT/RDF/RColumnRegister.hxx>
@@ -30,6 +31,7 @@
 #include <TPRegexp.h>
 #include <TROOT.h>
 #include <TString.h>
+#include <TSystem.h>
 #include <TTree.h>
 #include <TVirtualMutex.h>
 
@@ -47,8 +49,10 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdio>   // for fclose
 #include <cstdlib>  // for size_t
 #include <iterator> // for back_insert_iterator
+#include <limits>
 #include <map>
 #include <memory>
 #include <set>
@@ -1015,6 +1019,41 @@ void RemoveDuplicates(ColumnNames_t &columnNames)
       columnNames.end());
 }
 
+ULong64_t GetNEntriesUpperBound(RLoopManager &lm)
+{
+   if (auto *tree = lm.GetTree())
+      return tree->GetEntries();
+   if (lm.GetDataSource())
+      return std::numeric_limits<ULong64_t>::max();
+   return lm.GetNEmptyEntries();
+}
+
+std::string MakeCacheSpillFileName(const std::string &dir)
+{
+   TString fileName = "rdfcache";
+   FILE *f = gSystem->TempFileName(fileName, dir.empty() ? nullptr : dir.c_str());
+   if (!f)
+      throw std::runtime_error("Cache: could not create a spill file in directory \"" +
+                               (dir.empty() ? std::string(gSystem->TempDirectory()) : dir) + "\".");
+   fclose(f);
+   return fileName.Data();
+}
+
+std::shared_ptr<RLoopManager>
+MakeCacheSpillLoopManager(const std::string &treeName, const std::string &fileName, const ColumnNames_t &defaultColumns)
+{
+   auto chain = ROOT::Internal::TreeUtils::MakeChainForMT(treeName);
+   chain->Add(fileName.c_str());
+   // the spill file is a private detail of this cached dataset: remove it as soon as nobody can read it anymore
+   std::shared_ptr<TTree> tree(chain.release(), [fileName](TTree *t) {
+      delete t;
+      gSystem->Unlink(fileName.c_str());
+   });
+   auto lm = std::make_shared<RLoopManager>(nullptr, defaultColumns);
+   lm->SetTree(std::move(tree));
+   return lm;
+}
+
 } // namespace RDF
 } // namespace Internal
 } // namespace ROOT
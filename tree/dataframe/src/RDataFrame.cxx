@@ -102,7 +102,7 @@ Transformations are a way to manipulate the data.
 | DefineSlot() | Same as Define(), but the user-defined function must take an extra `unsigned int slot` as its first parameter. `slot` will take a different value, `0` to `nThreads - 1`, for each thread of execution. This is meant as a helper in writing thread-safe Define() transformation when using RDataFrame after ROOT::EnableImplicitMT(). DefineSlot() works just as well with single-thread execution: in that case `slot` will always be `0`.  |
 | DefineSlotEntry() | Same as DefineSlot(), but the entry number is passed in addition to the slot number. This is meant as a helper in case the expression depends on the entry number. For details about entry numbers in multi-threaded runs, see [here](\ref helper-cols). |
 | Filter() | Filter rows based on user-defined conditions. |
-| Range() | Filter rows based on entry number (single-thread only). |
+| Range() | Filter rows based on entry number (in multi-thread runs, which entries are selected is not deterministic). |
 | Redefine() | Overwrite the value and/or type of an existing column. See Define() for more information. |
 | RedefineSlot() | Overwrite the value and/or type of an existing column. See DefineSlot() for more information. |
 | RedefineSlotEntry() | Overwrite the value and/or type of an existing column. See DefineSlotEntry() for more information. |
@@ -526,8 +526,7 @@ that has been run using the relevant RDataFrame.
 
 \anchor ranges
 ### Ranges
-When RDataFrame is not being used in a multi-thread environment (i.e. no call to EnableImplicitMT() was made),
-Range() transformations are available. These act very much like filters but instead of basing their decision on
+Range() transformations act very much like filters but instead of basing their decision on
 a filter expression, they rely on `begin`,`end` and `stride` parameters.
 
 - `begin`: initial entry number considered for this range.
@@ -545,6 +544,11 @@ preceding filter*.
 Ranges allow "early quitting": if all branches of execution of a functional graph reached their `end` value of
 processed entries, the event-loop is immediately interrupted. This is useful for debugging and quick data explorations.
 
+Ranges can also be used in multi-thread event loops. The count of processed entries is then shared by all threads,
+and early quitting stops all threads and skips the tasks that have not started yet. Which entries are selected,
+however, depends on the order in which threads process them: `Range(10)` lets exactly 10 entries pass, but they are not
+necessarily the first 10 entries of the dataset. When the exact entries matter, run single-thread.
+
 \anchor custom-columns
 ### Custom columns
 Custom columns are created by invoking `Define(name, f, columnList)`. As usual, `f` can be any callable object
@@ -9,18 +9,27 @@
  *************************************************************************/
 
 #include "ROOT/RDF/RRangeBase.hxx"
+#include "ROOT/RDF/Utils.hxx" // CacheLineStep
+
+#include <algorithm>
 
 using ROOT::Detail::RDF::RRangeBase;
 
 RRangeBase::RRangeBase(RLoopManager *implPtr, unsigned int start, unsigned int stop, unsigned int stride,
                        const unsigned int nSlots, const std::vector<std::string> &prevVariations)
-   : RNodeBase(prevVariations, implPtr), fStart(start), fStop(stop), fStride(stride), fNSlots(nSlots)
+   : RNodeBase(prevVariations, implPtr),
+     fStart(start),
+     fStop(stop),
+     fStride(stride),
+     fLastCheckedEntry(nSlots * ROOT::Internal::RDF::CacheLineStep<Long64_t>(), -1),
+     fLastResult(nSlots * ROOT::Internal::RDF::CacheLineStep<int>(), true),
+     fNSlots(nSlots)
 {
 }
 
 void RRangeBase::InitNode()
 {
-   fLastCheckedEntry = -1;
+   std::fill(fLastCheckedEntry.begin(), fLastCheckedEntry.end(), -1);
    fNProcessedEntries = 0;
    fHasStopped = false;
 }
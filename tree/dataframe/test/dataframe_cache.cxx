@@ -336,3 +336,54 @@ TEST(Cache, Alias)
    auto df4 = df3.Cache({"y"});
    EXPECT_EQ(df4.Sum("y").GetValue(), 3u);
 }
+
+TEST(Cache, MemoryBudgetNotExceeded)
+{
+   ROOT::RDataFrame df(10);
+   auto df2 = df.Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"});
+   ROOT::RDF::RCacheOptions opts;
+   opts.fMemoryBudget = 10 * sizeof(int);
+   auto cached = df2.Cache<int>({"x"}, opts);
+   // the dataset fits in the budget: it is cached in memory, wrapped by a data source
+   EXPECT_EQ(cached.Describe().AsString(/*shortFormat =*/true).rfind("Dataframe from datasource", 0), 0u);
+   EXPECT_EQ(cached.Sum<int>("x").GetValue(), 45);
+}
+
+TEST(Cache, SpillToDisk)
+{
+   ROOT::RDataFrame df(10);
+   auto df2 = df.Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"})
+                 .Define("v", [](ULong64_t e) { return RVec<float>(e % 3, 1.f); }, {"rdfentry_"})
+                 .Filter([](int x) { return x % 2 == 0; }, {"x"});
+   ROOT::RDF::RCacheOptions opts;
+   opts.fMemoryBudget = 1;
+
+   std::string fileName;
+   {
+      auto cached = df2.Cache<int, RVec<float>>({"x", "v"}, opts);
+      const auto description = cached.Describe().AsString(/*shortFormat =*/true);
+      const std::string prefix = "Dataframe from TChain rdfcache in file ";
+      ASSERT_EQ(description.rfind(prefix, 0), 0u);
+      fileName = description.substr(prefix.size());
+      EXPECT_EQ(cached.Count().GetValue(), 5ull);
+      EXPECT_EQ(cached.Sum<int>("x").GetValue(), 20);
+      EXPECT_EQ(cached.Define("n", "v.size()").Sum<std::size_t>("n").GetValue(), 5ull);
+      // running again reads from the spill file, not from the original graph
+      EXPECT_EQ(cached.Max<int>("x").GetValue(), 8);
+      EXPECT_FALSE(gSystem->AccessPathName(fileName.c_str()));
+   }
+   // the spill file goes away together with the cached dataframe
+   EXPECT_TRUE(gSystem->AccessPathName(fileName.c_str()));
+}
+
+TEST(Cache, SpillToDiskJitted)
+{
+   ROOT::RDataFrame df(4);
+   auto df2 = df.Define("x", "(int)rdfentry_");
+   ROOT::RDF::RCacheOptions opts;
+   opts.fMemoryBudget = 1;
+   opts.fSpillDirectory = gSystem->TempDirectory();
+   auto cached = df2.Cache({"x"}, opts);
+   EXPECT_EQ(cached.Describe().AsString(/*shortFormat =*/true).rfind("Dataframe from TChain rdfcache", 0), 0u);
+   EXPECT_EQ(cached.Sum<int>("x").GetValue(), 6);
+}
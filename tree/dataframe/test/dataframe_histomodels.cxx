@@ -346,3 +346,28 @@ TEST(RDataFrameHisto, FillVecBool)
     EXPECT_EQ(h->GetBinContent(2), n);
     EXPECT_EQ(h->GetBinContent(3), 0u);
 }
+
+// RVec<double> columns are filled through TH1/TH2/TH3::FillN
+TEST(RDataFrameHisto, FillVecDouble)
+{
+   const auto n = 10u;
+   ROOT::RDataFrame df(n);
+   auto d = df.Define("x", [] { return ROOT::RVec<double>{-1., 0.5, 2.5, 10.}; })
+               .Define("w", [] { return ROOT::RVec<double>{1., 2., 3., 4.}; });
+   auto h1 = d.Histo1D<ROOT::RVec<double>, ROOT::RVec<double>>({"h1", "h1", 3, 0., 3.}, "x", "w");
+   auto h2 = d.Histo2D<ROOT::RVec<double>, ROOT::RVec<double>>({"h2", "h2", 3, 0., 3., 3, 0., 3.}, "x", "x");
+   auto h3 = d.Histo3D<ROOT::RVec<double>, ROOT::RVec<double>, ROOT::RVec<double>, ROOT::RVec<double>>(
+      {"h3", "h3", 3, 0., 3., 3, 0., 3., 3, 0., 3.}, "x", "x", "x", "w");
+
+   const std::vector<int> bins{0, 1, 3, 4};
+   for (auto i : ROOT::TSeqI(4)) {
+      const double w = i + 1.;
+      EXPECT_DOUBLE_EQ(h1->GetBinContent(bins[i]), n * w);
+      EXPECT_DOUBLE_EQ(h2->GetBinContent(bins[i], bins[i]), n);
+      EXPECT_DOUBLE_EQ(h3->GetBinContent(bins[i], bins[i], bins[i]), n * w);
+   }
+   EXPECT_EQ(h1->GetEntries(), 4 * n);
+   EXPECT_EQ(h2->GetEntries(), 4 * n);
+   EXPECT_EQ(h3->GetEntries(), 4 * n);
+   EXPECT_DOUBLE_EQ(h1->GetMean(), (0.5 * 2. + 2.5 * 3.) / 5.);
+}
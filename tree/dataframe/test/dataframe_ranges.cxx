@@ -1,6 +1,8 @@
 #include "ROOT/RDataFrame.hxx"
 #include <TROOT.h>
 
+#include <atomic>
+
 #include "gtest/gtest.h"
 
 using namespace ROOT;
@@ -91,18 +93,34 @@ TEST_F(RDFRanges, NoEarlyStopping)
 }
 
 #ifdef R__USE_IMT
-TEST(RDFRangesMT, ThrowIfIMT)
+TEST(RDFRangesMT, Counts)
 {
-   bool hasThrown = false;
-   ROOT::EnableImplicitMT();
-   RDataFrame d(0);
-   try {
-      d.Range(0);
-   } catch (const std::exception &e) {
-      hasThrown = true;
-      EXPECT_STREQ(e.what(), "Range was called with ImplicitMT enabled, but multi-thread is not supported.");
-   }
-   EXPECT_TRUE(hasThrown);
+   ROOT::EnableImplicitMT(4);
+   RDataFrame d(1000);
+   auto ten = d.Range(10).Count();
+   auto tenFiltered = d.Filter([](ULong64_t e) { return e % 2 == 0; }, {"rdfentry_"}).Range(5, 25, 2).Count();
+   auto all = d.Count();
+   EXPECT_EQ(*ten, 10u);
+   EXPECT_EQ(*tenFiltered, 10u);
+   EXPECT_EQ(*all, 1000u);
+   ROOT::DisableImplicitMT();
+}
+
+TEST(RDFRangesMT, EarlyStop)
+{
+   ROOT::EnableImplicitMT(4);
+   RDataFrame d(1000000);
+   std::atomic<ULong64_t> nProcessed{0};
+   auto ten = d.Filter([&nProcessed] {
+                  ++nProcessed;
+                  return true;
+               })
+                 .Range(10)
+                 .Count();
+   EXPECT_EQ(*ten, 10u);
+   // once the range is done, the threads stop processing entries and no further tasks are run
+   EXPECT_LT(nProcessed.load(), 1000000u);
+   ROOT::DisableImplicitMT();
 }
 #endif
 
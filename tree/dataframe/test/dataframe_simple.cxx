@@ -10,6 +10,7 @@
 #include <ROOT/RDataFrame.hxx>
 #include <ROOT/TSeq.hxx>
 #include <TChain.h>
+#include <TEnv.h>
 #include <TFile.h>
 #include <TGraph.h>
 #include <TInterpreter.h>
@@ -1041,6 +1042,42 @@ TEST_P(RDFSimpleTests, FillWithCustomClassJitted)
    EXPECT_EQ(h.GetEntries(), 10);
 }
 
+TEST_P(RDFSimpleTests, SharedFill)
+{
+   auto df = ROOT::RDataFrame(1000)
+                .Define("x", [](ULong64_t e) { return double(e % 100); }, {"rdfentry_"})
+                .Define("y", [](ULong64_t e) { return RVecF{float(e % 7), float(e % 13)}; }, {"rdfentry_"})
+                .Define("w", [](ULong64_t e) { return 1. / (e + 1); }, {"rdfentry_"});
+   const TH2DModel model{"h", "h", 100, 0, 100, 20, 0, 20};
+
+   const auto prevThreshold = gEnv->GetValue("RDataFrame.SharedFillThreshold", 1e8);
+   gEnv->SetValue("RDataFrame.SharedFillThreshold", -1.); // per-slot clones
+   auto hClones = df.Histo2D<double, RVecF, double>(model, "x", "y", "w");
+   auto hxClones = df.Histo1D<double>({"hx", "hx", 100, 0, 100}, "x");
+   gEnv->SetValue("RDataFrame.SharedFillThreshold", 1.); // one histogram shared by all slots
+   auto hShared = df.Histo2D<double, RVecF, double>(model, "x", "y", "w");
+   auto hxShared = df.Histo1D<double>({"hx", "hx", 100, 0, 100}, "x");
+   gEnv->SetValue("RDataFrame.SharedFillThreshold", prevThreshold);
+   double partialEntries = 0;
+   hxShared.OnPartialResult(100,
+                            [&partialEntries](TH1D &h) { partialEntries = std::max(partialEntries, h.GetEntries()); });
+
+   EXPECT_EQ(hShared->GetEntries(), hClones->GetEntries());
+   // the order of the fills depends on the scheduling, allow for rounding differences
+   EXPECT_NEAR(hShared->GetSumOfWeights(), hClones->GetSumOfWeights(), 1e-9);
+   EXPECT_NEAR(hShared->GetMean(1), hClones->GetMean(1), 1e-9);
+   EXPECT_NEAR(hShared->GetMean(2), hClones->GetMean(2), 1e-9);
+   for (int i = 0; i < hShared->GetNcells(); ++i) {
+      EXPECT_NEAR(hShared->GetBinContent(i), hClones->GetBinContent(i), 1e-9);
+      EXPECT_NEAR(hShared->GetBinError(i), hClones->GetBinError(i), 1e-9);
+   }
+   EXPECT_EQ(hxShared->GetEntries(), 1000);
+   EXPECT_GT(partialEntries, 0);
+   EXPECT_LE(partialEntries, 1000);
+   for (int i = 0; i < hxShared->GetNcells(); ++i)
+      EXPECT_DOUBLE_EQ(hxShared->GetBinContent(i), hxClones->GetBinContent(i));
+}
+
 // run single-thread tests
 INSTANTIATE_TEST_SUITE_P(Seq, RDFSimpleTests, ::testing::Values(false));
 
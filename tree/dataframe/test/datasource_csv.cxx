@@ -3,9 +3,13 @@
 #include <ROOT/TSeq.hxx>
 #include <ROOT/TestSupport.hxx>
 #include <TROOT.h>
+#include <TSystem.h>
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <fstream>
+
 using namespace ROOT::RDF;
 
 auto fileName0 = "RCsvDS_test_headers.csv";
@@ -358,6 +362,48 @@ TEST(RCsvDS, SpecifyColumnTypes)
    EXPECT_EQ(maxAge.GetValue(), 60);
 }
 
+TEST(RCsvDS, ParallelParsingMT)
+{
+   // large enough for the chunks to be split in byte ranges parsed by different threads
+   const auto fileName = "RCsvDS_test_parallel.csv";
+   const auto nLines = 20000;
+   {
+      std::ofstream f(fileName);
+      f << "i,x,s,b\n";
+      for (auto i = 0; i < nLines; ++i) {
+         f << i << ',' << i * 0.5 << ",s" << i << ',' << (i % 2 ? "true" : "false") << '\n';
+         if (i % 1000 == 0)
+            f << '\n'; // empty lines are skipped
+      }
+   }
+
+   for (auto chunkSize : {-1LL, 7000LL}) {
+      auto df = ROOT::RDF::FromCSV(fileName, true, ',', chunkSize);
+      auto count = df.Count();
+      auto sumI = df.Sum<Long64_t>("i");
+      auto sumX = df.Sum<double>("x");
+      auto nTrue = df.Filter([](bool b) { return b; }, {"b"}).Count();
+      auto consistent = df.Filter([](Long64_t i, double x, const std::string &s, bool b) {
+                             return x == i * 0.5 && s == "s" + std::to_string(i) && b == (i % 2 == 1);
+                          },
+                          {"i", "x", "s", "b"})
+                           .Count();
+      auto is = df.Take<Long64_t>("i");
+
+      EXPECT_EQ(ULong64_t(nLines), *count);
+      EXPECT_EQ(Long64_t(nLines) * (nLines - 1) / 2, *sumI);
+      EXPECT_DOUBLE_EQ(0.5 * nLines * (nLines - 1) / 2, *sumX);
+      EXPECT_EQ(ULong64_t(nLines / 2), *nTrue);
+      EXPECT_EQ(ULong64_t(nLines), *consistent);
+      auto sortedIs = *is;
+      std::sort(sortedIs.begin(), sortedIs.end());
+      for (auto i = 0; i < nLines; ++i)
+         EXPECT_EQ(i, sortedIs[i]);
+   }
+
+   gSystem->Unlink(fileName);
+}
+
 TEST(RCsvDS, NaNTypeIndentification)
 {
    RCsvDS tds(fileName4);
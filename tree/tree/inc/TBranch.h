@@ -31,6 +31,9 @@
 #include "Compression.h"
 #include "ROOT/TIOFeatures.hxx"
 
+#include <cstddef>
+#include <vector>
+
 class TTree;
 class TBasket;
 class TBranchElement;
@@ -94,6 +97,7 @@ class TBranch : public TNamed, public TAttFill {
    using TIOFeatures = ROOT::TIOFeatures;
 
 protected:
+   friend class TBasket;
    friend class TTreeCache;
    friend class TTreeCloner;
    friend class TTree;
@@ -154,6 +158,11 @@ protected:
 
    Bool_t      fSkipZip;          ///<! After being read, the buffer will not be unzipped.
 
+   std::vector<char>   fCompressionDict;            ///<  ZSTD dictionary of the baskets (empty if none)
+   Int_t               fCompressionDictSize{-1};    ///<! Maximum size of the dictionary to train, -1 if not set
+   std::vector<char>   fCompressionDictSamples;     ///<! Content of the first baskets, to train the dictionary
+   std::vector<size_t> fCompressionDictSampleSizes; ///<! Sizes of the samples in fCompressionDictSamples
+
    using CacheInfo_t = ROOT::Internal::TBranchCacheInfo;
    CacheInfo_t fCacheInfo;        ///<! Hold info about which basket are in the cache and if they have been retrieved from the cache.
 
@@ -168,6 +177,7 @@ protected:
    void     FillLeavesImpl(TBuffer &b);
 
    void     SetSkipZip(Bool_t skip = kTRUE) { fSkipZip = skip; }
+   void     TrainCompressionDict(const char *buffer, Int_t size);
    void     Init(const char *name, const char *leaflist, Int_t compress);
 
    TBasket *GetFreshBasket(Int_t basketnumber, TBuffer *user_buffer);
@@ -221,6 +231,8 @@ public:
            Int_t     GetCompressionAlgorithm() const;
            Int_t     GetCompressionLevel() const;
            Int_t     GetCompressionSettings() const;
+   const std::vector<char> &GetCompressionDict() const { return fCompressionDict; }
+           Int_t     GetCompressionDictSize() const;
    TDirectory       *GetDirectory() const {return fDirectory;}
    virtual Int_t     GetEntry(Long64_t entry=0, Int_t getall = 0);
    virtual Int_t     GetEntryExport(Long64_t entry, Int_t getall, TClonesArray *list, Int_t n);
@@ -275,6 +287,7 @@ public:
            void      SetCompressionAlgorithm(Int_t algorithm = ROOT::RCompressionSetting::EAlgorithm::kUseGlobal);
            void      SetCompressionLevel(Int_t level = ROOT::RCompressionSetting::ELevel::kUseMin);
            void      SetCompressionSettings(Int_t settings = ROOT::RCompressionSetting::EDefaults::kUseCompiledDefault);
+           void      SetCompressionDictSize(Int_t maxsize);
    virtual void      SetEntries(Long64_t entries);
    virtual void      SetEntryOffsetLen(Int_t len, Bool_t updateSubBranches = kFALSE);
    virtual void      SetFirstEntry(Long64_t entry);
@@ -292,7 +305,7 @@ public:
 
    static  void      ResetCount();
 
-   ClassDefOverride(TBranch, 13); // Branch descriptor
+   ClassDefOverride(TBranch, 14); // Branch descriptor
 };
 
 //______________________________________________________________________________
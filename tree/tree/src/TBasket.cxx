@@ -618,7 +618,9 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
             goto AfterBuffer;
          }
 
-         R__unzip(&nin, rawCompressedObjectBuffer, &nbuf, (unsigned char*) rawUncompressedObjectBuffer, &nout);
+         const std::vector<char> &dict = fBranch->GetCompressionDict();
+         R__unzipWithDict(&nin, rawCompressedObjectBuffer, &nbuf, (unsigned char*) rawUncompressedObjectBuffer, &nout,
+                          dict.data(), dict.size());
          if (!nout) break;
          noutot += nout;
          nintot += nin;
@@ -1230,6 +1232,18 @@ Int_t TBasket::WriteBuffer()
       char *bufcur = &fBuffer[fKeylen];
       noutot = 0;
       nzip   = 0;
+      // With ZSTD, the first baskets of the branch may be used to train a dictionary, used for the next ones.
+      const std::vector<char> *dict = nullptr;
+      if (cxAlgorithm == ROOT::RCompressionSetting::EAlgorithm::kZSTD) {
+#ifdef R__USE_IMT
+         sentry.unlock();
+#endif  // R__USE_IMT
+         fBranch->TrainCompressionDict(objbuf, fObjlen);
+#ifdef R__USE_IMT
+         sentry.lock();
+#endif  // R__USE_IMT
+         dict = &fBranch->GetCompressionDict();
+      }
       for (Int_t i = 0; i < nbuffers; ++i) {
          if (i == nbuffers - 1) bufmax = fObjlen - nzip;
          else bufmax = kMAXZIPBUF;
@@ -1242,7 +1256,10 @@ Int_t TBasket::WriteBuffer()
          // NOTE this is declared with C linkage, so it shouldn't except.  Also, when
          // USE_IMT is defined, we are guaranteed that the compression buffer is unique per-branch.
          // (see fCompressedBufferRef in constructor).
-         R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
+         if (dict)
+            R__zipWithDict(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm, dict->data(), dict->size());
+         else
+            R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
 #ifdef R__USE_IMT
          sentry.lock();
 #endif  // R__USE_IMT
@@ -22,6 +22,7 @@
 #include "TClass.h"
 #include "TBufferFile.h"
 #include "TClonesArray.h"
+#include "TEnv.h"
 #include "TFile.h"
 #include "TLeaf.h"
 #include "TLeafB.h"
@@ -46,6 +47,7 @@
 #include "TVirtualMutex.h"
 #include "TVirtualPad.h"
 #include "TVirtualPerfStats.h"
+#include "ZipZSTD.h"
 #include "strlcpy.h"
 #include "snprintf.h"
 
@@ -53,6 +55,7 @@
 
 #include "ROOT/TIOFeatures.hxx"
 
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
 #include <cstring>
@@ -75,6 +78,10 @@ See TBranch structure in TTree.
 See also specialized branches:
  - TBranchObject in case the branch is one object
  - TBranchClones in case the branch is an array of clone objects
+
+Baskets compressed with ZSTD can use a dictionary, which improves the compression of small
+baskets with similar content. It is trained from the first baskets of the branch, see
+SetCompressionDictSize(), and stored with the branch in the TTree header.
 */
 
 ClassImp(TBranch);
@@ -2813,6 +2820,87 @@ void TBranch::SetCompressionSettings(Int_t settings)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Train a ZSTD dictionary of at most maxsize bytes from the content of the
+/// first baskets of this branch and its sub-branches, and compress the
+/// following baskets with it. Only baskets compressed with ZSTD use it.
+///
+/// The dictionary is stored with the branch in the TTree header: the baskets
+/// compressed with it can only be read once the TTree has been written.
+/// A few KB are typically enough for branches with small baskets, and the
+/// samples collected for the training take about ten times maxsize in memory
+/// until the dictionary is trained. A value of 0 disables the training. If not
+/// set, the TTree.CompressionDictSize rootrc value is used (0 by default).
+/// The setting has no effect once the dictionary is trained.
+
+void TBranch::SetCompressionDictSize(Int_t maxsize)
+{
+   fCompressionDictSize = std::max(0, maxsize);
+
+   Int_t nb = fBranches.GetEntriesFast();
+   for (Int_t i=0;i<nb;i++) {
+      TBranch *branch = (TBranch*)fBranches.UncheckedAt(i);
+      branch->SetCompressionDictSize(maxsize);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the maximum size of the ZSTD dictionary trained from the first
+/// baskets, see SetCompressionDictSize().
+
+Int_t TBranch::GetCompressionDictSize() const
+{
+   if (fCompressionDictSize < 0)
+      return std::max(0, gEnv->GetValue("TTree.CompressionDictSize", 0));
+   return fCompressionDictSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the uncompressed content of a basket, of size bytes at buffer, to the
+/// samples used to train the ZSTD dictionary, and train it once there are
+/// enough of them. Called by TBasket::WriteBuffer before compressing a basket
+/// with ZSTD.
+
+void TBranch::TrainCompressionDict(const char *buffer, Int_t size)
+{
+   if (!fCompressionDict.empty())
+      return;
+   if (fCompressionDictSize < 0)
+      fCompressionDictSize = GetCompressionDictSize();
+   if (fCompressionDictSize == 0)
+      return;
+
+   // The training needs a few samples and ten times the size of the dictionary: split the baskets in samples
+   // of at most kSampleSize bytes, and stop collecting them once there are enough.
+   constexpr Int_t kSampleSize = 4096;
+   constexpr std::size_t kMinSamples = 8;
+   const std::size_t trainingSize = 10 * static_cast<std::size_t>(fCompressionDictSize);
+   auto enoughSamples = [&]() {
+      return fCompressionDictSamples.size() >= trainingSize && fCompressionDictSampleSizes.size() >= kMinSamples;
+   };
+   for (Int_t pos = 0; pos < size && !enoughSamples(); pos += kSampleSize) {
+      const Int_t len = std::min(kSampleSize, size - pos);
+      fCompressionDictSamples.insert(fCompressionDictSamples.end(), buffer + pos, buffer + pos + len);
+      fCompressionDictSampleSizes.push_back(len);
+   }
+   if (!enoughSamples())
+      return;
+
+   fCompressionDict.resize(fCompressionDictSize);
+   fCompressionDict.resize(R__trainDictZSTD(fCompressionDict.data(), fCompressionDict.size(),
+                                            fCompressionDictSamples.data(), fCompressionDictSampleSizes.data(),
+                                            fCompressionDictSampleSizes.size()));
+   fCompressionDict.shrink_to_fit();
+   if (fCompressionDict.empty()) {
+      Warning("TrainCompressionDict", "Could not train a compression dictionary for the branch %s, its baskets are "
+              "compressed without dictionary", GetName());
+      // do not collect samples again
+      fCompressionDictSize = 0;
+   }
+   std::vector<char>().swap(fCompressionDictSamples);
+   std::vector<size_t>().swap(fCompressionDictSampleSizes);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Update the default value for the branch's fEntryOffsetLen if and only if
 /// it was already non zero (and the new value is not zero)
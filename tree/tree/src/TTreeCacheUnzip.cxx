@@ -27,6 +27,7 @@ A TTreeCache which exploits parallelized decompression of its own content.
 #include "TMath.h"
 #include "TROOT.h"
 #include "TMutex.h"
+#include "ZipZSTD.h"
 
 #ifdef R__USE_IMT
 #include "ROOT/TThreadExecutor.hxx"
@@ -911,6 +912,14 @@ Int_t TTreeCacheUnzip::UnzipBuffer(char **dest, char *src)
             return uzlen;
          }
 
+         // The dictionary is held by the branch of the basket, which is not known here: let TBasket
+         // decompress the basket.
+         if (R__unlikely(R__getDictIDZSTD(nin, bufcur) != 0)) {
+            if (alloc) delete [] *dest;
+            *dest = nullptr;
+            return -1;
+         }
+
          R__unzip(&nin, bufcur, &nbuf, objbuf, &nout);
 
          if (gDebug > 2)
@@ -345,6 +345,22 @@ UInt_t TTreeCloner::CollectBranches(TBranch *from, TBranch *to) {
 
    }
 
+   // The baskets are copied as they are: those compressed with a dictionary need the same one in the output.
+   if (!from->fCompressionDict.empty() && from->fCompressionDict != to->fCompressionDict) {
+      if (to->fCompressionDict.empty() && to->GetEntries() == 0) {
+         to->fCompressionDict = from->fCompressionDict;
+      } else {
+         fWarningMsg.Form("The export branch and the import branch (%s) do not have the same compression dictionary.",
+                          from->GetName());
+         if (!(fOptions & kNoWarnings)) {
+            Warning("TTreeCloner::CollectBranches", "%s", fWarningMsg.Data());
+         }
+         fIsValid = kFALSE;
+         fNeedConversion = kTRUE;
+         return 0;
+      }
+   }
+
    fFromBranches.AddLast(from);
    if (!from->TestBit(TBranch::kDoNotUseBufferMap)) {
       // Make sure that we reset the Buffer's map if needed.
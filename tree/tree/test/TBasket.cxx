@@ -6,10 +6,13 @@
 #include "TEnumConstant.h"
 #include "TMemFile.h"
 #include "TTree.h"
+#include "TTreeCacheUnzip.h"
 
 #include "ROOT/TestSupport.hxx"
 #include "gtest/gtest.h"
 
+#include <cstdio>
+#include <string>
 #include <vector>
 
 static const Int_t gSampleEvents = 100;
@@ -411,3 +414,79 @@ TEST(TBasket, TestSettingIOBits)
    readEntryOffset = reinterpret_cast<Bool_t *>(reinterpret_cast<char *>(basket2) + offset);
    EXPECT_EQ(*readEntryOffset, kTRUE);
 }
+
+static std::string MakeDictSampleEntry(Int_t idx)
+{
+   char text[128];
+   snprintf(text, sizeof(text), "{\"event\": %d, \"pt\": %d, \"charge\": %s}", idx, (idx * 13) % 97,
+            idx % 2 ? "+1" : "-1");
+   return text;
+}
+
+static void VerifyDictSampleTree(TTree *tree, Int_t nEntries)
+{
+   char dictText[128];
+   char plainText[128];
+   tree->SetBranchAddress("dict", dictText);
+   tree->SetBranchAddress("plain", plainText);
+   ASSERT_EQ(tree->GetEntries(), nEntries);
+   for (Int_t idx = 0; idx < nEntries; idx++) {
+      ASSERT_GT(tree->GetEntry(idx), 0);
+      EXPECT_EQ(MakeDictSampleEntry(idx), dictText);
+      EXPECT_EQ(MakeDictSampleEntry(idx), plainText);
+   }
+   tree->ResetBranchAddresses();
+}
+
+TEST(TBasket, CompressionDict)
+{
+   constexpr Int_t nEntries = 20000;
+   std::vector<char> dict;
+   std::vector<char> memBuffer;
+   {
+      // ZSTD, level 5
+      TMemFile f("tbasket_dict.root", "RECREATE", "", 505);
+      TTree t("t", "Tree with a ZSTD dictionary");
+      char text[128];
+      // Small baskets, with the same content in both branches
+      TBranch *dictBranch = t.Branch("dict", text, "dict/C", 2000);
+      TBranch *plainBranch = t.Branch("plain", text, "plain/C", 2000);
+      dictBranch->SetCompressionDictSize(2048);
+      plainBranch->SetCompressionDictSize(0);
+      for (Int_t idx = 0; idx < nEntries; idx++) {
+         snprintf(text, sizeof(text), "%s", MakeDictSampleEntry(idx).c_str());
+         t.Fill();
+      }
+      t.Write();
+
+      dict = dictBranch->GetCompressionDict();
+      ASSERT_FALSE(dict.empty());
+      EXPECT_LE(dict.size(), 2048u);
+      EXPECT_TRUE(plainBranch->GetCompressionDict().empty());
+      EXPECT_LT(dictBranch->GetZipBytes(), plainBranch->GetZipBytes());
+
+      f.Close();
+      memBuffer.resize(f.GetSize());
+      f.CopyTo(memBuffer.data(), memBuffer.size());
+   }
+
+   TMemFile f("tbasket_dict.root", memBuffer.data(), memBuffer.size(), "READ");
+   auto t = f.Get<TTree>("t");
+   ASSERT_NE(t, nullptr);
+   EXPECT_EQ(t->GetBranch("dict")->GetCompressionDict(), dict);
+   VerifyDictSampleTree(t, nEntries);
+
+   // Baskets compressed with a dictionary are left to TBasket by the parallel unzipping
+   TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+   t->SetCacheSize(0);
+   t->SetCacheSize(1000000);
+   VerifyDictSampleTree(t, nEntries);
+   TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kDisable);
+
+   // Fast cloning copies the dictionary with the baskets
+   TMemFile out("tbasket_dict_clone.root", "RECREATE", "", 505);
+   auto clone = t->CloneTree(-1, "fast");
+   ASSERT_NE(clone, nullptr);
+   EXPECT_EQ(clone->GetBranch("dict")->GetCompressionDict(), dict);
+   VerifyDictSampleTree(clone, nEntries);
+}